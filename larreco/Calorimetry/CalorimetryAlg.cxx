@@ -17,6 +17,44 @@
 #include "larevt/CalibrationDBI/Interface/ElectronLifetimeProvider.h"
 #include "larevt/CalibrationDBI/Interface/ElectronLifetimeService.h"
 
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+  constexpr double kPhiMax = 90.; // degrees, upper end of the recombination TF1 range
+
+  // Linear interpolation in a table of values at equally spaced phi from 0 to kPhiMax
+  double interpolate(std::vector<double> const& table, double const phi)
+  {
+    double const x = phi * (table.size() - 1) / kPhiMax;
+    size_t const i = std::min(size_t(x), table.size() - 2);
+    return table[i] + (x - i) * (table[i + 1] - table[i]);
+  }
+
+  // Samples f from 0 to kPhiMax, doubling the number of bins until the interpolation matches f
+  // at all the bin centres within the relative tolerance; returns an empty table if it never does
+  std::vector<double> tabulate(TF1 const& f, double const tolerance)
+  {
+    if (tolerance < 0) return {};
+    for (size_t nbins = 90; nbins <= 90 * 256; nbins *= 2) {
+      std::vector<double> table(nbins + 1);
+      for (size_t i = 0; i <= nbins; ++i)
+        table[i] = f.Eval(i * kPhiMax / nbins);
+
+      bool precise = true;
+      for (size_t i = 0; i < nbins && precise; ++i) {
+        double const phi = (i + 0.5) * kPhiMax / nbins;
+        double const exact = f.Eval(phi);
+        precise = std::abs(interpolate(table, phi) - exact) <= tolerance * std::abs(exact);
+      }
+      if (precise) return table;
+    }
+    return {};
+  }
+
+}
+
 namespace calo {
 
   //--------------------------------------------------------------------
@@ -52,6 +90,10 @@ namespace calo {
     for (unsigned i = 0; i < birksk_param.size(); i++) {
       fBirksKF.SetParameter(i, birksk_param[i]);
     }
+
+    // TF1::Eval is slow and not thread safe, so look the parameters up in tables instead
+    fModBoxBTable = tabulate(fModBoxBF, config.RecombTableTolerance());
+    fBirksKTable = tabulate(fBirksKF, config.RecombTableTolerance());
   }
 
   //------------------------------------------------------------------------------------//
@@ -188,6 +230,60 @@ namespace calo {
     return dEdx_from_dQdx_e(clock_data, det_prop, dQdx_e, time, T0, EField, phi);
   }
 
+  //------------------------------------------------------------------------------------//
+  // Functions to calculate the dEdX of many hits of a plane at once
+  // ----------------------------------------------------------------------------------//
+  std::vector<double> CalorimetryAlg::dEdx_AMP(detinfo::DetectorClocksData const& clock_data,
+                                               detinfo::DetectorPropertiesData const& det_prop,
+                                               std::vector<double> const& dQdx,
+                                               std::vector<double> const& time,
+                                               unsigned int const plane,
+                                               double const T0) const
+  {
+    return dEdx_from_dQdx_e(
+      clock_data, det_prop, dQdx, fCalAmpConstants[plane], time, T0, det_prop.Efield(), {});
+  }
+
+  // ----------------------------------------------------------------------------------//
+  std::vector<double> CalorimetryAlg::dEdx_AMP(detinfo::DetectorClocksData const& clock_data,
+                                               detinfo::DetectorPropertiesData const& det_prop,
+                                               std::vector<double> const& dQdx,
+                                               std::vector<double> const& time,
+                                               unsigned int const plane,
+                                               double const T0,
+                                               double const EField,
+                                               std::vector<double> const& phi) const
+  {
+    return dEdx_from_dQdx_e(
+      clock_data, det_prop, dQdx, fCalAmpConstants[plane], time, T0, EField, phi);
+  }
+
+  // ----------------------------------------------------------------------------------//
+  std::vector<double> CalorimetryAlg::dEdx_AREA(detinfo::DetectorClocksData const& clock_data,
+                                                detinfo::DetectorPropertiesData const& det_prop,
+                                                std::vector<double> const& dQdx,
+                                                std::vector<double> const& time,
+                                                unsigned int const plane,
+                                                double const T0) const
+  {
+    return dEdx_from_dQdx_e(
+      clock_data, det_prop, dQdx, fCalAreaConstants[plane], time, T0, det_prop.Efield(), {});
+  }
+
+  // ----------------------------------------------------------------------------------//
+  std::vector<double> CalorimetryAlg::dEdx_AREA(detinfo::DetectorClocksData const& clock_data,
+                                                detinfo::DetectorPropertiesData const& det_prop,
+                                                std::vector<double> const& dQdx,
+                                                std::vector<double> const& time,
+                                                unsigned int const plane,
+                                                double const T0,
+                                                double const EField,
+                                                std::vector<double> const& phi) const
+  {
+    return dEdx_from_dQdx_e(
+      clock_data, det_prop, dQdx, fCalAreaConstants[plane], time, T0, EField, phi);
+  }
+
   // Apply Lifetime and recombination correction.
   double CalorimetryAlg::dEdx_from_dQdx_e(detinfo::DetectorClocksData const& clock_data,
                                           detinfo::DetectorPropertiesData const& det_prop,
@@ -214,6 +310,57 @@ namespace calo {
     return BirksCorrection(dQdx_e, phi, det_prop.Density(), EField);
   }
 
+  // Same as above for many hits, looking up the clocks, lifetime and density only once.
+  std::vector<double> CalorimetryAlg::dEdx_from_dQdx_e(
+    detinfo::DetectorClocksData const& clock_data,
+    detinfo::DetectorPropertiesData const& det_prop,
+    std::vector<double> const& dQdx,
+    double const ADCtoEl,
+    std::vector<double> const& time,
+    double const T0,
+    double const EField,
+    std::vector<double> const& phi) const
+  {
+    if (time.size() != dQdx.size() || (!phi.empty() && phi.size() != dQdx.size())) {
+      throw cet::exception("CalorimetryAlg")
+        << "Got " << dQdx.size() << " dQ/dx, " << time.size() << " times and " << phi.size()
+        << " angles; need as many times as dQ/dx, and as many angles or none.\n";
+    }
+
+    std::vector<double> dEdx(dQdx.size());
+    for (size_t i = 0; i < dQdx.size(); ++i)
+      dEdx[i] = dQdx[i] / ADCtoEl; // Conversion from ADC/cm to e/cm
+
+    if (fDoLifeTimeCorrection) {
+      // same arithmetic as LifetimeCorrection()
+      auto const trigOffset = trigger_offset(clock_data);
+      double const timetick = sampling_rate(clock_data) * 1.e-3; // time sample in microsec
+      if (fLifeTimeForm == 0) {
+        double const tau = det_prop.ElectronLifetime();
+        for (size_t i = 0; i < dEdx.size(); ++i) {
+          float const t = time[i] - trigOffset;
+          dEdx[i] *= exp((t * timetick - T0 * 1e-3) / tau);
+        }
+      }
+      else {
+        auto const& elifetime_provider =
+          art::ServiceHandle<lariov::ElectronLifetimeService const>()->GetProvider();
+        for (size_t i = 0; i < dEdx.size(); ++i) {
+          float const t = time[i] - trigOffset;
+          dEdx[i] *= elifetime_provider.Lifetime(t * timetick - T0 * 1e-3);
+        }
+      }
+    }
+
+    double const rho = det_prop.Density();
+    for (size_t i = 0; i < dEdx.size(); ++i) {
+      double const hitPhi = phi.empty() ? 90 : phi[i];
+      dEdx[i] = fUseModBox ? ModBoxCorrection(dEdx[i], hitPhi, rho, EField) :
+                             BirksCorrection(dEdx[i], hitPhi, rho, EField);
+    }
+    return dEdx;
+  }
+
   //------------------------------------------------------------------------------------//
   // for the time being copying from Calorimetry.cxx - should be decided where
   // to keep it.
@@ -252,7 +399,7 @@ namespace calo {
     // Modified Box model correction has better behavior than the Birks
     // correction at high values of dQ/dx.
     constexpr double Wion = 1000. / util::kGeVToElectrons; // 23.6 eV = 1e, Wion in MeV/e
-    double const Beta = fModBoxBF.Eval(phi) / (rho * E_field);
+    double const Beta = ModBoxB(phi) / (rho * E_field);
     double const Alpha = fModBoxA;
     double const dEdx = (exp(Beta * Wion * dQdx) - Alpha) / Beta;
 
@@ -267,7 +414,7 @@ namespace calo {
     // from: S.Amoruso et al., NIM A 523 (2004) 275
 
     double A = fBirksA;
-    double K = fBirksKF.Eval(phi);                              // in KV/cm*(g/cm^2)/MeV
+    double K = BirksK(phi);                                     // in KV/cm*(g/cm^2)/MeV
     constexpr double Wion = 1000. / util::kGeVToElectrons;      // 23.6 eV = 1e, Wion in MeV/e
     K /= rho;                                                   // KV/MeV
     double const dEdx = dQdx / (A / Wion - K / E_field * dQdx); // MeV/cm
@@ -275,4 +422,16 @@ namespace calo {
     return dEdx;
   }
 
+  double calo::CalorimetryAlg::ModBoxB(double const phi) const
+  {
+    if (fModBoxBTable.empty() || !(phi >= 0 && phi <= kPhiMax)) return fModBoxBF.Eval(phi);
+    return interpolate(fModBoxBTable, phi);
+  }
+
+  double calo::CalorimetryAlg::BirksK(double const phi) const
+  {
+    if (fBirksKTable.empty() || !(phi >= 0 && phi <= kPhiMax)) return fBirksKF.Eval(phi);
+    return interpolate(fBirksKTable, phi);
+  }
+
 } // namespace
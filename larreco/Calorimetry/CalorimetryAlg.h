@@ -84,6 +84,13 @@ namespace calo {
       fhicl::OptionalSequence<double> BirksKParam{
         Name("BirksKParam"),
         Comment("Parameters for the BirksKTF1 function. List of doubles.")};
+
+      fhicl::Atom<double> RecombTableTolerance{
+        Name("RecombTableTolerance"),
+        Comment("Largest relative deviation from ModBoxBTF1 and BirksKTF1 allowed when they are "
+                "tabulated in phi; the TF1s are evaluated directly if this is negative or the "
+                "tables cannot reach it."),
+        1e-6};
     };
 
     CalorimetryAlg(const fhicl::ParameterSet& pset)
@@ -147,6 +154,37 @@ namespace calo {
                      double EField,
                      double phi = 90) const;
 
+    // Batch versions of the dQ/dx overloads above, converting all the hits of a track in one
+    // plane at once: dQdx, time and phi (if not empty) hold one entry per hit.
+    std::vector<double> dEdx_AMP(detinfo::DetectorClocksData const& clock_data,
+                                 detinfo::DetectorPropertiesData const& det_prop,
+                                 std::vector<double> const& dQdx,
+                                 std::vector<double> const& time,
+                                 unsigned int plane,
+                                 double T0 = 0) const;
+    std::vector<double> dEdx_AMP(detinfo::DetectorClocksData const& clock_data,
+                                 detinfo::DetectorPropertiesData const& det_prop,
+                                 std::vector<double> const& dQdx,
+                                 std::vector<double> const& time,
+                                 unsigned int plane,
+                                 double T0,
+                                 double EField,
+                                 std::vector<double> const& phi = {}) const;
+    std::vector<double> dEdx_AREA(detinfo::DetectorClocksData const& clock_data,
+                                  detinfo::DetectorPropertiesData const& det_prop,
+                                  std::vector<double> const& dQdx,
+                                  std::vector<double> const& time,
+                                  unsigned int plane,
+                                  double T0 = 0) const;
+    std::vector<double> dEdx_AREA(detinfo::DetectorClocksData const& clock_data,
+                                  detinfo::DetectorPropertiesData const& det_prop,
+                                  std::vector<double> const& dQdx,
+                                  std::vector<double> const& time,
+                                  unsigned int plane,
+                                  double T0,
+                                  double EField,
+                                  std::vector<double> const& phi = {}) const;
+
     double ElectronsFromADCPeak(double adc, unsigned short plane) const
     {
       return adc / fCalAmpConstants[plane];
@@ -167,8 +205,6 @@ namespace calo {
     double ModBoxCorrection(double dQdx, double phi, double rho, double E_field) const;
 
   private:
-    art::ServiceHandle<geo::Geometry const> geom;
-
     double dEdx_from_dQdx_e(detinfo::DetectorClocksData const& clock_data,
                             detinfo::DetectorPropertiesData const& det_prop,
                             double dQdx_e,
@@ -181,6 +217,18 @@ namespace calo {
                             double T0,
                             double EField,
                             double phi = 90) const;
+    std::vector<double> dEdx_from_dQdx_e(detinfo::DetectorClocksData const& clock_data,
+                                         detinfo::DetectorPropertiesData const& det_prop,
+                                         std::vector<double> const& dQdx,
+                                         double ADCtoEl,
+                                         std::vector<double> const& time,
+                                         double T0,
+                                         double EField,
+                                         std::vector<double> const& phi) const;
+
+    // Recombination parameters at phi, from the tables if possible
+    double ModBoxB(double phi) const;
+    double BirksK(double phi) const;
 
     std::vector<double> const fCalAmpConstants;
     std::vector<double> const fCalAreaConstants;
@@ -194,6 +242,11 @@ namespace calo {
     double fBirksA;  // Birks A cosntant
     TF1 fBirksKF;    // Function of phi to get the Birks-k value
 
+    // fModBoxBF and fBirksKF sampled at equally spaced phi from 0 to 90 degrees, empty when the
+    // TF1 has to be evaluated instead
+    std::vector<double> fModBoxBTable;
+    std::vector<double> fBirksKTable;
+
   }; // class CalorimetryAlg
 } // namespace calo
 #endif // UTIL_CALORIMETRYALG_H
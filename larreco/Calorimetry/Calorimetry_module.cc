@@ -237,6 +237,7 @@ void calo::Calorimetry::produce(art::Event& evt)
 
       float Kin_En = 0.;
       float Trk_Length = 0.;
+      std::vector<double> hitPitch; // unrounded fpitch
       std::vector<float> vdEdx;
       std::vector<float> vresRange;
       std::vector<float> vdQdx;
@@ -475,13 +476,6 @@ void calo::Calorimetry::produce(art::Event& evt)
 
         double MIPs = charge;
         double dQdx = MIPs / pitch;
-        double dEdx = 0;
-        if (fUseArea)
-          dEdx = caloAlg.dEdx_AREA(clock_data, det_prop, *allHits[hits[ipl][ihit]], pitch, T0);
-        else
-          dEdx = caloAlg.dEdx_AMP(clock_data, det_prop, *allHits[hits[ipl][ihit]], pitch, T0);
-
-        Kin_En = Kin_En + dEdx * pitch;
 
         if (allHits[hits[ipl][ihit]]->WireID().Wire < wire0)
           wire0 = allHits[hits[ipl][ihit]]->WireID().Wire;
@@ -489,8 +483,8 @@ void calo::Calorimetry::produce(art::Event& evt)
           wire1 = allHits[hits[ipl][ihit]]->WireID().Wire;
 
         fMIPs.push_back(MIPs);
-        fdEdx.push_back(dEdx);
         fdQdx.push_back(dQdx);
+        hitPitch.push_back(pitch);
         fwire.push_back(wire);
         ftime.push_back(time);
         fstime.push_back(stime);
@@ -501,6 +495,15 @@ void calo::Calorimetry::produce(art::Event& evt)
         fHitIndex.push_back(hitIndex);
         ++fnsps;
       }
+
+      // dE/dx of all the hits of the plane in one go
+      if (fUseArea)
+        fdEdx = caloAlg.dEdx_AREA(clock_data, det_prop, fdQdx, ftime, ipl, T0);
+      else
+        fdEdx = caloAlg.dEdx_AMP(clock_data, det_prop, fdQdx, ftime, ipl, T0);
+      for (int i = 0; i < fnsps; ++i)
+        Kin_En = Kin_En + fdEdx[i] * hitPitch[i];
+
       if (fnsps < 2) {
         vdEdx.clear();
         vdQdx.clear();
@@ -11,6 +11,8 @@
 
 #include "TMath.h"
 
+#include <algorithm>
+
 ems::Hit2D::Hit2D(detinfo::DetectorPropertiesData const& detProp, art::Ptr<recob::Hit> src)
   : fHit(src)
 {
@@ -30,10 +32,11 @@ ems::Bin2D::Bin2D(const TVector2& center) : fCenter2D(center), fTotCharge(0.0),
 
 void ems::Bin2D::Add(Hit2D* hit)
 {
-  fHits2D.push_back(hit);
+  // keep the bin sorted by inserting in place rather than resorting it
+  fHits2D.insert(
+    std::upper_bound(fHits2D.begin(), fHits2D.end(), hit, bDistCentLess2D(fCenter2D)), hit);
   fTotCharge += hit->GetCharge();
   fSize = fHits2D.size();
-  SortLess();
 }
 
 void ems::Bin2D::Sort()
@@ -165,9 +168,11 @@ ems::DirOfGamma::DirOfGamma(detinfo::DetectorPropertiesData const& detProp,
 {
   fHits = src;
 
+  fHitStore.reserve(src.size());
+  fPoints2D.reserve(src.size());
   for (unsigned int i = 0; i < src.size(); i++) {
-    Hit2D* hit = new Hit2D(detProp, src[i]);
-    fPoints2D.push_back(hit);
+    fHitStore.emplace_back(detProp, src[i]);
+    fPoints2D.push_back(&fHitStore.back());
   }
 
   ComputeBaryCenter();
@@ -255,8 +260,8 @@ bool ems::DirOfGamma::FindCandidates()
     std::vector<Hit2D*> points;
     Hit2D* candidate2D = fBins[id].GetHits2D().front();
 
+    double distnorm = std::sqrt(pma::Dist2(candidate2D->GetPointCm(), fBaryCenter)) / fNormDist;
     for (unsigned int i = 0; i < fPoints2D.size(); i++) {
-      double distnorm = std::sqrt(pma::Dist2(candidate2D->GetPointCm(), fBaryCenter)) / fNormDist;
       double dist2 = pma::Dist2(candidate2D->GetPointCm(), fPoints2D[i]->GetPointCm());
 
       if ((distnorm > 0.5) && (dist2 < rad * rad)) points.push_back(fPoints2D[i]);
@@ -122,11 +122,10 @@ public:
              const std::vector<art::Ptr<recob::Hit>>& src,
              unsigned int nbins,
              unsigned int idcl);
-  ~DirOfGamma()
-  {
-    for (unsigned int i = 0; i < fPoints2D.size(); ++i)
-      delete fPoints2D[i];
-  }
+
+  // fPoints2D and the bins point into fHitStore and fBaryCenter
+  DirOfGamma(DirOfGamma const&) = delete;
+  DirOfGamma& operator=(DirOfGamma const&) = delete;
 
   TVector2 const& GetBaryCenterCm() const { return fBaryCenter; }
 
@@ -161,6 +160,7 @@ private:
   size_t fIdCl;
   size_t fCandidateID;
 
+  std::vector<Hit2D> fHitStore;
   std::vector<Hit2D*> fPoints2D;
   std::vector<Bin2D> fBins;
   std::vector<EndPoint> fCandidates;
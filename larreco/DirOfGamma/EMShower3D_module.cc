@@ -26,8 +26,11 @@
 #include "larreco/RecoAlg/PMAlg/Utilities.h"
 #include "larreco/RecoAlg/ProjectionMatchingAlg.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "tbb/parallel_for.h"
+
 #include "larreco/Calorimetry/CalorimetryAlg.h"
 #include "larreco/DirOfGamma/DirOfGamma.h"
 
@@ -85,25 +88,23 @@ private:
                  std::vector<ems::DirOfGamma*> pair);
 
   bool Validate(detinfo::DetectorPropertiesData const& detProp,
-                std::vector<ems::DirOfGamma*> input,
+                const std::vector<ems::DirOfGamma*>& input,
                 size_t id1,
                 size_t id2,
                 size_t c1,
                 size_t c2,
-                size_t plane3);
+                size_t plane3) const;
 
   void FilterOutSmallParts(detinfo::DetectorPropertiesData const& detProp,
                            double r2d,
                            const std::vector<art::Ptr<recob::Hit>>& hits_in,
-                           std::vector<art::Ptr<recob::Hit>>& hits_out);
+                           std::vector<art::Ptr<recob::Hit>>& hits_out) const;
 
-  bool GetCloseHits(detinfo::DetectorPropertiesData const& detProp,
-                    double r2d,
+  bool GetCloseHits(double r2d,
                     const std::vector<art::Ptr<recob::Hit>>& hits_in,
-                    std::vector<size_t>& used,
-                    std::vector<art::Ptr<recob::Hit>>& hits_out);
-
-  bool Has(const std::vector<size_t>& v, size_t idx);
+                    const std::vector<TVector2>& hits_cm,
+                    std::vector<bool>& used,
+                    std::vector<size_t>& hits_out) const;
 
   size_t LinkCandidates(art::Event const& e,
                         detinfo::DetectorPropertiesData const& detProp,
@@ -590,22 +591,26 @@ std::vector<ems::DirOfGamma*> ems::EMShower3D::CollectShower2D(
 
   if (e.getByLabel(fCluModuleLabel, fCluListHandle)) {
     art::FindManyP<recob::Hit> fb(fCluListHandle, e, fCluModuleLabel);
-    for (unsigned int c = 0; c < fCluListHandle->size(); c++) {
-      std::vector<art::Ptr<recob::Hit>> hitlist;
-      hitlist = fb.at(c);
-
-      if (hitlist.size() > 5) {
-        std::vector<art::Ptr<recob::Hit>> hits_out;
-        FilterOutSmallParts(detProp, 2.0, hitlist, hits_out);
-
-        if (hits_out.size() > 5) {
-          fClusters.push_back(hits_out);
-
-          ems::DirOfGamma* sh = new ems::DirOfGamma(detProp, hits_out, 14, c);
 
-          if (sh->GetHits2D().size()) input.push_back(sh);
-        }
-      }
+    // clusters are processed independently, results are collected below in
+    // the order of the input clusters
+    size_t const ncl = fCluListHandle->size();
+    std::vector<std::vector<art::Ptr<recob::Hit>>> hits_out(ncl);
+    std::vector<std::unique_ptr<ems::DirOfGamma>> showers(ncl);
+    tbb::parallel_for(size_t{0}, ncl, [&](size_t c) {
+      std::vector<art::Ptr<recob::Hit>> const& hitlist = fb.at(c);
+      if (hitlist.size() <= 5) return;
+
+      FilterOutSmallParts(detProp, 2.0, hitlist, hits_out[c]);
+      if (hits_out[c].size() > 5)
+        showers[c] = std::make_unique<ems::DirOfGamma>(detProp, hits_out[c], 14, c);
+    });
+
+    for (size_t c = 0; c < ncl; ++c) {
+      if (!showers[c]) continue;
+
+      fClusters.push_back(std::move(hits_out[c]));
+      if (showers[c]->GetHits2D().size()) input.push_back(showers[c].release());
     }
   }
 
@@ -690,6 +695,14 @@ size_t ems::EMShower3D::LinkCandidates(art::Event const& e,
                                        std::vector<ems::DirOfGamma*> input,
                                        size_t id)
 {
+  struct PairCandidate {
+    size_t c;
+    size_t j;
+    size_t cj;
+    size_t thirdview;
+    float dist;
+  };
+
   art::ServiceHandle<geo::Geometry const> geom;
 
   size_t index = id;
@@ -697,13 +710,17 @@ size_t ems::EMShower3D::LinkCandidates(art::Event const& e,
 
   if (input[id]->GetCandidates().size() < 2) { return index; }
 
-  double mindist = 3.0; // cm
+  double const mindist = 3.0; // cm
   std::vector<ems::DirOfGamma*> pairs;
 
   size_t idcsave = 0;
   size_t idcjsave = 0;
   size_t c = 0;
   size_t idsave = 0;
+
+  // collect pairs which pass the distance cut, then validate them from the
+  // closest one: the first valid pair is the one the scan order selects
+  std::vector<PairCandidate> tocheck;
   while (c < input[id]->GetCandidates().size()) {
 
     size_t startview = input[id]->GetCandidates()[c].GetPlane();
@@ -737,17 +754,7 @@ size_t ems::EMShower3D::LinkCandidates(art::Event const& e,
           float t2 = input[j]->GetCandidates()[cj].GetPosition().Y();
           float dist = fabs(t2 - t1);
 
-          if ((dist < mindist) && Validate(detProp, input, id, j, c, cj, thirdview)) {
-            mindist = dist;
-            pairs.clear();
-            pairs.push_back(input[id]);
-            pairs.push_back(input[j]);
-            idsave = j;
-            index = j;
-            idcsave = c;
-            idcjsave = cj;
-            found = true;
-          }
+          if (dist < mindist) tocheck.push_back({c, j, cj, thirdview, dist});
         }
       }
     }
@@ -755,6 +762,26 @@ size_t ems::EMShower3D::LinkCandidates(art::Event const& e,
     c++;
   }
 
+  // stable, so that pairs at the same distance keep the scan order; only pairs
+  // the scan would have validated are fitted
+  std::stable_sort(
+    tocheck.begin(), tocheck.end(), [](PairCandidate const& a, PairCandidate const& b) {
+      return a.dist < b.dist;
+    });
+
+  for (auto const& p : tocheck) {
+    if (!Validate(detProp, input, id, p.j, p.c, p.cj, p.thirdview)) continue;
+
+    pairs.push_back(input[id]);
+    pairs.push_back(input[p.j]);
+    idsave = p.j;
+    index = p.j;
+    idcsave = p.c;
+    idcjsave = p.cj;
+    found = true;
+    break;
+  }
+
   if (found && pairs.size()) {
     input[id]->SetIdCandidate(idcsave);
     input[idsave]->SetIdCandidate(idcjsave);
@@ -813,14 +840,13 @@ void ems::EMShower3D::Make3DSeg(art::Event const& e,
 }
 
 bool ems::EMShower3D::Validate(detinfo::DetectorPropertiesData const& detProp,
-                               std::vector<ems::DirOfGamma*> input,
+                               const std::vector<ems::DirOfGamma*>& input,
                                size_t id1,
                                size_t id2,
                                size_t c1,
                                size_t c2,
-                               size_t plane3)
+                               size_t plane3) const
 {
-  bool result = false;
   if (id1 == id2) return false;
 
   std::vector<art::Ptr<recob::Hit>> vec1 = input[id1]->GetCandidates()[c1].GetIniHits();
@@ -843,36 +869,30 @@ bool ems::EMShower3D::Validate(detinfo::DetectorPropertiesData const& detProp,
 
   pma::Track3D* track =
     fProjectionMatchingAlg.buildSegment(detProp, hitscl1uniquetpc, hitscl2uniquetpc);
+  if (!track) return false;
+
+  TVector2 const pfront = pma::GetProjectionToPlane(
+    track->front()->Point3D(), plane3, track->FrontTPC(), track->FrontCryo());
+  TVector2 const pback = pma::GetProjectionToPlane(
+    track->back()->Point3D(), plane3, track->BackTPC(), track->BackCryo());
+  delete track;
+
   for (size_t i = 0; i < input.size(); ++i) {
-    std::vector<Hit2D*> hits2dcl = input[i]->GetHits2D();
+    std::vector<Hit2D*> const& hits2dcl = input[i]->GetHits2D();
     for (size_t h = 0; h < hits2dcl.size(); ++h) {
-      TVector2 pfront = pma::GetProjectionToPlane(
-        track->front()->Point3D(), plane3, track->FrontTPC(), track->FrontCryo());
-      TVector2 pback = pma::GetProjectionToPlane(
-        track->back()->Point3D(), plane3, track->BackTPC(), track->BackCryo());
       if ((pma::Dist2(hits2dcl[h]->GetPointCm(), pfront) < 1.0F) &&
-          (pma::Dist2(hits2dcl[h]->GetPointCm(), pback) < 1.0F)) {
-        result = true;
-        break;
-      }
+          (pma::Dist2(hits2dcl[h]->GetPointCm(), pback) < 1.0F))
+        return true;
     }
   }
-  delete track;
-  return result;
-}
-
-bool ems::EMShower3D::Has(const std::vector<size_t>& v, size_t idx)
-{
-  for (auto c : v)
-    if (c == idx) return true;
   return false;
 }
 
-bool ems::EMShower3D::GetCloseHits(detinfo::DetectorPropertiesData const& detProp,
-                                   double r2d,
+bool ems::EMShower3D::GetCloseHits(double r2d,
                                    const std::vector<art::Ptr<recob::Hit>>& hits_in,
-                                   std::vector<size_t>& used,
-                                   std::vector<art::Ptr<recob::Hit>>& hits_out)
+                                   const std::vector<TVector2>& hits_cm,
+                                   std::vector<bool>& used,
+                                   std::vector<size_t>& hits_out) const
 {
 
   hits_out.clear();
@@ -880,12 +900,12 @@ bool ems::EMShower3D::GetCloseHits(detinfo::DetectorPropertiesData const& detPro
   const double gapMargin = 5.0; // can be changed to f(id_tpc1, id_tpc2)
   size_t idx = 0;
 
-  while ((idx < hits_in.size()) && Has(used, idx))
+  while ((idx < hits_in.size()) && used[idx])
     idx++;
 
   if (idx < hits_in.size()) {
-    hits_out.push_back(hits_in[idx]);
-    used.push_back(idx);
+    hits_out.push_back(idx);
+    used[idx] = true;
 
     double r2d2 = r2d * r2d;
     double gapMargin2 = sqrt(2 * gapMargin * gapMargin);
@@ -895,27 +915,14 @@ bool ems::EMShower3D::GetCloseHits(detinfo::DetectorPropertiesData const& detPro
     while (collect) {
       collect = false;
       for (size_t i = 0; i < hits_in.size(); i++)
-        if (!Has(used, i)) {
-          art::Ptr<recob::Hit> hi = hits_in[i];
-          TVector2 hi_cm = pma::WireDriftToCm(detProp,
-                                              hi->WireID().Wire,
-                                              hi->PeakTime(),
-                                              hi->WireID().Plane,
-                                              hi->WireID().TPC,
-                                              hi->WireID().Cryostat);
+        if (!used[i]) {
+          art::Ptr<recob::Hit> const& hi = hits_in[i];
 
           bool accept = false;
-          // for (auto const& ho : hits_out)
           for (size_t idx_o = 0; idx_o < hits_out.size(); idx_o++) {
-            art::Ptr<recob::Hit> ho = hits_out[idx_o];
+            art::Ptr<recob::Hit> const& ho = hits_in[hits_out[idx_o]];
 
-            double d2 = pma::Dist2(hi_cm,
-                                   pma::WireDriftToCm(detProp,
-                                                      ho->WireID().Wire,
-                                                      ho->PeakTime(),
-                                                      ho->WireID().Plane,
-                                                      ho->WireID().TPC,
-                                                      ho->WireID().Cryostat));
+            double d2 = pma::Dist2(hits_cm[i], hits_cm[hits_out[idx_o]]);
 
             if (hi->WireID().TPC == ho->WireID().TPC) {
               if (d2 < r2d2) {
@@ -932,8 +939,8 @@ bool ems::EMShower3D::GetCloseHits(detinfo::DetectorPropertiesData const& detPro
           }
           if (accept) {
             collect = true;
-            hits_out.push_back(hi);
-            used.push_back(i);
+            hits_out.push_back(i);
+            used[i] = true;
           }
         }
     }
@@ -946,18 +953,29 @@ bool ems::EMShower3D::GetCloseHits(detinfo::DetectorPropertiesData const& detPro
 void ems::EMShower3D::FilterOutSmallParts(detinfo::DetectorPropertiesData const& detProp,
                                           double r2d,
                                           const std::vector<art::Ptr<recob::Hit>>& hits_in,
-                                          std::vector<art::Ptr<recob::Hit>>& hits_out)
+                                          std::vector<art::Ptr<recob::Hit>>& hits_out) const
 {
   size_t min_size = hits_in.size() / 5;
   if (min_size < 3) min_size = 3;
 
-  std::vector<size_t> used;
-  std::vector<art::Ptr<recob::Hit>> close_hits;
-
-  while (GetCloseHits(detProp, r2d, hits_in, used, close_hits)) {
+  // hit positions do not change while groups are collected, compute them once
+  std::vector<TVector2> hits_cm;
+  hits_cm.reserve(hits_in.size());
+  for (auto const& h : hits_in)
+    hits_cm.push_back(pma::WireDriftToCm(detProp,
+                                         h->WireID().Wire,
+                                         h->PeakTime(),
+                                         h->WireID().Plane,
+                                         h->WireID().TPC,
+                                         h->WireID().Cryostat));
+
+  std::vector<bool> used(hits_in.size(), false);
+  std::vector<size_t> close_hits;
+
+  while (GetCloseHits(r2d, hits_in, hits_cm, used, close_hits)) {
     if (close_hits.size() > min_size)
       for (auto h : close_hits)
-        hits_out.push_back(h);
+        hits_out.push_back(hits_in[h]);
   }
 }
 DEFINE_ART_MODULE(ems::EMShower3D)
@@ -59,6 +59,8 @@
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Wire.h"
 
+#include "larreco/HitFinder/MultiExponentialFitter.h"
+
 // ROOT Includes
 #include "TF1.h"
 #include "TH1F.h"
@@ -192,6 +194,9 @@ namespace hit {
     int fLongMaxHits;
     int fLongPulseWidth;
     int fMaxFluctuations;
+    bool fUseAnalyticFitter;
+
+    MultiExponentialFitter fExpFitter; // used instead of the TF1 fit if fUseAnalyticFitter
 
     art::InputTag
       fNewHitsTag; // tag of hits produced by this module, need to have it for fit parameter data products
@@ -243,6 +248,7 @@ namespace hit {
     fLongMaxHits = pset.get<double>("LongMaxHits");
     fLongPulseWidth = pset.get<double>("LongPulseWidth");
     fMaxFluctuations = pset.get<double>("MaxFluctuations");
+    fUseAnalyticFitter = pset.get<bool>("UseAnalyticFitter", false);
 
     // let HitCollectionCreator declare that we are going to produce
     // hits and associations with wires and raw digits
@@ -1309,6 +1315,96 @@ namespace hit {
     // #############################################
     if (fEndTime - fStartTime < 0) { size = 0; }
 
+    // ###########################################################
+    // ### Seeds and limits, in the parameter order of the fit ###
+    // ###########################################################
+    int nParams = (NPeaks == 0) ? 0 : (fSameShape ? 2 + 2 * NPeaks : 4 * NPeaks);
+    std::vector<double> parSeed(nParams), parLow(nParams), parHigh(nParams);
+    auto setParameter = [&](int k, double seed, double low, double high) {
+      parSeed[k] = seed;
+      parLow[k] = low;
+      parHigh[k] = high;
+    };
+
+    if (fLogLevel >= 4) {
+      std::cout << std::endl;
+      std::cout << "--- Preparing fit ---" << std::endl;
+      std::cout << "--- Lower limits, seed, upper limit:" << std::endl;
+    }
+
+    double amplitude = 0;
+    double peakMean = 0;
+
+    double peakMeanShift = 2;
+    double peakMeanSeed = 0;
+    double peakMeanRangeLow = 0;
+    double peakMeanRangeHi = 0;
+    double peakStart = 0;
+    double peakEnd = 0;
+
+    for (int i = 0; i < NPeaks; i++) {
+      // index of the amplitude, the peak time follows it
+      int iAmp = fSameShape ? 2 * (i + 1) : 4 * i + 2;
+
+      if (!fSameShape || i == 0) {
+        setParameter(iAmp - 2, 0.5, fMinTau, fMaxTau);
+        setParameter(iAmp - 1, 0.5, fMinTau, fMaxTau);
+      }
+
+      peakMean = std::get<0>(fPeakVals.at(i));
+      peakStart = std::get<2>(fPeakVals.at(i));
+      peakEnd = std::get<3>(fPeakVals.at(i));
+      peakMeanSeed = peakMean - peakMeanShift;
+      peakMeanRangeLow = std::max(peakStart - peakMeanShift, peakMeanSeed - fFitPeakMeanRange);
+      peakMeanRangeHi = std::min(peakEnd, peakMeanSeed + fFitPeakMeanRange);
+      amplitude = fSignalVector[peakMean];
+
+      double t0low = peakMeanRangeLow;
+      double t0high = peakMeanRangeHi;
+      if (NPeaks >= 2 && i == 0) {
+        double HalfDistanceToNextMean = 0.5 * (std::get<0>(fPeakVals.at(i + 1)) - peakMean);
+        t0high = std::min(peakMeanRangeHi, peakMeanSeed + HalfDistanceToNextMean);
+      }
+      else if (NPeaks >= 2 && i == NPeaks - 1) {
+        double HalfDistanceToPrevMean = 0.5 * (peakMean - std::get<0>(fPeakVals.at(i - 1)));
+        t0low = std::max(peakMeanRangeLow, peakMeanSeed - HalfDistanceToPrevMean);
+      }
+      else if (NPeaks >= 2) {
+        double HalfDistanceToNextMean = 0.5 * (std::get<0>(fPeakVals.at(i + 1)) - peakMean);
+        double HalfDistanceToPrevMean = 0.5 * (peakMean - std::get<0>(fPeakVals.at(i - 1)));
+        t0low = std::max(peakMeanRangeLow, peakMeanSeed - HalfDistanceToPrevMean);
+        t0high = std::min(peakMeanRangeHi, peakMeanSeed + HalfDistanceToNextMean);
+      }
+
+      setParameter(iAmp, 1.65 * amplitude, 0.3 * 1.65 * amplitude, 2 * 1.65 * amplitude);
+      setParameter(iAmp + 1, peakMeanSeed, t0low, t0high);
+
+      if (fLogLevel >= 4) {
+        std::cout << "Peak #" << i << ": A [ADC] = " << 0.3 * 1.65 * amplitude << "  ,  "
+                  << 1.65 * amplitude << "  ,  " << 2 * 1.65 * amplitude << std::endl;
+        std::cout << "Peak #" << i << ": t0 [ticks] = " << t0low << "  ,  " << peakMeanSeed
+                  << "  ,  " << t0high << std::endl;
+      }
+    }
+
+    // #########################################################
+    // ### Dedicated fitter, falls back to ROOT if it can not ###
+    // ### handle the number of peaks or the tick range       ###
+    // #########################################################
+    if (fUseAnalyticFitter && fExpFitter.SetNPeaks(NPeaks, fSameShape)) {
+      for (int k = 0; k < nParams; k++)
+        fExpFitter.SetParameter(k, parSeed[k], parLow[k], parHigh[k]);
+
+      if (fExpFitter.Fit(fSignalVector, fStartTime, fEndTime)) {
+        fchi2PerNDF = (fExpFitter.GetChisquare() / fExpFitter.GetNDF());
+        fNDF = fExpFitter.GetNDF();
+
+        for (int k = 0; k < nParams; k++)
+          fparamVec.emplace_back(fExpFitter.GetParameter(k), fExpFitter.GetParError(k));
+        return;
+      }
+    }
+
     // --- TH1D HitSignal ---
     TH1F hitSignal("hitSignal", "", std::max(size, 1), fStartTime, fEndTime + 1);
     hitSignal.Sumw2();
@@ -1332,140 +1428,9 @@ namespace hit {
 
     TF1 Exponentials("Exponentials", eqn.c_str(), fStartTime, fEndTime + 1);
 
-    if (fLogLevel >= 4) {
-      std::cout << std::endl;
-      std::cout << "--- Preparing fit ---" << std::endl;
-      std::cout << "--- Lower limits, seed, upper limit:" << std::endl;
-    }
-
-    if (fSameShape) {
-      Exponentials.SetParameter(0, 0.5);
-      Exponentials.SetParameter(1, 0.5);
-      Exponentials.SetParLimits(0, fMinTau, fMaxTau);
-      Exponentials.SetParLimits(1, fMinTau, fMaxTau);
-      double amplitude = 0;
-      double peakMean = 0;
-
-      double peakMeanShift = 2;
-      double peakMeanSeed = 0;
-      double peakMeanRangeLow = 0;
-      double peakMeanRangeHi = 0;
-      double peakStart = 0;
-      double peakEnd = 0;
-
-      for (int i = 0; i < NPeaks; i++) {
-        peakMean = std::get<0>(fPeakVals.at(i));
-        peakStart = std::get<2>(fPeakVals.at(i));
-        peakEnd = std::get<3>(fPeakVals.at(i));
-        peakMeanSeed = peakMean - peakMeanShift;
-        peakMeanRangeLow = std::max(peakStart - peakMeanShift, peakMeanSeed - fFitPeakMeanRange);
-        peakMeanRangeHi = std::min(peakEnd, peakMeanSeed + fFitPeakMeanRange);
-        amplitude = fSignalVector[peakMean];
-
-        Exponentials.SetParameter(2 * (i + 1), 1.65 * amplitude);
-        Exponentials.SetParLimits(2 * (i + 1), 0.3 * 1.65 * amplitude, 2 * 1.65 * amplitude);
-        Exponentials.SetParameter(2 * (i + 1) + 1, peakMeanSeed);
-
-        if (NPeaks == 1) {
-          Exponentials.SetParLimits(2 * (i + 1) + 1, peakMeanRangeLow, peakMeanRangeHi);
-        }
-        else if (NPeaks >= 2 && i == 0) {
-          double HalfDistanceToNextMean = 0.5 * (std::get<0>(fPeakVals.at(i + 1)) - peakMean);
-          Exponentials.SetParLimits(
-            2 * (i + 1) + 1,
-            peakMeanRangeLow,
-            std::min(peakMeanRangeHi, peakMeanSeed + HalfDistanceToNextMean));
-        }
-        else if (NPeaks >= 2 && i == NPeaks - 1) {
-          double HalfDistanceToPrevMean = 0.5 * (peakMean - std::get<0>(fPeakVals.at(i - 1)));
-          Exponentials.SetParLimits(
-            2 * (i + 1) + 1,
-            std::max(peakMeanRangeLow, peakMeanSeed - HalfDistanceToPrevMean),
-            peakMeanRangeHi);
-        }
-        else {
-          double HalfDistanceToNextMean = 0.5 * (std::get<0>(fPeakVals.at(i + 1)) - peakMean);
-          double HalfDistanceToPrevMean = 0.5 * (peakMean - std::get<0>(fPeakVals.at(i - 1)));
-          Exponentials.SetParLimits(
-            2 * (i + 1) + 1,
-            std::max(peakMeanRangeLow, peakMeanSeed - HalfDistanceToPrevMean),
-            std::min(peakMeanRangeHi, peakMeanSeed + HalfDistanceToNextMean));
-        }
-
-        if (fLogLevel >= 4) {
-          double t0low, t0high;
-          Exponentials.GetParLimits(2 * (i + 1) + 1, t0low, t0high);
-          std::cout << "Peak #" << i << ": A [ADC] = " << 0.3 * 1.65 * amplitude << "  ,  "
-                    << 1.65 * amplitude << "  ,  " << 2 * 1.65 * amplitude << std::endl;
-          std::cout << "Peak #" << i << ": t0 [ticks] = " << t0low << "  ,  " << peakMeanSeed
-                    << "  ,  " << t0high << std::endl;
-        }
-      }
-    }
-    else {
-      double amplitude = 0;
-      double peakMean = 0;
-
-      double peakMeanShift = 2;
-      double peakMeanSeed = 0;
-      double peakMeanRangeLow = 0;
-      double peakMeanRangeHi = 0;
-      double peakStart = 0;
-      double peakEnd = 0;
-
-      for (int i = 0; i < NPeaks; i++) {
-        Exponentials.SetParameter(4 * i, 0.5);
-        Exponentials.SetParameter(4 * i + 1, 0.5);
-        Exponentials.SetParLimits(4 * i, fMinTau, fMaxTau);
-        Exponentials.SetParLimits(4 * i + 1, fMinTau, fMaxTau);
-
-        peakMean = std::get<0>(fPeakVals.at(i));
-        peakStart = std::get<2>(fPeakVals.at(i));
-        peakEnd = std::get<3>(fPeakVals.at(i));
-        peakMeanSeed = peakMean - peakMeanShift;
-        peakMeanRangeLow = std::max(peakStart - peakMeanShift, peakMeanSeed - fFitPeakMeanRange);
-        peakMeanRangeHi = std::min(peakEnd, peakMeanSeed + fFitPeakMeanRange);
-        amplitude = fSignalVector[peakMean];
-
-        Exponentials.SetParameter(4 * i + 2, 1.65 * amplitude);
-        Exponentials.SetParLimits(4 * i + 2, 0.3 * 1.65 * amplitude, 2 * 1.65 * amplitude);
-        Exponentials.SetParameter(4 * i + 3, peakMeanSeed);
-
-        if (NPeaks == 1) {
-          Exponentials.SetParLimits(4 * i + 3, peakMeanRangeLow, peakMeanRangeHi);
-        }
-        else if (NPeaks >= 2 && i == 0) {
-          double HalfDistanceToNextMean = 0.5 * (std::get<0>(fPeakVals.at(i + 1)) - peakMean);
-          Exponentials.SetParLimits(
-            4 * i + 3,
-            peakMeanRangeLow,
-            std::min(peakMeanRangeHi, peakMeanSeed + HalfDistanceToNextMean));
-        }
-        else if (NPeaks >= 2 && i == NPeaks - 1) {
-          double HalfDistanceToPrevMean = 0.5 * (peakMean - std::get<0>(fPeakVals.at(i - 1)));
-          Exponentials.SetParLimits(
-            4 * i + 3,
-            std::max(peakMeanRangeLow, peakMeanSeed - HalfDistanceToPrevMean),
-            peakMeanRangeHi);
-        }
-        else {
-          double HalfDistanceToNextMean = 0.5 * (std::get<0>(fPeakVals.at(i + 1)) - peakMean);
-          double HalfDistanceToPrevMean = 0.5 * (peakMean - std::get<0>(fPeakVals.at(i - 1)));
-          Exponentials.SetParLimits(
-            4 * i + 3,
-            std::max(peakMeanRangeLow, peakMeanSeed - HalfDistanceToPrevMean),
-            std::min(peakMeanRangeHi, peakMeanSeed + HalfDistanceToNextMean));
-        }
-
-        if (fLogLevel >= 4) {
-          double t0low, t0high;
-          Exponentials.GetParLimits(4 * i + 3, t0low, t0high);
-          std::cout << "Peak #" << i << ": A [ADC] = " << 0.3 * 1.65 * amplitude << "  ,  "
-                    << 1.65 * amplitude << "  ,  " << 2 * 1.65 * amplitude << std::endl;
-          std::cout << "Peak #" << i << ": t0 [ticks] = " << t0low << "  ,  " << peakMeanSeed
-                    << "  ,  " << t0high << std::endl;
-        }
-      }
+    for (int k = 0; k < nParams; k++) {
+      Exponentials.SetParameter(k, parSeed[k]);
+      Exponentials.SetParLimits(k, parLow[k], parHigh[k]);
     }
 
     // ###########################################
@@ -1484,28 +1449,9 @@ namespace hit {
     fchi2PerNDF = (Exponentials.GetChisquare() / Exponentials.GetNDF());
     fNDF = Exponentials.GetNDF();
 
-    if (fSameShape) {
-      fparamVec.emplace_back(Exponentials.GetParameter(0), Exponentials.GetParError(0));
-      fparamVec.emplace_back(Exponentials.GetParameter(1), Exponentials.GetParError(1));
+    for (int k = 0; k < nParams; k++)
+      fparamVec.emplace_back(Exponentials.GetParameter(k), Exponentials.GetParError(k));
 
-      for (int i = 0; i < NPeaks; i++) {
-        fparamVec.emplace_back(Exponentials.GetParameter(2 * (i + 1)),
-                               Exponentials.GetParError(2 * (i + 1)));
-        fparamVec.emplace_back(Exponentials.GetParameter(2 * (i + 1) + 1),
-                               Exponentials.GetParError(2 * (i + 1) + 1));
-      }
-    }
-    else {
-      for (int i = 0; i < NPeaks; i++) {
-        fparamVec.emplace_back(Exponentials.GetParameter(4 * i), Exponentials.GetParError(4 * i));
-        fparamVec.emplace_back(Exponentials.GetParameter(4 * i + 1),
-                               Exponentials.GetParError(4 * i + 1));
-        fparamVec.emplace_back(Exponentials.GetParameter(4 * i + 2),
-                               Exponentials.GetParError(4 * i + 2));
-        fparamVec.emplace_back(Exponentials.GetParameter(4 * i + 3),
-                               Exponentials.GetParError(4 * i + 3));
-      }
-    }
     Exponentials.Delete();
     hitSignal.Delete();
   } //<----End FitExponentials
@@ -1581,60 +1527,8 @@ namespace hit {
   //---------------------------------------------------------------------------------------------
   std::string hit::DPRawHitFinder::CreateFitFunction(int fNPeaks, bool fSameShape)
   {
-    std::string feqn = ""; // string holding fit formula
-    std::stringstream numConv;
-
-    if (fSameShape) {
-      for (int i = 0; i < fNPeaks; i++) {
-        feqn.append("+( [");
-        numConv.str("");
-        numConv << 2 * (i + 1);
-        feqn.append(numConv.str());
-        feqn.append("] * exp(0.4*(x-[");
-        numConv.str("");
-        numConv << 2 * (i + 1) + 1;
-        feqn.append(numConv.str());
-        feqn.append("])/[");
-        numConv.str("");
-        numConv << 0;
-        feqn.append(numConv.str());
-        feqn.append("]) / ( 1 + exp(0.4*(x-[");
-        numConv.str("");
-        numConv << 2 * (i + 1) + 1;
-        feqn.append(numConv.str());
-        feqn.append("])/[");
-        numConv.str("");
-        numConv << 1;
-        feqn.append(numConv.str());
-        feqn.append("]) ) )");
-      }
-    }
-    else {
-      for (int i = 0; i < fNPeaks; i++) {
-        feqn.append("+( [");
-        numConv.str("");
-        numConv << 4 * i + 2;
-        feqn.append(numConv.str());
-        feqn.append("] * exp(0.4*(x-[");
-        numConv.str("");
-        numConv << 4 * i + 3;
-        feqn.append(numConv.str());
-        feqn.append("])/[");
-        numConv.str("");
-        numConv << 4 * i;
-        feqn.append(numConv.str());
-        feqn.append("]) / ( 1 + exp(0.4*(x-[");
-        numConv.str("");
-        numConv << 2 * (i + 1) + 1;
-        feqn.append(numConv.str());
-        feqn.append("])/[");
-        numConv.str("");
-        numConv << 4 * i + 1;
-        feqn.append(numConv.str());
-        feqn.append("]) ) )");
-      }
-    }
-    return feqn;
+    // the formula shared with the analytic fitter, so that both fit the same model
+    return MultiExponentialFitter::Formula(fNPeaks, fSameShape);
   }
 
   //---------------------------------------------------------------------------------------------
@@ -23,8 +23,9 @@
 ////////////////////////////////////////////////////////////////////////
 
 // C/C++ standard library
-#include <algorithm> // std::accumulate()
+#include <algorithm> // std::accumulate(), std::count_if()
 #include <atomic>
+#include <chrono>
 #include <memory> // std::unique_ptr()
 #include <string>
 #include <utility> // std::move()
@@ -39,6 +40,7 @@
 #include "art_root_io/TFileService.h"
 #include "canvas/Persistency/Common/FindOneP.h"
 #include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 
 // LArSoft Includes
 #include "larcore/Geometry/Geometry.h"
@@ -55,8 +57,9 @@
 #include "TH1F.h"
 #include "TMath.h"
 
-#include "tbb/concurrent_vector.h"
+#include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 
 namespace hit {
   class GausHitFinder : public art::SharedProducer {
@@ -66,21 +69,49 @@ namespace hit {
   private:
     struct hitstruct {
       recob::Hit hit_tbb;
-      art::Ptr<recob::Wire> wire_tbb;
       bool keep;
 
-      // Constructor that matches the arguments you're trying to pass
+      hitstruct(recob::Hit h, bool k) : hit_tbb(std::move(h)), keep(k) {}
+    };
+
+    // the hits of one ROI, in the order they were made, as a slice of the hits of a thread
+    struct HitBlock {
+      size_t wireIter;
+      size_t roiIter;
+      size_t first;
+      size_t last;
+    };
+
+    // hits made by one thread during one event
+    struct ThreadHits {
+      std::vector<hitstruct> hits;
+      std::vector<HitBlock> blocks;
+    };
 
-      hitstruct(recob::Hit h, art::Ptr<recob::Wire> w, bool k)
-	: hit_tbb(std::move(h)), wire_tbb(w), keep(k) {}
+    // candidate and fit buffers of one thread, reused for every ROI it processes
+    struct ThreadScratch {
+      reco_tool::ICandidateHitFinder::HitCandidateVec hitCandidateVec;
+      reco_tool::ICandidateHitFinder::MergeHitCandidateVec mergedCandidateHitVec;
+      reco_tool::IPeakFitter::PeakParamsVec peakParamsVec;
     };
 
+    using ThreadHitsVec = tbb::enumerable_thread_specific<ThreadHits>;
+
     void produce(art::Event& evt, art::ProcessingFrame const&) override;
-    tbb::concurrent_vector<hitstruct> processWire(size_t wireIter, const art::Handle<std::vector<recob::Wire>>& wireVecHandle, geo::Geometry const &geom, unsigned int count);
+    void processWire(size_t wireIter,
+                     const art::Handle<std::vector<recob::Wire>>& wireVecHandle,
+                     geo::Geometry const& geom,
+                     unsigned int count,
+                     ThreadHitsVec& threadHits);
+
+    /// Blocks of all threads in wire and ROI order, which is the order of a serial loop
+    static std::vector<std::pair<ThreadHits*, const HitBlock*>> orderBlocks(
+      ThreadHitsVec& threadHits);
 
     std::vector<double> FillOutHitParameterVector(const std::vector<double>& input);
     std::function<double(double, double, double, double, int, int)> getCharge;
     const bool fFilterHits;
+    const bool fReportThroughput; ///< log wires and hits per second and the threads making hits
     //const bool fFillHists;
 
     const std::string fCalDataModuleLabel;
@@ -109,6 +140,8 @@ namespace hit {
     //HitFilterAlg implementation is threadsafe.
     std::unique_ptr<HitFilterAlg> fHitFilterAlg; ///< algorithm used to filter out noise hits
 
+    tbb::enumerable_thread_specific<ThreadScratch> fScratch; ///< per thread candidate buffers
+
     //only used when fFillHists is true and in single threaded mode.
     //TH1F* fFirstChi2;
     //TH1F* fChi2;
@@ -120,6 +153,7 @@ namespace hit {
   GausHitFinder::GausHitFinder(fhicl::ParameterSet const& pset, art::ProcessingFrame const&)
     : SharedProducer{pset}
     , fFilterHits(pset.get<bool>("FilterHits", false))
+    , fReportThroughput(pset.get<bool>("ReportThroughput", false))
     //, fFillHists(pset.get<bool>("FillHists", false))
     , fCalDataModuleLabel(pset.get<std::string>("CalDataModuleLabel"))
     , fAllHitsInstanceName(pset.get<std::string>("AllHitsInstanceName", ""))
@@ -224,13 +258,18 @@ namespace hit {
 
 
 
-  tbb::concurrent_vector<GausHitFinder::hitstruct> GausHitFinder::processWire(size_t wireIter, const art::Handle<std::vector<recob::Wire>>& wireVecHandle, geo::Geometry const& geom, unsigned int count) {
+  void GausHitFinder::processWire(size_t wireIter,
+                                  const art::Handle<std::vector<recob::Wire>>& wireVecHandle,
+                                  geo::Geometry const& geom,
+                                  unsigned int count,
+                                  ThreadHitsVec& threadHits)
+  {
     // ####################################
     // ### Getting this particular wire ###
     // ####################################
-    art::Ptr<recob::Wire> wire(wireVecHandle, wireIter);
+    const recob::Wire& wire = (*wireVecHandle)[wireIter];
     // --- Setting Channel Number and Signal type ---
-    raw::ChannelID_t channel = wire->Channel();
+    raw::ChannelID_t channel = wire.Channel();
     // get the WireID for this hit
     std::vector<geo::WireID> wids = geom.ChannelToWire(channel);
     // for now, just take the first option returned from ChannelToWire
@@ -244,252 +283,282 @@ namespace hit {
     // #################################################
     // ### Set up to loop over ROI's for this wire   ###
     // #################################################
-    const recob::Wire::RegionsOfInterest_t& signalROI = wire->SignalROI();
-
-    tbb::concurrent_vector<hitstruct> processHits_vec;
+    const recob::Wire::RegionsOfInterest_t& signalROI = wire.SignalROI();
 
     tbb::parallel_for(
-		      static_cast<std::size_t>(0),
-		      signalROI.n_ranges(),
-		      [&](size_t& rangeIter) {
-			const auto& range = signalROI.range(rangeIter);
-			// ROI start time
-			raw::TDCtick_t roiFirstBinTick = range.begin_index();
-			  // ###########################################################
-			// ### Scan the waveform and find candidate peaks + merge  ###
-			// ###########################################################
-
-			reco_tool::ICandidateHitFinder::HitCandidateVec hitCandidateVec;
-			reco_tool::ICandidateHitFinder::MergeHitCandidateVec mergedCandidateHitVec;
-
-			fHitFinderToolVec.at(plane)->findHitCandidates(
-								       range, 0, channel, count, hitCandidateVec);
-			fHitFinderToolVec.at(plane)->MergeHitCandidates(
-									range, hitCandidateVec, mergedCandidateHitVec);
-
-			// #######################################################
-			// ### Lets loop over the pulses we found on this wire ###
-			// #######################################################
-
-			for (auto& mergedCands : mergedCandidateHitVec) {
-			  int startT = mergedCands.front().startTick;
-			  int endT = mergedCands.back().stopTick;
-
-			  // ### Putting in a protection in case things went wrong ###
-			  // ### In the end, this primarily catches the case where ###
-			  // ### a fake pulse is at the start of the ROI           ###
-			  if (endT - startT < 5) continue;
-
-			  // #######################################################
-			  // ### Clearing the parameter vector for the new pulse ###
-			  // #######################################################
-
-			  // === Setting the number of Gaussians to try ===
-			  int nGausForFit = mergedCands.size();
-
-			  // ##################################################
-			  // ### Calling the function for fitting Gaussians ###
-			  // ##################################################
-			  double chi2PerNDF(0.);
-			  int NDF(1);
-			  /*stand alone
-			    reco_tool::IPeakFitter::PeakParamsVec peakParamsVec(nGausForFit);
-			  */
-			  reco_tool::IPeakFitter::PeakParamsVec peakParamsVec;
-
-			  // #######################################################
-			  // ### If # requested Gaussians is too large then punt ###
-			  // #######################################################
-			  if (mergedCands.size() <= fMaxMultiHit) {
-			    fPeakFitterTool->findPeakParameters(
-								range.data(), mergedCands, peakParamsVec, chi2PerNDF, NDF);
-
-			    // If the chi2 is infinite then there is a real problem so we bail
-			    if (!(chi2PerNDF < std::numeric_limits<double>::infinity())) {
-			      chi2PerNDF = 2. * fChi2NDF;
-			      NDF = 2;
-			    }
-			  
-			  }
-
-
-
-			  // #######################################################
-			  // ### If too large then force alternate solution      ###
-			  // ### - Make n hits from pulse train where n will     ###
-			  // ###   depend on the fhicl parameter fLongPulseWidth ###
-			  // ### Also do this if chi^2 is too large              ###
-			  // #######################################################
-			  if (mergedCands.size() > fMaxMultiHit || nGausForFit * chi2PerNDF > fChi2NDF) {
-			  
-			    int longPulseWidth = fLongPulseWidthVec.at(plane);
-			    int nHitsThisPulse = (endT - startT) / longPulseWidth;
-
-			    if (nHitsThisPulse > fLongMaxHitsVec.at(plane)) {
-			      nHitsThisPulse = fLongMaxHitsVec.at(plane);
-			      longPulseWidth = (endT - startT) / nHitsThisPulse;
-			    }
-			    nHitsThisPulse += ((endT - startT) % fLongPulseWidthVec.at(plane)) > 0 ? 1 : 0; // Adjust for partial hit
-
-			    int firstTick = startT;
-			    int lastTick = std::min(firstTick + longPulseWidth, endT);
-
-			    peakParamsVec.clear();
-			    nGausForFit = nHitsThisPulse;
-			    NDF = 1.;
-			    chi2PerNDF = chi2PerNDF > fChi2NDF ? chi2PerNDF : -1.;
-
-			    for (int hitIdx = 0; hitIdx < nHitsThisPulse; hitIdx++) {
-			      // This hit parameters
-			      double sumADC =
-				std::accumulate(range.begin() + firstTick, range.begin() + lastTick, 0.);
-			      double peakSigma = (lastTick - firstTick) / 3.; // Set the width...
-			      double peakAmp = 0.3989 * sumADC / peakSigma;   // Use gaussian formulation
-			      double peakMean = (firstTick + lastTick) / 2.;
-
-			      // Store hit params
-			      reco_tool::IPeakFitter::PeakFitParams_t peakParams;
-
-			      peakParams.peakCenter = peakMean;
-			      peakParams.peakCenterError = 0.1 * peakMean;
-			      peakParams.peakSigma = peakSigma;
-			      peakParams.peakSigmaError = 0.1 * peakSigma;
-			      peakParams.peakAmplitude = peakAmp;
-			      peakParams.peakAmplitudeError = 0.1 * peakAmp;
-
-			      peakParamsVec.push_back(peakParams);
-
-			      // set for next loop
-			      firstTick = lastTick;
-			      lastTick = std::min(lastTick + longPulseWidth, endT);
-			    }
-			  }
-
-			  // #######################################################
-			  // ### Loop through returned peaks and make recob hits ###
-			  // #######################################################
-
-			  int numHits(0);
-
-			  // Make a container for what will be ALL the hit collection
-			  std::vector<hitstruct> Hits;
-			  for (const auto& peakParams : peakParamsVec) {
-			    // Extract values for this hit
-			    float peakAmp = peakParams.peakAmplitude;
-			    float peakMean = peakParams.peakCenter;
-			    float peakWidth = peakParams.peakSigma;
-
-			    // Place one bit of protection here
-			    if (std::isnan(peakAmp)) {
-			      std::cout << "**** hit peak amplitude is a nan! Channel: " << channel
-					<< ", start tick: " << startT << std::endl;
-			      continue;
-			    }
-
-			    // Extract errors
-			    float peakAmpErr = peakParams.peakAmplitudeError;
-			    float peakMeanErr = peakParams.peakCenterError;
-			    float peakWidthErr = peakParams.peakSigmaError;
-
-			    // ### Charge ###
-			    float charge =
-			      getCharge(peakMean, peakAmp, peakWidth, fAreaNormsVec[plane], startT, endT);
-
-			    ;
-			    float chargeErr =
-			      std::sqrt(TMath::Pi()) * (peakAmpErr * peakWidthErr + peakWidthErr * peakAmpErr);
-
-			    // ### limits for getting sums
-			    std::vector<float>::const_iterator sumStartItr = range.begin() + startT;
-			    std::vector<float>::const_iterator sumEndItr = range.begin() + endT;
-
-			    // ### Sum of ADC counts
-			    double sumADC = std::accumulate(sumStartItr, sumEndItr, 0.);
-
-			    // ok, now create the hit
-			    recob::HitCreator hitcreator(
-							 *wire,                      // wire reference
-							 wid,                        // wire ID
-							 startT + roiFirstBinTick,   // start_tick TODO check
-							 endT + roiFirstBinTick,     // end_tick TODO check
-							 peakWidth,                  // rms
-							 peakMean + roiFirstBinTick, // peak_time
-							 peakMeanErr,                // sigma_peak_time
-							 peakAmp,                    // peak_amplitude
-							 peakAmpErr,                 // sigma_peak_amplitude
-							 charge,                     // hit_integral
-							 chargeErr,                  // hit_sigma_integral
-							 sumADC,                     // summedADC FIXME
-							 nGausForFit,                // multiplicity
-							 numHits,                    // local_index TODO check that the order is correct
-							 chi2PerNDF,                 // goodness_of_fit
-							 NDF                         // dof
-							 );
-
-			    Hits.emplace_back(hitcreator.move(), wire, false); //a local vector of hitsruct
-
-			    numHits++;
-
-			  } // <---End loop over gaussians
-
-			  // Should we filter hits?
-			  if (!fHitFilterAlg || Hits.empty()) {
-			    processHits_vec.grow_by(Hits.begin(), Hits.end());
-			    continue;
-			  }
-
-			  
-
-
-			  // #######################################################################
-			  // Is all this sorting really necessary?  Would it be faster to just loop
-			  // through the hits and perform simple cuts on amplitude and width on a
-			  // hit-by-hit basis, either here in the module (using fPulseHeightCuts and
-			  // fPulseWidthCuts) or in HitFilterAlg?
-			  // #######################################################################
-
-
-			  // Sort in ascending peak height
-			  std::sort(Hits.begin(),
-				    Hits.end(),
-				    [](const auto& left, const auto& right) {
-				      return left.hit_tbb.PeakAmplitude() > right.hit_tbb.PeakAmplitude();
-				    });
-
-			  // #####################################################
-			  // This is redundant in the new logic - we can get rid of this part without any harm
-			  // we can't continue here as we want to still store the hits that fail this statement
-			  // ######################################################
-
-			  // Reject if the first hit fails the PH/wid cuts
-
-			  if (Hits.front().hit_tbb.PeakAmplitude() < fPulseHeightCuts.at(plane) ||
-			      Hits.front().hit_tbb.RMS() < fPulseWidthCuts.at(plane)) {
-			    processHits_vec.grow_by(Hits.begin(), Hits.end());
-
-			    continue; 
-			  }
-			  // Now check other hits in the snippet
-
-			  // The largest pulse height will now be at the front...
-			  float largestPH = Hits.front().hit_tbb.PeakAmplitude();
-
-			  // Find where the pulse heights drop below threshold
-			  float threshold(fPulseRatioCuts.at(plane));
-
-			  for (auto& hit : Hits) {
-			    hit.keep = !(hit.hit_tbb.PeakAmplitude() < 8. && hit.hit_tbb.PeakAmplitude() / largestPH < threshold) && fHitFilterAlg->IsGoodHit(hit.hit_tbb);
-			    
-
-			  }
-
-			  processHits_vec.grow_by(Hits.begin(), Hits.end());
+      static_cast<std::size_t>(0), signalROI.n_ranges(), [&](size_t rangeIter) {
+        const auto& range = signalROI.range(rangeIter);
+        // ROI start time
+        raw::TDCtick_t roiFirstBinTick = range.begin_index();
+
+        // the buffers stay with this task until it returns, the tools do not spawn tasks
+        ThreadScratch& scratch = fScratch.local();
+        ThreadHits& threadOut = threadHits.local();
+        std::vector<hitstruct>& Hits = threadOut.hits;
+        const size_t roiFirstHit = Hits.size();
+
+        // ###########################################################
+        // ### Scan the waveform and find candidate peaks + merge  ###
+        // ###########################################################
+
+        reco_tool::ICandidateHitFinder::HitCandidateVec& hitCandidateVec = scratch.hitCandidateVec;
+        reco_tool::ICandidateHitFinder::MergeHitCandidateVec& mergedCandidateHitVec =
+          scratch.mergedCandidateHitVec;
+
+        // the tools append to their outputs
+        hitCandidateVec.clear();
+        mergedCandidateHitVec.clear();
+
+        fHitFinderToolVec.at(plane)->findHitCandidates(range, 0, channel, count, hitCandidateVec);
+        fHitFinderToolVec.at(plane)->MergeHitCandidates(
+          range, hitCandidateVec, mergedCandidateHitVec);
+
+        // #######################################################
+        // ### Lets loop over the pulses we found on this wire ###
+        // #######################################################
+
+        for (auto& mergedCands : mergedCandidateHitVec) {
+          int startT = mergedCands.front().startTick;
+          int endT = mergedCands.back().stopTick;
+
+          // ### Putting in a protection in case things went wrong ###
+          // ### In the end, this primarily catches the case where ###
+          // ### a fake pulse is at the start of the ROI           ###
+          if (endT - startT < 5) continue;
+
+          // #######################################################
+          // ### Clearing the parameter vector for the new pulse ###
+          // #######################################################
+
+          // === Setting the number of Gaussians to try ===
+          int nGausForFit = mergedCands.size();
+
+          // ##################################################
+          // ### Calling the function for fitting Gaussians ###
+          // ##################################################
+          double chi2PerNDF(0.);
+          int NDF(1);
+          reco_tool::IPeakFitter::PeakParamsVec& peakParamsVec = scratch.peakParamsVec;
+          peakParamsVec.clear();
+
+          // #######################################################
+          // ### If # requested Gaussians is too large then punt ###
+          // #######################################################
+          if (mergedCands.size() <= fMaxMultiHit) {
+            fPeakFitterTool->findPeakParameters(
+              range.data(), mergedCands, peakParamsVec, chi2PerNDF, NDF);
+
+            // If the chi2 is infinite then there is a real problem so we bail
+            if (!(chi2PerNDF < std::numeric_limits<double>::infinity())) {
+              chi2PerNDF = 2. * fChi2NDF;
+              NDF = 2;
+            }
+          }
+
+          // #######################################################
+          // ### If too large then force alternate solution      ###
+          // ### - Make n hits from pulse train where n will     ###
+          // ###   depend on the fhicl parameter fLongPulseWidth ###
+          // ### Also do this if chi^2 is too large              ###
+          // #######################################################
+          if (mergedCands.size() > fMaxMultiHit || nGausForFit * chi2PerNDF > fChi2NDF) {
+
+            int longPulseWidth = fLongPulseWidthVec.at(plane);
+            int nHitsThisPulse = (endT - startT) / longPulseWidth;
+
+            if (nHitsThisPulse > fLongMaxHitsVec.at(plane)) {
+              nHitsThisPulse = fLongMaxHitsVec.at(plane);
+              longPulseWidth = (endT - startT) / nHitsThisPulse;
+            }
+            // Adjust for partial hit
+            nHitsThisPulse += ((endT - startT) % fLongPulseWidthVec.at(plane)) > 0 ? 1 : 0;
+
+            int firstTick = startT;
+            int lastTick = std::min(firstTick + longPulseWidth, endT);
+
+            peakParamsVec.clear();
+            nGausForFit = nHitsThisPulse;
+            NDF = 1.;
+            chi2PerNDF = chi2PerNDF > fChi2NDF ? chi2PerNDF : -1.;
+
+            for (int hitIdx = 0; hitIdx < nHitsThisPulse; hitIdx++) {
+              // This hit parameters
+              double sumADC =
+                std::accumulate(range.begin() + firstTick, range.begin() + lastTick, 0.);
+              double peakSigma = (lastTick - firstTick) / 3.; // Set the width...
+              double peakAmp = 0.3989 * sumADC / peakSigma;   // Use gaussian formulation
+              double peakMean = (firstTick + lastTick) / 2.;
+
+              // Store hit params
+              reco_tool::IPeakFitter::PeakFitParams_t peakParams;
+
+              peakParams.peakCenter = peakMean;
+              peakParams.peakCenterError = 0.1 * peakMean;
+              peakParams.peakSigma = peakSigma;
+              peakParams.peakSigmaError = 0.1 * peakSigma;
+              peakParams.peakAmplitude = peakAmp;
+              peakParams.peakAmplitudeError = 0.1 * peakAmp;
+
+              peakParamsVec.push_back(peakParams);
+
+              // set for next loop
+              firstTick = lastTick;
+              lastTick = std::min(lastTick + longPulseWidth, endT);
+            }
+          }
+
+          // #######################################################
+          // ### Loop through returned peaks and make recob hits ###
+          // #######################################################
+
+          int numHits(0);
+
+          // the hits of this pulse are appended to the hits of the thread
+          const size_t pulseFirstHit = Hits.size();
+          for (const auto& peakParams : peakParamsVec) {
+            // Extract values for this hit
+            float peakAmp = peakParams.peakAmplitude;
+            float peakMean = peakParams.peakCenter;
+            float peakWidth = peakParams.peakSigma;
+
+            // Place one bit of protection here
+            if (std::isnan(peakAmp)) {
+              std::cout << "**** hit peak amplitude is a nan! Channel: " << channel
+                        << ", start tick: " << startT << std::endl;
+              continue;
+            }
+
+            // Extract errors
+            float peakAmpErr = peakParams.peakAmplitudeError;
+            float peakMeanErr = peakParams.peakCenterError;
+            float peakWidthErr = peakParams.peakSigmaError;
+
+            // ### Charge ###
+            float charge =
+              getCharge(peakMean, peakAmp, peakWidth, fAreaNormsVec[plane], startT, endT);
+
+            float chargeErr =
+              std::sqrt(TMath::Pi()) * (peakAmpErr * peakWidthErr + peakWidthErr * peakAmpErr);
+
+            // ### limits for getting sums
+            std::vector<float>::const_iterator sumStartItr = range.begin() + startT;
+            std::vector<float>::const_iterator sumEndItr = range.begin() + endT;
+
+            // ### Sum of ADC counts
+            double sumADC = std::accumulate(sumStartItr, sumEndItr, 0.);
+
+            // ok, now create the hit
+            recob::HitCreator hitcreator(
+              wire,                       // wire reference
+              wid,                        // wire ID
+              startT + roiFirstBinTick,   // start_tick TODO check
+              endT + roiFirstBinTick,     // end_tick TODO check
+              peakWidth,                  // rms
+              peakMean + roiFirstBinTick, // peak_time
+              peakMeanErr,                // sigma_peak_time
+              peakAmp,                    // peak_amplitude
+              peakAmpErr,                 // sigma_peak_amplitude
+              charge,                     // hit_integral
+              chargeErr,                  // hit_sigma_integral
+              sumADC,                     // summedADC FIXME
+              nGausForFit,                // multiplicity
+              numHits,                    // local_index TODO check that the order is correct
+              chi2PerNDF,                 // goodness_of_fit
+              NDF                         // dof
+            );
+
+            Hits.emplace_back(hitcreator.move(), false);
+
+            numHits++;
+
+          } // <---End loop over gaussians
+
+          // Should we filter hits?
+          if (!fHitFilterAlg || Hits.size() == pulseFirstHit) continue;
+
+          // #######################################################################
+          // Is all this sorting really necessary?  Would it be faster to just loop
+          // through the hits and perform simple cuts on amplitude and width on a
+          // hit-by-hit basis, either here in the module (using fPulseHeightCuts and
+          // fPulseWidthCuts) or in HitFilterAlg?
+          // #######################################################################
+
+          const auto pulseBegin = Hits.begin() + pulseFirstHit;
+
+          // Sort in ascending peak height
+          std::sort(pulseBegin, Hits.end(), [](const auto& left, const auto& right) {
+            return left.hit_tbb.PeakAmplitude() > right.hit_tbb.PeakAmplitude();
+          });
+
+          // #####################################################
+          // This is redundant in the new logic - we can get rid of this part without any harm
+          // we can't continue here as we want to still store the hits that fail this statement
+          // ######################################################
+
+          // Reject if the first hit fails the PH/wid cuts
+          if (pulseBegin->hit_tbb.PeakAmplitude() < fPulseHeightCuts.at(plane) ||
+              pulseBegin->hit_tbb.RMS() < fPulseWidthCuts.at(plane))
+            continue;
+
+          // Now check other hits in the snippet
+
+          // The largest pulse height will now be at the front...
+          float largestPH = pulseBegin->hit_tbb.PeakAmplitude();
+
+          // Find where the pulse heights drop below threshold
+          float threshold(fPulseRatioCuts.at(plane));
+
+          for (auto hitItr = pulseBegin; hitItr != Hits.end(); ++hitItr) {
+            hitItr->keep = !(hitItr->hit_tbb.PeakAmplitude() < 8. &&
+                             hitItr->hit_tbb.PeakAmplitude() / largestPH < threshold) &&
+                           fHitFilterAlg->IsGoodHit(hitItr->hit_tbb);
+          }
+
+        } //<---End loop over merged candidate hits
+
+        if (Hits.size() > roiFirstHit)
+          threadOut.blocks.push_back({wireIter, rangeIter, roiFirstHit, Hits.size()});
+      } //<---End looping over ROI's // lambda function
+    );  // end loop tbb parallel for
+  }
 
-			} //<---End loop over merged candidate hits
-		      }   //<---End looping over ROI's // lambda function
-		      ); // end loop tbb parallel for 
-    return processHits_vec;
+  //-------------------------------------------------
+  std::vector<std::pair<GausHitFinder::ThreadHits*, const GausHitFinder::HitBlock*>>
+  GausHitFinder::orderBlocks(ThreadHitsVec& threadHits)
+  {
+    auto blockOrder = [](const HitBlock& left, const HitBlock& right) {
+      return left.wireIter < right.wireIter ||
+             (left.wireIter == right.wireIter && left.roiIter < right.roiIter);
+    };
 
+    // a thread takes its wires and ROIs in no particular order; sort the blocks of each
+    // thread, then merge the threads taking the smallest next block each time
+    std::vector<std::pair<ThreadHits*, size_t>> heads;
+    size_t nBlocks = 0;
+    for (ThreadHits& threadOut : threadHits) {
+      if (threadOut.blocks.empty()) continue;
+      std::sort(threadOut.blocks.begin(), threadOut.blocks.end(), blockOrder);
+      heads.emplace_back(&threadOut, 0);
+      nBlocks += threadOut.blocks.size();
+    }
+
+    auto headAfter = [&blockOrder](const auto& left, const auto& right) {
+      return blockOrder(right.first->blocks[right.second], left.first->blocks[left.second]);
+    };
+    std::make_heap(heads.begin(), heads.end(), headAfter);
+
+    std::vector<std::pair<ThreadHits*, const HitBlock*>> ordered;
+    ordered.reserve(nBlocks);
+    while (!heads.empty()) {
+      std::pop_heap(heads.begin(), heads.end(), headAfter);
+      auto& head = heads.back();
+      ordered.emplace_back(head.first, &head.first->blocks[head.second]);
+      if (++head.second < head.first->blocks.size())
+        std::push_heap(heads.begin(), heads.end(), headAfter);
+      else
+        heads.pop_back();
+    }
+    return ordered;
   }
 
   //  This algorithm uses the fact that deconvolved signals are very smooth
@@ -503,80 +572,81 @@ namespace hit {
 
     TH1::AddDirectory(kFALSE);
 
-    // Instantiate and Reset a stop watch
-    //TStopwatch StopWatch;
-    //StopWatch.Reset();
+    auto const startTime = std::chrono::steady_clock::now();
 
     // ################################
     // ### Calling Geometry service ###
     // ################################
     art::ServiceHandle<geo::Geometry const> geom;
 
-    // ###############################################
-    // ### Making a ptr vector to put on the event ###
-    // ###############################################
-
-    //store in a thread safe way                                                                                                                                                                            
-
-
-    tbb::concurrent_vector<hitstruct> hitstruct_vec;
-    //tbb::concurrent_vector<hitstruct> filthitstruct_vec;
-
-    //    if (fAllHitsInstanceName != "") filteredHitCol = &hcol;
-
     // ##########################################
     // ### Reading in the Wire List object(s) ###
     // ##########################################
     art::Handle<std::vector<recob::Wire>> wireVecHandle;
     evt.getByLabel(fCalDataModuleLabel, wireVecHandle);
 
-    //#################################################
-    //###    Set the charge determination method    ###
-    //### Default is to compute the normalized area ###
-    //#################################################
-
     //##############################
     //### Looping over the wires ###
     //##############################
-    //for(size_t wireIter = 0; wireIter < wireVecHandle->size(); wireIter++)
-    //{
-    tbb::parallel_for(
-		      static_cast<size_t>(0), wireVecHandle->size(), [&](size_t wireIter) {
-			auto hits = processWire(wireIter, wireVecHandle, *geom, count);
-			hitstruct_vec.grow_by(hits.begin(), hits.end());
-		      } // close lambda function (wire)
-		      );// end loop tbb parallel for
-    
+    // every thread collects its hits in its own vector, in blocks of one ROI
+    ThreadHitsVec threadHits;
+    tbb::parallel_for(static_cast<size_t>(0), wireVecHandle->size(), [&](size_t wireIter) {
+      processWire(wireIter, wireVecHandle, *geom, count, threadHits);
+    });
+
+    // the blocks in the order of a serial loop over wires and ROIs, so the collections do not
+    // depend on the scheduling
+    const auto orderedBlocks = orderBlocks(threadHits);
+
+    // hits are copied into the filtered collection when the all hits collection follows,
+    // otherwise moved
+    auto fillHits = [&](recob::HitCollectionCreator& hitCol, bool keptOnly, bool moveHits) {
+      for (const auto& [threadOut, block] : orderedBlocks) {
+        const art::Ptr<recob::Wire> wire(wireVecHandle, block->wireIter);
+        auto& hits = threadOut->hits;
+        for (size_t i = block->first; i < block->last; ++i) {
+          if (keptOnly && !hits[i].keep) continue;
+          if (moveHits)
+            hitCol.emplace_back(std::move(hits[i].hit_tbb), wire);
+          else
+            hitCol.emplace_back(hits[i].hit_tbb, wire);
+        }
+      }
+    };
+
     // this contains the hit collection
     // and its associations to wires and raw digits
+    size_t nHits = 0;
     if (fFilterHits) {
       recob::HitCollectionCreator filteredHitCol(evt, "", true, false);
-
-      // Iterate over hitstruct_vec and only emplace_back if keep == true
-
-      for (size_t j = 0; j < hitstruct_vec.size(); j++) {
-	if (hitstruct_vec[j].keep) { // Check if the hit should be kept
-	  filteredHitCol.emplace_back(hitstruct_vec[j].hit_tbb, hitstruct_vec[j].wire_tbb);
-	}
-      }
-
+      fillHits(filteredHitCol, true, fAllHitsInstanceName.empty());
+      nHits = filteredHitCol.size();
       filteredHitCol.put_into(evt);
-
-      if (fAllHitsInstanceName.empty()) {
-	return;
-      }
     }
 
-    recob::HitCollectionCreator allHitCol(evt, fAllHitsInstanceName, true, false);
-    for (size_t i = 0; i < hitstruct_vec.size(); i++) {
-      allHitCol.emplace_back(hitstruct_vec[i].hit_tbb, hitstruct_vec[i].wire_tbb);
+    if (!fFilterHits || !fAllHitsInstanceName.empty()) {
+      recob::HitCollectionCreator allHitCol(evt, fAllHitsInstanceName, true, false);
+      fillHits(allHitCol, false, true);
+      nHits = allHitCol.size();
+      allHitCol.put_into(evt);
     }
-    allHitCol.put_into(evt);
 
+    if (fReportThroughput) {
+      const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+      // threadHits.size() also counts threads that only ran ROIs without hits
+      const auto nThreadsWithHits = std::count_if(
+        threadHits.begin(), threadHits.end(), [](const ThreadHits& t) { return !t.hits.empty(); });
+      mf::LogInfo("GausHitFinder")
+        << "event " << count << ": " << wireVecHandle->size() << " wires, " << nHits
+        << " hits in " << seconds << " s, made by " << nThreadsWithHits << " threads (arena "
+        << tbb::this_task_arena::max_concurrency() << "), "
+        << (seconds > 0 ? wireVecHandle->size() / seconds : 0.) << " wires/s, "
+        << (seconds > 0 ? nHits / seconds : 0.) << " hits/s";
+    }
 
   } // End of produce()
 
   DEFINE_ART_MODULE(GausHitFinder)
 
 } // end of hit namespace
-B
@@ -9,6 +9,7 @@
 */
 
 #include "GaussianEliminationAlg.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -73,46 +74,71 @@ void util::GaussianEliminationAlg::FillAugmentedMatrix(const std::vector<float>&
                                                        const std::vector<float>& heightVector)
 {
 
-  fMatrix.resize(meanVector.size());
-  for (size_t i = 0; i < meanVector.size(); i++) {
+  fNEquations = meanVector.size();
+  const size_t n_cols = fNEquations + 1;
 
-    fMatrix[i].resize(meanVector.size() + 1);
-    for (size_t j = 0; j < meanVector.size(); j++) {
+  fMatrix.assign(fNEquations * n_cols, 0.0);
+  fRowEnd.assign(fNEquations, 0);
+  fColEnd.assign(fNEquations, 0);
+
+  for (size_t i = 0; i < fNEquations; i++) {
+
+    double* row = fMatrix.data() + i * n_cols;
+    for (size_t j = 0; j < fNEquations; j++) {
       if (sigmaVector[j] < std::numeric_limits<float>::epsilon()) {
-        if (i == j)
-          fMatrix[i][j] = 1.0;
-        else
-          fMatrix[i][j] = 0.0;
+        if (i == j) row[j] = 1.0;
       }
       else
-        fMatrix[i][j] = GetDistance((meanVector[i] - meanVector[j]) / sigmaVector[j]);
+        row[j] = GetDistance((meanVector[i] - meanVector[j]) / sigmaVector[j]);
+
+      if (row[j] != 0.0) {
+        fRowEnd[i] = j + 1;
+        fColEnd[j] = i + 1;
+      }
     }
-    fMatrix[i][meanVector.size()] = heightVector[i];
+    row[fNEquations] = heightVector[i];
   }
 }
 
 void util::GaussianEliminationAlg::GaussianElimination()
 {
 
-  fSolutions.resize(fMatrix.size(), 0.0);
+  const size_t n_cols = fNEquations + 1;
+
+  fSolutions.resize(fNEquations, 0.0);
+
+  for (size_t i = 0; i < fNEquations; i++) {
+
+    //only rows within the band of column i have something to eliminate; they fill in
+    //at most up to the end of the pivot row, which widens the band of those columns
+    const double* pivot_row = fMatrix.data() + i * n_cols;
+    for (size_t k = i + 1; k < fRowEnd[i]; k++)
+      fColEnd[k] = std::max(fColEnd[k], fColEnd[i]);
+
+    for (size_t j = i + 1; j < fColEnd[i]; j++) {
+      double* row = fMatrix.data() + j * n_cols;
+      float scale_value = row[i] / pivot_row[i];
+
+      //rows with nothing to eliminate are left untouched
+      if (scale_value == 0) continue;
 
-  for (size_t i = 0; i < fMatrix.size(); i++) {
+      for (size_t k = i; k < fRowEnd[i]; k++)
+        row[k] -= pivot_row[k] * scale_value;
+      row[fNEquations] -= pivot_row[fNEquations] * scale_value;
 
-    for (size_t j = i + 1; j < (fMatrix[i].size() - 1); j++) {
-      float scale_value = fMatrix[j][i] / fMatrix[i][i];
-      for (size_t k = i; k < fMatrix[i].size(); k++)
-        fMatrix[j][k] -= fMatrix[i][k] * scale_value;
+      fRowEnd[j] = std::max(fRowEnd[j], fRowEnd[i]);
     } //end column loop
 
   } //end row loop
 
-  for (int i = fMatrix.size() - 1; i >= 0; i--) {
-    fSolutions[i] = fMatrix[i].back();
+  for (int i = fNEquations - 1; i >= 0; i--) {
+    const double* row = fMatrix.data() + i * n_cols;
+    fSolutions[i] = row[fNEquations];
 
-    for (size_t j = i + 1; j < fMatrix.size(); j++)
-      fSolutions[i] -= fMatrix[i][j] * fSolutions[j];
+    for (size_t j = i + 1; j < fRowEnd[i]; j++)
+      fSolutions[i] -= row[j] * fSolutions[j];
 
-    fSolutions[i] /= fMatrix[i][i];
+    fSolutions[i] /= row[i];
   }
 }
 
@@ -127,11 +153,11 @@ void util::GaussianEliminationAlg::Print()
               << std::endl;
 
   std::cout << "\tAugmented matrix " << std::endl;
-  for (size_t i = 0; i < fMatrix.size(); i++) {
+  for (size_t i = 0; i < fNEquations; i++) {
     std::cout << "\t\t | ";
-    for (size_t j = 0; j < fMatrix[i].size() - 1; j++)
-      std::cout << fMatrix[i][j] << " ";
-    std::cout << " | " << fMatrix[i][fMatrix[i].size() - 1] << " |" << std::endl;
+    for (size_t j = 0; j < fNEquations; j++)
+      std::cout << fMatrix[i * (fNEquations + 1) + j] << " ";
+    std::cout << " | " << fMatrix[i * (fNEquations + 1) + fNEquations] << " |" << std::endl;
   }
 
   std::cout << "\tSolutions" << std::endl;
@@ -11,6 +11,7 @@
  *
 */
 
+#include <cstddef>
 #include <vector>
 
 namespace util {
@@ -41,7 +42,16 @@ namespace util {
 
     void FillDistanceLookupTable();
 
-    std::vector<std::vector<double>> fMatrix;
+    //augmented matrix stored row-major with fNEquations+1 columns. Since the
+    //Gaussian overlaps vanish beyond fDistanceMax the matrix is banded when the
+    //means are ordered: fRowEnd holds one past the last non-zero column of each
+    //row (excluding the augmented column) and fColEnd one past the last non-zero
+    //row of each column, both widened by the fill-in of the elimination, so
+    //elimination and back substitution only visit the band.
+    size_t fNEquations = 0;
+    std::vector<double> fMatrix;
+    std::vector<size_t> fRowEnd;
+    std::vector<size_t> fColEnd;
     std::vector<float> fSolutions;
   };
 
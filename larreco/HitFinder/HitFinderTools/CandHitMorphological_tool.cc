@@ -18,6 +18,7 @@
 
 #include "TProfile.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace reco_tool {
@@ -195,32 +196,16 @@ namespace reco_tool {
     HitCandidateVec& hitCandidateVec) const
   {
     // In this case we want to find hit candidates based on the derivative of of the input waveform
-    // We get this from our waveform algs too...
-    Waveform rawDerivativeVec;
-    Waveform derivativeVec;
+    // and on its erosion/dilation vectors. These are kept in per thread buffers reused for each ROI
+    thread_local Waveform derivativeVec;
+    thread_local Waveform erosionVec;
+    thread_local Waveform dilationVec;
 
     // Recover the actual waveform
     const Waveform& waveform = dataRange.data();
 
-    fWaveformTool->firstDerivative(waveform, rawDerivativeVec);
-    fWaveformTool->triangleSmooth(rawDerivativeVec, derivativeVec);
-
-    // Now we get the erosion/dilation vectors
-    Waveform erosionVec;
-    Waveform dilationVec;
-    Waveform averageVec;
-    Waveform differenceVec;
-
-    reco_tool::HistogramMap histogramMap;
-
-    // Compute the morphological filter vectors
-    fWaveformTool->getErosionDilationAverageDifference(waveform,
-                                                       fStructuringElement,
-                                                       histogramMap,
-                                                       erosionVec,
-                                                       dilationVec,
-                                                       averageVec,
-                                                       differenceVec);
+    fWaveformTool->getDerivativeErosionDilation(
+      waveform, fStructuringElement, derivativeVec, erosionVec, dilationVec);
 
     // Now find the hits
     findHitCandidates(derivativeVec.begin(),
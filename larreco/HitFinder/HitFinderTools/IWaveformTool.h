@@ -110,6 +110,28 @@ namespace reco_tool {
                                                      Waveform<double>&,
                                                      Waveform<double>&) const = 0;
 
+    //< Smoothed first derivative (triangleSmooth of firstDerivative), erosion and dilation of a
+    //< waveform, without the average/difference vectors and without histograms. The default
+    //< calls the separate methods, implementations may compute them in a single pass
+    virtual void getDerivativeErosionDilation(const Waveform<float>& waveform,
+                                              int structuringElement,
+                                              Waveform<float>& derivativeVec,
+                                              Waveform<float>& erosionVec,
+                                              Waveform<float>& dilationVec) const
+    {
+      getDerivativeErosionDilation<float>(
+        waveform, structuringElement, derivativeVec, erosionVec, dilationVec);
+    }
+    virtual void getDerivativeErosionDilation(const Waveform<double>& waveform,
+                                              int structuringElement,
+                                              Waveform<double>& derivativeVec,
+                                              Waveform<double>& erosionVec,
+                                              Waveform<double>& dilationVec) const
+    {
+      getDerivativeErosionDilation<double>(
+        waveform, structuringElement, derivativeVec, erosionVec, dilationVec);
+    }
+
     virtual void getOpeningAndClosing(const Waveform<short>&,       //< Input erosions vector
                                       const Waveform<short>&,       //< Input dilation vector
                                       int,                          //< Structuring element
@@ -128,6 +150,31 @@ namespace reco_tool {
                                       HistogramMap&,                //< Map of histograms to fill
                                       Waveform<double>&,            //< Output closing vector
                                       Waveform<double>&) const = 0; //< Output opening vector
+
+  private:
+    template <typename T>
+    void getDerivativeErosionDilation(const Waveform<T>& waveform,
+                                      int structuringElement,
+                                      Waveform<T>& derivativeVec,
+                                      Waveform<T>& erosionVec,
+                                      Waveform<T>& dilationVec) const
+    {
+      Waveform<T> rawDerivativeVec;
+      Waveform<T> averageVec;
+      Waveform<T> differenceVec;
+      HistogramMap histogramMap;
+
+      derivativeVec.clear();
+      firstDerivative(waveform, rawDerivativeVec);
+      triangleSmooth(rawDerivativeVec, derivativeVec);
+      getErosionDilationAverageDifference(waveform,
+                                          structuringElement,
+                                          histogramMap,
+                                          erosionVec,
+                                          dilationVec,
+                                          averageVec,
+                                          differenceVec);
+    }
   };
 }
 
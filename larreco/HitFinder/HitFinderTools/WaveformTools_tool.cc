@@ -6,11 +6,140 @@
 #include "art/Utilities/ToolMacros.h"
 #include "larreco/HitFinder/HitFinderTools/IWaveformTool.h"
 #include <cmath>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <numeric> // std::inner_product
 
 #include "TProfile.h"
 #include "TVirtualFFT.h"
 
+namespace {
+
+  // The R2C transforms are cached per thread and per size so the FFTW plan is only
+  // made once. TVirtualFFT::FFT goes through the plugin manager and the global
+  // "current transform", so creation is serialized and the new transform is
+  // detached from the global before it is handed back.
+  TVirtualFFT* getR2CTransform(int fftDataSize)
+  {
+    thread_local std::map<int, std::unique_ptr<TVirtualFFT>> transformMap;
+
+    auto& fftr2c = transformMap[fftDataSize];
+
+    if (!fftr2c) {
+      static std::mutex fftMutex;
+      std::lock_guard<std::mutex> lock(fftMutex);
+
+      fftr2c.reset(TVirtualFFT::FFT(1, &fftDataSize, "R2C"));
+      TVirtualFFT::SetTransform(nullptr);
+    }
+
+    return fftr2c.get();
+  }
+
+  // Running extremum over the window [i - halfWindowSize + 1, i + halfWindowSize] using a
+  // monotonic wedge of indices, which is O(n) for any structuring element. Near the end of
+  // the waveform, where the window would run off the vector, the last value is held as in
+  // the original incremental implementation. Requires 0 < halfWindowSize < input.size().
+  template <typename T, typename Compare>
+  void runningExtremum(const std::vector<T>& input,
+                       int halfWindowSize,
+                       Compare better,
+                       std::vector<T>& output)
+  {
+    thread_local std::vector<size_t> wedge;
+
+    size_t nBins = input.size();
+    size_t halfWindow = halfWindowSize;
+
+    wedge.resize(nBins);
+    output.resize(nBins);
+
+    size_t head(0);
+    size_t tail(0);
+
+    auto push = [&](size_t idx) {
+      while (tail > head && !better(input[wedge[tail - 1]], input[idx]))
+        tail--;
+      wedge[tail++] = idx;
+    };
+
+    for (size_t idx = 0; idx < halfWindow; idx++)
+      push(idx);
+
+    size_t lastFull = nBins - halfWindow - 1;
+
+    for (size_t idx = 0; idx <= lastFull; idx++) {
+      push(idx + halfWindow);
+
+      while (wedge[head] + halfWindow <= idx)
+        head++;
+
+      output[idx] = input[wedge[head]];
+    }
+
+    std::fill(output.begin() + lastFull + 1, output.end(), output[lastFull]);
+  }
+
+  // The first derivative, erosion and dilation in a single sweep over the input: the derivative
+  // as in firstDerivative and the running min/max as in runningExtremum, which it equals bin by
+  // bin. Requires 0 < halfWindowSize < input.size().
+  template <typename T>
+  void derivativeAndRunningMinMax(const std::vector<T>& input,
+                                  int halfWindowSize,
+                                  std::vector<T>& derivative,
+                                  std::vector<T>& erosion,
+                                  std::vector<T>& dilation)
+  {
+    thread_local std::vector<size_t> minWedge;
+    thread_local std::vector<size_t> maxWedge;
+
+    size_t nBins = input.size();
+    size_t halfWindow = halfWindowSize;
+
+    derivative.resize(nBins);
+    erosion.resize(nBins);
+    dilation.resize(nBins);
+    minWedge.resize(nBins);
+    maxWedge.resize(nBins);
+
+    size_t minHead(0), minTail(0);
+    size_t maxHead(0), maxTail(0);
+
+    for (size_t idx = 0; idx < nBins; idx++) {
+      derivative[idx] = (idx > 0 && idx + 1 < nBins) ? 0.5 * (input[idx + 1] - input[idx - 1]) : 0.;
+
+      while (minTail > minHead && !(input[minWedge[minTail - 1]] < input[idx]))
+        minTail--;
+      minWedge[minTail++] = idx;
+
+      while (maxTail > maxHead && !(input[maxWedge[maxTail - 1]] > input[idx]))
+        maxTail--;
+      maxWedge[maxTail++] = idx;
+
+      // the window [bin - halfWindow + 1, bin + halfWindow] of this bin is complete
+      if (idx < halfWindow) continue;
+
+      size_t bin = idx - halfWindow;
+
+      while (minWedge[minHead] + halfWindow <= bin)
+        minHead++;
+      while (maxWedge[maxHead] + halfWindow <= bin)
+        maxHead++;
+
+      erosion[bin] = input[minWedge[minHead]];
+      dilation[bin] = input[maxWedge[maxHead]];
+    }
+
+    size_t lastFull = nBins - halfWindow - 1;
+
+    std::fill(erosion.begin() + lastFull + 1, erosion.end(), erosion[lastFull]);
+    std::fill(dilation.begin() + lastFull + 1, dilation.end(), dilation[lastFull]);
+  }
+
+}
+
 namespace reco_tool {
 
   class WaveformTools : IWaveformTool {
@@ -79,6 +208,17 @@ namespace reco_tool {
                                              Waveform<double>&,
                                              Waveform<double>&) const override;
 
+    void getDerivativeErosionDilation(const Waveform<float>&,
+                                      int,
+                                      Waveform<float>&,
+                                      Waveform<float>&,
+                                      Waveform<float>&) const override;
+    void getDerivativeErosionDilation(const Waveform<double>&,
+                                      int,
+                                      Waveform<double>&,
+                                      Waveform<double>&,
+                                      Waveform<double>&) const override;
+
     void getOpeningAndClosing(const Waveform<short>&,
                               const Waveform<short>&,
                               int,
@@ -123,6 +263,13 @@ namespace reco_tool {
                                              Waveform<T>&,
                                              Waveform<T>&) const;
 
+    template <typename T>
+    void getDerivativeErosionDilation(const Waveform<T>&,
+                                      int,
+                                      Waveform<T>&,
+                                      Waveform<T>&,
+                                      Waveform<T>&) const;
+
     template <typename T>
     void getOpeningAndClosing(const Waveform<T>&,
                               const Waveform<T>&,
@@ -477,8 +624,10 @@ namespace reco_tool {
   void WaveformTools::getFFTPower(const std::vector<float>& inputVec,
                                   std::vector<float>& outputPowerVec) const
   {
-    std::vector<double> inputDoubleVec(inputVec.size());
-    std::vector<double> outputDoubleVec(inputVec.size() / 2);
+    thread_local std::vector<double> inputDoubleVec;
+    thread_local std::vector<double> outputDoubleVec;
+
+    inputDoubleVec.resize(inputVec.size());
 
     std::copy(inputVec.begin(), inputVec.end(), inputDoubleVec.begin());
 
@@ -498,7 +647,7 @@ namespace reco_tool {
     // Get the FFT of the response
     int fftDataSize = inputVec.size();
 
-    TVirtualFFT* fftr2c = TVirtualFFT::FFT(1, &fftDataSize, "R2C");
+    TVirtualFFT* fftr2c = getR2CTransform(fftDataSize);
 
     fftr2c->SetPoints(inputVec.data());
     fftr2c->Transform();
@@ -506,8 +655,11 @@ namespace reco_tool {
     // Recover the results so we can compute the power spectrum
     size_t halfFFTDataSize(fftDataSize / 2 + 1);
 
-    std::vector<double> realVals(halfFFTDataSize);
-    std::vector<double> imaginaryVals(halfFFTDataSize);
+    thread_local std::vector<double> realVals;
+    thread_local std::vector<double> imaginaryVals;
+
+    realVals.resize(halfFFTDataSize);
+    imaginaryVals.resize(halfFFTDataSize);
 
     fftr2c->GetPointsComplex(realVals.data(), imaginaryVals.data());
 
@@ -593,6 +745,34 @@ namespace reco_tool {
     // Set the window size
     int halfWindowSize(structuringElement / 2);
 
+    // Use the linear time running min/max unless the window is degenerate
+    if (halfWindowSize > 0 && size_t(halfWindowSize) < inputWaveform.size()) {
+      runningExtremum(inputWaveform, halfWindowSize, std::less<T>(), erosionVec);
+      runningExtremum(inputWaveform, halfWindowSize, std::greater<T>(), dilationVec);
+
+      averageVec.resize(inputWaveform.size());
+      differenceVec.resize(inputWaveform.size());
+
+      for (size_t idx = 0; idx < inputWaveform.size(); idx++) {
+        averageVec[idx] = 0.5 * (dilationVec[idx] + erosionVec[idx]);
+        differenceVec[idx] = dilationVec[idx] - erosionVec[idx];
+      }
+
+      if (!histogramMap.empty()) {
+        for (size_t idx = 0; idx < inputWaveform.size(); idx++) {
+          int curBin = idx;
+
+          histogramMap.at(WAVEFORM)->Fill(curBin, inputWaveform[idx]);
+          histogramMap.at(EROSION)->Fill(curBin, erosionVec[idx]);
+          histogramMap.at(DILATION)->Fill(curBin, dilationVec[idx]);
+          histogramMap.at(AVERAGE)->Fill(curBin, 0.5 * (dilationVec[idx] + erosionVec[idx]));
+          histogramMap.at(DIFFERENCE)->Fill(curBin, dilationVec[idx] - erosionVec[idx]);
+        }
+      }
+
+      return;
+    }
+
     // Initialize min and max elements
     std::pair<typename Waveform<T>::const_iterator, typename Waveform<T>::const_iterator>
       minMaxItr =
@@ -655,6 +835,70 @@ namespace reco_tool {
     return;
   }
 
+  void WaveformTools::getDerivativeErosionDilation(const Waveform<float>& waveform,
+                                                   int structuringElement,
+                                                   Waveform<float>& derivativeVec,
+                                                   Waveform<float>& erosionVec,
+                                                   Waveform<float>& dilationVec) const
+  {
+    getDerivativeErosionDilation<float>(
+      waveform, structuringElement, derivativeVec, erosionVec, dilationVec);
+
+    return;
+  }
+
+  void WaveformTools::getDerivativeErosionDilation(const Waveform<double>& waveform,
+                                                   int structuringElement,
+                                                   Waveform<double>& derivativeVec,
+                                                   Waveform<double>& erosionVec,
+                                                   Waveform<double>& dilationVec) const
+  {
+    getDerivativeErosionDilation<double>(
+      waveform, structuringElement, derivativeVec, erosionVec, dilationVec);
+
+    return;
+  }
+
+  template <typename T>
+  void WaveformTools::getDerivativeErosionDilation(const Waveform<T>& inputWaveform,
+                                                   int structuringElement,
+                                                   Waveform<T>& derivativeVec,
+                                                   Waveform<T>& erosionVec,
+                                                   Waveform<T>& dilationVec) const
+  {
+    // The raw derivative is kept per thread and reused from call to call
+    thread_local Waveform<T> rawDerivativeVec;
+
+    // Set the window size
+    int halfWindowSize(structuringElement / 2);
+
+    if (halfWindowSize > 0 && size_t(halfWindowSize) < inputWaveform.size())
+      derivativeAndRunningMinMax(
+        inputWaveform, halfWindowSize, rawDerivativeVec, erosionVec, dilationVec);
+    else {
+      // Degenerate windows go through the general erosion/dilation
+      Waveform<T> averageVec;
+      Waveform<T> differenceVec;
+      HistogramMap histogramMap;
+
+      rawDerivativeVec.clear();
+      firstDerivative<T>(inputWaveform, rawDerivativeVec);
+      getErosionDilationAverageDifference<T>(inputWaveform,
+                                             structuringElement,
+                                             histogramMap,
+                                             erosionVec,
+                                             dilationVec,
+                                             averageVec,
+                                             differenceVec);
+    }
+
+    // triangleSmooth leaves waveforms of up to four bins untouched, as in a new vector
+    derivativeVec.clear();
+    triangleSmooth<T>(rawDerivativeVec, derivativeVec);
+
+    return;
+  }
+
   void WaveformTools::getOpeningAndClosing(const Waveform<short>& erosionVec,
                                            const Waveform<short>& dilationVec,
                                            int structuringElement,
@@ -705,6 +949,25 @@ namespace reco_tool {
     // Set the window size
     int halfWindowSize(structuringElement / 2);
 
+    // Use the linear time running min/max unless the window is degenerate
+    if (halfWindowSize > 0 && size_t(halfWindowSize) < erosionVec.size() &&
+        size_t(halfWindowSize) < dilationVec.size()) {
+      runningExtremum(erosionVec, halfWindowSize, std::greater<T>(), openingVec);
+      runningExtremum(dilationVec, halfWindowSize, std::less<T>(), closingVec);
+
+      if (!histogramMap.empty()) {
+        for (size_t idx = 0; idx < openingVec.size(); idx++)
+          histogramMap.at(OPENING)->Fill(int(idx), openingVec[idx]);
+
+        for (size_t idx = 0; idx < closingVec.size(); idx++) {
+          histogramMap.at(CLOSING)->Fill(int(idx), closingVec[idx]);
+          histogramMap.at(DOPENCLOSING)->Fill(int(idx), closingVec[idx] - openingVec.at(idx));
+        }
+      }
+
+      return;
+    }
+
     // Start with the opening, here we get the max element in the input erosion vector
     typename Waveform<T>::const_iterator maxElementItr =
       std::max_element(erosionVec.begin(), erosionVec.begin() + halfWindowSize);
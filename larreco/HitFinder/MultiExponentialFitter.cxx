@@ -0,0 +1,307 @@
+/*!
+ * Title:   MultiExponentialFitter Class
+ *
+ * Description:
+ * Least squares fit of a sum of exponential pulses, see the header for the
+ * model and the parameter layout.
+*/
+
+#include "MultiExponentialFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+  // one pulse normalised to unit amplitude, g = exp(a) / (1 + exp(b)), and the
+  // logistic factor s = exp(b) / (1 + exp(b)) entering its derivatives; the
+  // log form keeps steep edges from overflowing
+  struct PulseTerms {
+    double g;
+    double s;
+    double a;
+    double b;
+  };
+
+  inline PulseTerms pulse(double dx, double tau1, double tau2)
+  {
+    double const a = 0.4 * dx / tau1;
+    double const b = 0.4 * dx / tau2;
+    double softplus, s;
+    if (b > 0) {
+      double const e = std::exp(-b);
+      softplus = b + std::log1p(e);
+      s = 1. / (1. + e);
+    }
+    else {
+      double const e = std::exp(b);
+      softplus = std::log1p(e);
+      s = e / (1. + e);
+    }
+    return {std::exp(a - softplus), s, a, b};
+  }
+
+  // in place Cholesky decomposition of the n x n row-major matrix m (stride
+  // n), the lower triangle is overwritten by L
+  bool choleskyDecompose(double* m, std::size_t n)
+  {
+    for (std::size_t j = 0; j < n; ++j) {
+      double d = m[j * n + j];
+      for (std::size_t k = 0; k < j; ++k)
+        d -= m[j * n + k] * m[j * n + k];
+      if (!(d > 0)) return false;
+      d = std::sqrt(d);
+      m[j * n + j] = d;
+      for (std::size_t i = j + 1; i < n; ++i) {
+        double v = m[i * n + j];
+        for (std::size_t k = 0; k < j; ++k)
+          v -= m[i * n + k] * m[j * n + k];
+        m[i * n + j] = v / d;
+      }
+    }
+    return true;
+  }
+
+  // solves L L^T x = b in place
+  void choleskySolve(const double* l, std::size_t n, double* x)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      double v = x[i];
+      for (std::size_t k = 0; k < i; ++k)
+        v -= l[i * n + k] * x[k];
+      x[i] = v / l[i * n + i];
+    }
+    for (std::size_t i = n; i-- > 0;) {
+      double v = x[i];
+      for (std::size_t k = i + 1; k < n; ++k)
+        v -= l[k * n + i] * x[k];
+      x[i] = v / l[i * n + i];
+    }
+  }
+
+}
+
+hit::MultiExponentialFitter::MultiExponentialFitter(unsigned int maxIterations, double tolerance)
+  : fMaxIterations(maxIterations)
+  , fTolerance(tolerance)
+  , fNPeaks(0)
+  , fNParams(0)
+  , fSameShape(false)
+  , fChi2(0)
+  , fNDF(0)
+{}
+
+bool hit::MultiExponentialFitter::SetNPeaks(std::size_t nPeaks, bool sameShape)
+{
+  std::size_t const nParams = sameShape ? 2 + 2 * nPeaks : 4 * nPeaks;
+  if (nPeaks == 0 || nParams > kMaxParams) return false;
+
+  fNPeaks = nPeaks;
+  fNParams = nParams;
+  fSameShape = sameShape;
+  std::fill_n(fParams.begin(), fNParams, 0.);
+  std::fill_n(fErrors.begin(), fNParams, 0.);
+  return true;
+}
+
+void hit::MultiExponentialFitter::SetParameter(std::size_t i, double seed, double low, double high)
+{
+  fParams[i] = seed;
+  fLow[i] = low;
+  fHigh[i] = high;
+}
+
+double hit::MultiExponentialFitter::Evaluate(double x,
+                                             const double* params,
+                                             std::size_t nPeaks,
+                                             bool sameShape)
+{
+  double value = 0;
+  for (std::size_t p = 0; p < nPeaks; ++p) {
+    std::size_t const first = sameShape ? 2 * p : 4 * p;
+    double const tau1 = sameShape ? params[0] : params[first];
+    double const tau2 = sameShape ? params[1] : params[first + 1];
+    value += params[first + 2] * pulse(x - params[first + 3], tau1, tau2).g;
+  }
+  return value;
+}
+
+std::string hit::MultiExponentialFitter::Formula(std::size_t nPeaks, bool sameShape)
+{
+  std::ostringstream eqn;
+  for (std::size_t p = 0; p < nPeaks; ++p) {
+    std::size_t const first = sameShape ? 2 * p : 4 * p;
+    std::size_t const tau1 = sameShape ? 0 : first;
+    std::size_t const tau2 = sameShape ? 1 : first + 1;
+    eqn << "+( [" << first + 2 << "] * exp(0.4*(x-[" << first + 3 << "])/[" << tau1
+        << "]) / ( 1 + exp(0.4*(x-[" << first + 3 << "])/[" << tau2 << "]) ) )";
+  }
+  return eqn.str();
+}
+
+double hit::MultiExponentialFitter::Chisquare(const std::vector<float>& signal,
+                                              int startTime,
+                                              int endTime,
+                                              const double* params) const
+{
+  double chi2 = 0;
+  for (int i = startTime; i <= endTime; ++i) {
+    if (signal[i] == 0) continue;
+    double const r = signal[i] - Evaluate(i + 0.5, params, fNPeaks, fSameShape);
+    chi2 += r * r;
+  }
+  return chi2;
+}
+
+double hit::MultiExponentialFitter::BuildNormalEquations(const std::vector<float>& signal,
+                                                         int startTime,
+                                                         int endTime)
+{
+  std::size_t const n = fNParams;
+  std::fill_n(fAlpha.begin(), n * n, 0.);
+  std::fill_n(fBeta.begin(), n, 0.);
+
+  double chi2 = 0;
+  for (int i = startTime; i <= endTime; ++i) {
+    if (signal[i] == 0) continue;
+
+    double const x = i + 0.5;
+    double value = 0;
+    std::fill_n(fDeriv.begin(), n, 0.);
+    for (std::size_t p = 0; p < fNPeaks; ++p) {
+      std::size_t const first = fSameShape ? 2 * p : 4 * p;
+      std::size_t const iTau1 = fSameShape ? 0 : first;
+      std::size_t const iTau2 = fSameShape ? 1 : first + 1;
+      double const tau1 = fParams[iTau1];
+      double const tau2 = fParams[iTau2];
+      double const amp = fParams[first + 2];
+
+      PulseTerms const t = pulse(x - fParams[first + 3], tau1, tau2);
+      double const f = amp * t.g;
+      value += f;
+      fDeriv[iTau1] += -f * t.a / tau1;
+      fDeriv[iTau2] += f * t.b * t.s / tau2;
+      fDeriv[first + 2] = t.g;
+      fDeriv[first + 3] = f * 0.4 * (t.s / tau2 - 1. / tau1);
+    }
+
+    double const r = signal[i] - value;
+    chi2 += r * r;
+    for (std::size_t j = 0; j < n; ++j) {
+      fBeta[j] += r * fDeriv[j];
+      for (std::size_t k = 0; k <= j; ++k)
+        fAlpha[j * n + k] += fDeriv[j] * fDeriv[k];
+    }
+  }
+  return chi2;
+}
+
+bool hit::MultiExponentialFitter::Solve(std::size_t n, double lambda)
+{
+  // a parameter on its bound with the gradient pointing outwards stays there
+  std::size_t m = 0;
+  for (std::size_t k = 0; k < n; ++k) {
+    if (IsFixed(k) || fAlpha[k * n + k] <= 0) continue;
+    if (fParams[k] <= fLow[k] && fBeta[k] < 0) continue;
+    if (fParams[k] >= fHigh[k] && fBeta[k] > 0) continue;
+    fFree[m++] = k;
+  }
+  std::fill_n(fStep.begin(), n, 0.);
+  if (m == 0) return false;
+
+  for (std::size_t i = 0; i < m; ++i) {
+    for (std::size_t j = 0; j <= i; ++j)
+      fWork[i * m + j] = fAlpha[fFree[i] * n + fFree[j]];
+    fWork[i * m + i] *= 1. + lambda;
+    fTrial[i] = fBeta[fFree[i]];
+  }
+  if (!choleskyDecompose(fWork.data(), m)) return false;
+  choleskySolve(fWork.data(), m, fTrial.data());
+
+  for (std::size_t i = 0; i < m; ++i)
+    fStep[fFree[i]] = fTrial[i];
+  return true;
+}
+
+void hit::MultiExponentialFitter::ComputeErrors()
+{
+  std::size_t const n = fNParams;
+  std::fill_n(fErrors.begin(), n, 0.);
+
+  std::size_t m = 0;
+  for (std::size_t k = 0; k < n; ++k)
+    if (!IsFixed(k)) fFree[m++] = k;
+
+  for (std::size_t i = 0; i < m; ++i)
+    for (std::size_t j = 0; j <= i; ++j)
+      fWork[i * m + j] = fAlpha[fFree[i] * n + fFree[j]];
+  if (!choleskyDecompose(fWork.data(), m)) return;
+
+  // diagonal of the inverse, (A^-1)_kk = |L^-1 e_k|^2
+  for (std::size_t k = 0; k < m; ++k) {
+    double sum2 = 0;
+    std::fill_n(fTrial.begin(), m, 0.);
+    fTrial[k] = 1.;
+    for (std::size_t i = k; i < m; ++i) {
+      double v = fTrial[i];
+      for (std::size_t j = k; j < i; ++j)
+        v -= fWork[i * m + j] * fTrial[j];
+      fTrial[i] = v / fWork[i * m + i];
+      sum2 += fTrial[i] * fTrial[i];
+    }
+    fErrors[fFree[k]] = std::sqrt(sum2);
+  }
+}
+
+bool hit::MultiExponentialFitter::Fit(const std::vector<float>& signal, int startTime, int endTime)
+{
+  std::size_t const n = fNParams;
+  if (n == 0 || startTime < 0 || endTime < startTime || endTime >= int(signal.size()))
+    return false;
+
+  int nPoints = 0;
+  for (int i = startTime; i <= endTime; ++i)
+    if (signal[i] != 0) ++nPoints;
+  fNDF = nPoints;
+
+  for (std::size_t k = 0; k < n; ++k) {
+    if (IsFixed(k)) continue;
+    fParams[k] = std::clamp(fParams[k], fLow[k], fHigh[k]);
+    --fNDF;
+  }
+
+  double chi2 = BuildNormalEquations(signal, startTime, endTime);
+  if (!std::isfinite(chi2)) return false;
+
+  double lambda = 1e-3;
+  for (unsigned int iter = 0; iter < fMaxIterations; ++iter) {
+    std::array<double, kMaxParams> trial;
+    double chi2Trial = chi2;
+    bool improved = false;
+    while (lambda < 1e10) {
+      if (Solve(n, lambda)) {
+        for (std::size_t k = 0; k < n; ++k)
+          trial[k] = IsFixed(k) ? fParams[k] :
+                                  std::clamp(fParams[k] + fStep[k], fLow[k], fHigh[k]);
+        chi2Trial = Chisquare(signal, startTime, endTime, trial.data());
+        if (chi2Trial < chi2) {
+          improved = true;
+          break;
+        }
+      }
+      lambda *= 10;
+    }
+    if (!improved) break;
+
+    double const decrease = chi2 - chi2Trial;
+    std::copy_n(trial.begin(), n, fParams.begin());
+    lambda = std::max(0.1 * lambda, 1e-12);
+    chi2 = BuildNormalEquations(signal, startTime, endTime);
+    if (decrease <= fTolerance * (chi2 + fTolerance)) break;
+  }
+
+  fChi2 = chi2;
+  ComputeErrors();
+  return true;
+}
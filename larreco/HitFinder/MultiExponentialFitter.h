@@ -0,0 +1,109 @@
+#ifndef MULTIEXPONENTIALFITTER_H
+#define MULTIEXPONENTIALFITTER_H
+
+/*!
+ * Title:   MultiExponentialFitter Class
+ *
+ * Description:
+ * Least squares fit of a sum of pulses
+ *
+ *   A * exp(0.4*(x-t0)/tau1) / (1 + exp(0.4*(x-t0)/tau2))
+ *
+ * to a range of a signal vector, as used by DPRawHitFinder. The parameter
+ * layout follows the TF1 formula built by the hit finder: with a common shape
+ * the parameters are (tau1, tau2, A_0, t0_0, A_1, t0_1, ...), otherwise each
+ * pulse has (tau1, tau2, A, t0). All parameters are bounded; as in a ROOT fit,
+ * a parameter whose lower limit is not below the upper one is fixed.
+ *
+ * The fit is a Levenberg-Marquardt minimisation with analytic derivatives;
+ * parameters sitting on a bound and pushed outwards are frozen for the step.
+ * Bins are at tick + 0.5, unit weights are used and empty bins are skipped,
+ * like the "W" option of a ROOT histogram fit. Parameter storage has a fixed
+ * capacity and an instance keeps no shared state, so separate instances can
+ * be used from separate threads.
+ *
+ * Input:  Signal (vector of floats), tick range, seeds and limits
+ * Output: Parameters, errors, chi2 and NDF
+*/
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace hit {
+
+  class MultiExponentialFitter {
+
+  public:
+    static constexpr std::size_t kMaxPeaks = 20;
+    static constexpr std::size_t kMaxParams = 4 * kMaxPeaks;
+
+    MultiExponentialFitter(unsigned int maxIterations = 500, double tolerance = 1e-9);
+
+    /// Sets the number of pulses; returns false if it exceeds the capacity.
+    bool SetNPeaks(std::size_t nPeaks, bool sameShape);
+
+    std::size_t NPeaks() const { return fNPeaks; }
+    std::size_t NParams() const { return fNParams; }
+
+    void SetParameter(std::size_t i, double seed, double low, double high);
+    void GetParLimits(std::size_t i, double& low, double& high) const
+    {
+      low = fLow[i];
+      high = fHigh[i];
+    }
+
+    /// Fits ticks [startTime, endTime]; returns false if the fit could not run.
+    bool Fit(const std::vector<float>& signal, int startTime, int endTime);
+
+    double GetParameter(std::size_t i) const { return fParams[i]; }
+    double GetParError(std::size_t i) const { return fErrors[i]; }
+    double GetChisquare() const { return fChi2; }
+    int GetNDF() const { return fNDF; }
+
+    /// Value of the pulse sum at x for the parameters in the layout above.
+    static double Evaluate(double x, const double* params, std::size_t nPeaks, bool sameShape);
+
+    /// TF1 formula of the pulse sum, with the parameters in the layout above.
+    static std::string Formula(std::size_t nPeaks, bool sameShape);
+
+  private:
+    unsigned int fMaxIterations;
+    double fTolerance;
+
+    std::size_t fNPeaks;
+    std::size_t fNParams;
+    bool fSameShape;
+
+    std::array<double, kMaxParams> fParams;
+    std::array<double, kMaxParams> fLow;
+    std::array<double, kMaxParams> fHigh;
+    std::array<double, kMaxParams> fErrors;
+
+    double fChi2;
+    int fNDF;
+
+    // normal equations and scratch for the minimisation
+    std::array<double, kMaxParams * kMaxParams> fAlpha;
+    std::array<double, kMaxParams * kMaxParams> fWork;
+    std::array<double, kMaxParams> fBeta;
+    std::array<double, kMaxParams> fDeriv;
+    std::array<double, kMaxParams> fStep;
+    std::array<double, kMaxParams> fTrial;
+    std::array<std::size_t, kMaxParams> fFree;
+
+    bool IsFixed(std::size_t i) const { return !(fLow[i] < fHigh[i]); }
+
+    double Chisquare(const std::vector<float>& signal,
+                     int startTime,
+                     int endTime,
+                     const double* params) const;
+    double BuildNormalEquations(const std::vector<float>& signal, int startTime, int endTime);
+    bool Solve(std::size_t n, double lambda);
+    void ComputeErrors();
+  };
+
+}
+
+#endif
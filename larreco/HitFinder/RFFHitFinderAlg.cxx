@@ -16,8 +16,13 @@
 
 #include "RFFHitFinderAlg.h"
 
+#include <algorithm>
+#include <iterator>
 #include <numeric>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 hit::RFFHitFinderAlg::RFFHitFinderAlg(fhicl::ParameterSet const& p)
 {
   fMatchThresholdVec = p.get<std::vector<float>>("MeanMatchThreshold");
@@ -49,74 +54,95 @@ void hit::RFFHitFinderAlg::SetFitterParamsVectors(geo::Geometry const& geo)
   if (fAmpThresholdVec.size() == 1) fAmpThresholdVec.resize(n_planes, fAmpThresholdVec[0]);
 }
 
-void hit::RFFHitFinderAlg::SetFitterParams(unsigned int p)
+void hit::RFFHitFinderAlg::SetFitterParams(RFFHitFitter& fitter, unsigned int p) const
 {
-  fFitter.SetFitterParams(fMatchThresholdVec[p], fMergeMultiplicityVec[p], fAmpThresholdVec[p]);
+  fitter.SetFitterParams(fMatchThresholdVec[p], fMergeMultiplicityVec[p], fAmpThresholdVec[p]);
 }
 
 void hit::RFFHitFinderAlg::Run(std::vector<recob::Wire> const& wireVector,
                                std::vector<recob::Hit>& hitVector,
                                geo::Geometry const& geo)
 {
-  hitVector.reserve(wireVector.size());
-  for (auto const& wire : wireVector) {
-    geo::SigType_t const& sigtype = geo.SignalType(wire.Channel());
-    geo::WireID const wireID = geo.ChannelToWire(wire.Channel()).at(0);
+  //each wire gets its own output so the final ordering does not depend on scheduling
+  std::vector<std::vector<recob::Hit>> wireHitVectors(wireVector.size());
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, wireVector.size()),
+                    [&](tbb::blocked_range<size_t> const& range) {
+                      RFFHitFitter& fitter = fFitters.local();
+                      for (size_t iwire = range.begin(); iwire != range.end(); ++iwire)
+                        RunWire(wireVector[iwire], wireHitVectors[iwire], geo, fitter);
+                    });
+
+  size_t nHits = 0;
+  for (auto const& wireHits : wireHitVectors)
+    nHits += wireHits.size();
+
+  hitVector.reserve(hitVector.size() + nHits);
+  for (auto& wireHits : wireHitVectors)
+    std::move(wireHits.begin(), wireHits.end(), std::back_inserter(hitVector));
+}
 
-    SetFitterParams(wire.View());
+void hit::RFFHitFinderAlg::RunWire(recob::Wire const& wire,
+                                   std::vector<recob::Hit>& hitVector,
+                                   geo::Geometry const& geo,
+                                   RFFHitFitter& fitter) const
+{
+  geo::SigType_t const& sigtype = geo.SignalType(wire.Channel());
+  geo::WireID const wireID = geo.ChannelToWire(wire.Channel()).at(0);
 
-    for (auto const& roi : wire.SignalROI().get_ranges()) {
-      fFitter.RunFitter(roi.data());
+  SetFitterParams(fitter, wire.View());
 
-      const float summedADCTotal = std::accumulate(roi.data().begin(), roi.data().end(), 0.0);
-      const raw::TDCtick_t startTick = roi.begin_index();
-      const raw::TDCtick_t endTick = roi.begin_index() + roi.size();
+  for (auto const& roi : wire.SignalROI().get_ranges()) {
+    fitter.RunFitter(roi.data());
 
-      EmplaceHit(hitVector, wire, summedADCTotal, startTick, endTick, sigtype, wireID);
-    } //end loop over ROIs on wire
+    const float summedADCTotal = std::accumulate(roi.data().begin(), roi.data().end(), 0.0);
+    const raw::TDCtick_t startTick = roi.begin_index();
+    const raw::TDCtick_t endTick = roi.begin_index() + roi.size();
 
-  } //end loop over wires
+    EmplaceHit(fitter, hitVector, wire, summedADCTotal, startTick, endTick, sigtype, wireID);
+  } //end loop over ROIs on wire
 }
 
-void hit::RFFHitFinderAlg::EmplaceHit(std::vector<recob::Hit>& hitVector,
+void hit::RFFHitFinderAlg::EmplaceHit(RFFHitFitter& fitter,
+                                      std::vector<recob::Hit>& hitVector,
                                       recob::Wire const& wire,
                                       float const& summedADCTotal,
                                       raw::TDCtick_t const& startTick,
                                       raw::TDCtick_t const& endTick,
                                       geo::SigType_t const& sigtype,
-                                      geo::WireID const& wireID)
+                                      geo::WireID const& wireID) const
 {
 
   float totalArea = 0.0;
-  std::vector<float> areaVector(fFitter.NHits());
-  std::vector<float> areaErrorVector(fFitter.NHits());
-  std::vector<float> areaFracVector(fFitter.NHits());
+  std::vector<float> areaVector(fitter.NHits());
+  std::vector<float> areaErrorVector(fitter.NHits());
+  std::vector<float> areaFracVector(fitter.NHits());
 
-  for (size_t ihit = 0; ihit < fFitter.NHits(); ihit++) {
-    areaVector[ihit] = fFitter.AmplitudeVector()[ihit] * fFitter.SigmaVector()[ihit] * SQRT_TWO_PI;
+  for (size_t ihit = 0; ihit < fitter.NHits(); ihit++) {
+    areaVector[ihit] = fitter.AmplitudeVector()[ihit] * fitter.SigmaVector()[ihit] * SQRT_TWO_PI;
     areaErrorVector[ihit] =
-      SQRT_TWO_PI * std::sqrt(fFitter.AmplitudeVector()[ihit] * fFitter.SigmaErrorVector()[ihit] *
-                                fFitter.AmplitudeVector()[ihit] * fFitter.SigmaErrorVector()[ihit] +
-                              fFitter.AmplitudeErrorVector()[ihit] * fFitter.SigmaVector()[ihit] *
-                                fFitter.AmplitudeErrorVector()[ihit] * fFitter.SigmaVector()[ihit]);
+      SQRT_TWO_PI * std::sqrt(fitter.AmplitudeVector()[ihit] * fitter.SigmaErrorVector()[ihit] *
+                                fitter.AmplitudeVector()[ihit] * fitter.SigmaErrorVector()[ihit] +
+                              fitter.AmplitudeErrorVector()[ihit] * fitter.SigmaVector()[ihit] *
+                                fitter.AmplitudeErrorVector()[ihit] * fitter.SigmaVector()[ihit]);
     totalArea += areaVector[ihit];
   }
 
-  for (size_t ihit = 0; ihit < fFitter.NHits(); ihit++) {
+  for (size_t ihit = 0; ihit < fitter.NHits(); ihit++) {
     areaFracVector[ihit] = areaVector[ihit] / totalArea;
 
     hitVector.emplace_back(wire.Channel(),
                            startTick,
                            endTick,
-                           fFitter.MeanVector()[ihit] + (float)startTick,
-                           fFitter.MeanErrorVector()[ihit],
-                           fFitter.SigmaVector()[ihit],
-                           fFitter.AmplitudeVector()[ihit],
-                           fFitter.AmplitudeErrorVector()[ihit],
+                           fitter.MeanVector()[ihit] + (float)startTick,
+                           fitter.MeanErrorVector()[ihit],
+                           fitter.SigmaVector()[ihit],
+                           fitter.AmplitudeVector()[ihit],
+                           fitter.AmplitudeErrorVector()[ihit],
                            summedADCTotal * areaFracVector[ihit],
                            areaVector[ihit],
                            areaErrorVector[ihit],
-                           fFitter.NHits(),
+                           fitter.NHits(),
                            ihit,
                            -999.,
                            -999,
@@ -23,6 +23,8 @@
 
 #include "RFFHitFitter.h"
 
+#include "tbb/enumerable_thread_specific.h"
+
 namespace fhicl {
   class ParameterSet;
 }
@@ -40,6 +42,8 @@ namespace hit {
     RFFHitFinderAlg(fhicl::ParameterSet const&);
 
     void SetFitterParamsVectors(geo::Geometry const&);
+
+    //wires are fitted in parallel; hits come out in wire order
     void Run(std::vector<recob::Wire> const&, std::vector<recob::Hit>&, geo::Geometry const&);
 
   private:
@@ -47,17 +51,25 @@ namespace hit {
     std::vector<unsigned int> fMergeMultiplicityVec;
     std::vector<float> fAmpThresholdVec;
 
-    void SetFitterParams(unsigned int);
+    //one fitter (and its lookup table) per thread, reused across wires and events
+    tbb::enumerable_thread_specific<RFFHitFitter> fFitters;
+
+    void SetFitterParams(RFFHitFitter&, unsigned int) const;
 
-    void EmplaceHit(std::vector<recob::Hit>&,
+    //fit all ROIs on one wire
+    void RunWire(recob::Wire const&,
+                 std::vector<recob::Hit>&,
+                 geo::Geometry const&,
+                 RFFHitFitter&) const;
+
+    void EmplaceHit(RFFHitFitter&,
+                    std::vector<recob::Hit>&,
                     recob::Wire const&,
                     float const&,
                     raw::TDCtick_t const&,
                     raw::TDCtick_t const&,
                     geo::SigType_t const&,
-                    geo::WireID const&);
-
-    RFFHitFitter fFitter;
+                    geo::WireID const&) const;
   };
 
 }
@@ -14,6 +14,7 @@
 
 #include "RFFHitFitter.h"
 #include "cetlib_except/exception.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -73,46 +74,56 @@ void hit::RFFHitFitter::CalculateAllMeansAndSigmas(const std::vector<float>& sig
     intercept = 0.5 * (signal[i_tick + 1] - signal[i_tick - 1]) / signal[i_tick] - slope * i_tick;
     mean = -1 * intercept / slope;
 
-    fSignalSet.insert(std::make_pair(mean, sigma));
+    fSignalVector.emplace_back(mean, sigma);
   }
+
+  //stable sort keeps equal means in insertion order, as the multiset used to
+  std::stable_sort(fSignalVector.begin(), fSignalVector.end(), SignalSetComp());
 }
 
 void hit::RFFHitFitter::CreateMergeVector()
 {
   fMergeVector.clear();
-  fMergeVector.reserve(fSignalSet.size());
+  fMergeVector.reserve(fSignalVector.size() + 1);
 
   float prev_mean = -9e6;
-  for (std::multiset<MeanSigmaPair>::iterator it = fSignalSet.begin(); it != fSignalSet.end();
-       it++) {
-    if (std::abs(it->first - prev_mean) > fMeanMatchThreshold || fMergeVector.size() == 0)
-      fMergeVector.push_back(std::vector<std::multiset<MeanSigmaPair>::iterator>(1, it));
-    else
-      fMergeVector.back().push_back(it);
-    prev_mean = it->first;
+  for (size_t i_sig = 0; i_sig < fSignalVector.size(); i_sig++) {
+    if (std::abs(fSignalVector[i_sig].first - prev_mean) > fMeanMatchThreshold ||
+        fMergeVector.size() == 0)
+      fMergeVector.push_back(i_sig);
+    prev_mean = fSignalVector[i_sig].first;
   }
+
+  //close the last group
+  fMergeVector.push_back(fSignalVector.size());
 }
 
 void hit::RFFHitFitter::CalculateMergedMeansAndSigmas(size_t signal_size)
 {
-  fMeanVector.reserve(fMergeVector.size());
-  fSigmaVector.reserve(fMergeVector.size());
-  fMeanErrorVector.reserve(fMergeVector.size());
-  fSigmaErrorVector.reserve(fMergeVector.size());
+  const size_t n_groups = fMergeVector.size() - 1;
+
+  fMeanVector.reserve(n_groups);
+  fSigmaVector.reserve(n_groups);
+  fMeanErrorVector.reserve(n_groups);
+  fSigmaErrorVector.reserve(n_groups);
+
+  for (size_t i_col = 0; i_col < n_groups; i_col++) {
+    const auto group_begin = fSignalVector.begin() + fMergeVector[i_col];
+    const auto group_end = fSignalVector.begin() + fMergeVector[i_col + 1];
+    const size_t group_size = fMergeVector[i_col + 1] - fMergeVector[i_col];
 
-  for (size_t i_col = 0; i_col < fMergeVector.size(); i_col++) {
-    if (fMergeVector[i_col].size() < fMinMergeMultiplicity) continue;
+    if (group_size < fMinMergeMultiplicity) continue;
 
     fMeanVector.push_back(0.0);
     fSigmaVector.push_back(0.0);
 
-    for (auto const& sigpair : fMergeVector[i_col]) {
+    for (auto sigpair = group_begin; sigpair != group_end; ++sigpair) {
       fMeanVector.back() += sigpair->first;
       fSigmaVector.back() += sigpair->second;
     }
 
-    fMeanVector.back() /= fMergeVector[i_col].size();
-    fSigmaVector.back() /= fMergeVector[i_col].size();
+    fMeanVector.back() /= group_size;
+    fSigmaVector.back() /= group_size;
 
     if (fMeanVector.back() < 0 || fMeanVector.back() > signal_size - 1) {
       fMeanVector.pop_back();
@@ -123,15 +134,15 @@ void hit::RFFHitFitter::CalculateMergedMeansAndSigmas(size_t signal_size)
     fMeanErrorVector.push_back(0.0);
     fSigmaErrorVector.push_back(0.0);
 
-    for (auto const& sigpair : fMergeVector[i_col]) {
+    for (auto sigpair = group_begin; sigpair != group_end; ++sigpair) {
       fMeanErrorVector.back() +=
         (sigpair->first - fMeanVector.back()) * (sigpair->first - fMeanVector.back());
       fSigmaErrorVector.back() +=
         (sigpair->second - fSigmaVector.back()) * (sigpair->second - fSigmaVector.back());
     }
 
-    fMeanErrorVector.back() = std::sqrt(fMeanErrorVector.back()) / fMergeVector[i_col].size();
-    fSigmaErrorVector.back() = std::sqrt(fSigmaErrorVector.back()) / fMergeVector[i_col].size();
+    fMeanErrorVector.back() = std::sqrt(fMeanErrorVector.back()) / group_size;
+    fSigmaErrorVector.back() = std::sqrt(fSigmaErrorVector.back()) / group_size;
   }
 }
 
@@ -191,7 +202,7 @@ void hit::RFFHitFitter::ClearResults()
   fSigmaErrorVector.clear();
   fAmpVector.clear();
   fAmpErrorVector.clear();
-  fSignalSet.clear();
+  fSignalVector.clear();
   fMergeVector.clear();
 }
 
@@ -199,7 +210,7 @@ void hit::RFFHitFitter::PrintResults()
 {
   std::cout << "InitialSignalSet" << std::endl;
 
-  for (auto const& sigpair : fSignalSet)
+  for (auto const& sigpair : fSignalVector)
     std::cout << "\t" << sigpair.first << " / " << sigpair.second << std::endl;
 
   std::cout << "\nNHits = " << NHits() << std::endl;
@@ -15,7 +15,6 @@
  * Output: Guassian means and sigmas
 */
 
-#include <set>
 #include <vector>
 
 #include "GaussianEliminationAlg.h"
@@ -70,8 +69,9 @@ namespace hit {
     std::vector<float> fAmpVector;
     std::vector<float> fAmpErrorVector;
 
-    std::multiset<MeanSigmaPair, SignalSetComp> fSignalSet;
-    std::vector<std::vector<std::multiset<MeanSigmaPair>::iterator>> fMergeVector;
+    //candidates sorted in mean, and the index of the first candidate of each merge group
+    std::vector<MeanSigmaPair> fSignalVector;
+    std::vector<size_t> fMergeVector;
 
     void CalculateAllMeansAndSigmas(const std::vector<float>& signal);
     void CalculateMergedMeansAndSigmas(std::size_t signal_size);
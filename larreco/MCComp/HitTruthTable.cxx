@@ -0,0 +1,82 @@
+#include "HitTruthTable.h"
+
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "lardataalg/DetectorInfo/DetectorClocksData.h"
+#include "larsim/MCCheater/BackTrackerService.h"
+
+#include <cstdlib>
+
+namespace btutil {
+
+  void HitTruthTable::Reset(detinfo::DetectorClocksData const& clockData,
+                            art::ProductID const& hitProductID,
+                            std::vector<recob::Hit> const& hits,
+                            bool eveIDs)
+  {
+    fHitProductID = hitProductID;
+    fHitBegin.clear();
+    fTrackID.clear();
+    fEnergy.clear();
+    fEnergyFrac.clear();
+    fNumElectrons.clear();
+    fTotalEnergy.clear();
+    fTotalAbsEnergy.clear();
+
+    art::ServiceHandle<cheat::BackTrackerService const> bt_serv;
+
+    // the back tracker is not thread safe, so the lookups are done serially
+    std::vector<std::vector<sim::TrackIDE>> hitIDEs(hits.size());
+    for (size_t i = 0; i < hits.size(); ++i)
+      hitIDEs[i] = eveIDs ? bt_serv->HitToEveTrackIDEs(clockData, hits[i]) :
+                            bt_serv->HitToTrackIDEs(clockData, hits[i]);
+
+    size_t nEntries = 0;
+    for (auto const& ides : hitIDEs)
+      nEntries += ides.size();
+
+    fHitBegin.reserve(hits.size() + 1);
+    fTrackID.reserve(nEntries);
+    fEnergy.reserve(nEntries);
+    fEnergyFrac.reserve(nEntries);
+    fNumElectrons.reserve(nEntries);
+
+    // columns and per track totals are filled in hit order, so the sums are the ones a
+    // loop over all hits would give
+    fHitBegin.push_back(0);
+    for (auto const& ides : hitIDEs) {
+      for (auto const& ide : ides) {
+        fTrackID.push_back(ide.trackID);
+        fEnergy.push_back(ide.energy);
+        fEnergyFrac.push_back(ide.energyFrac);
+        fNumElectrons.push_back(ide.numElectrons);
+
+        fTotalEnergy[ide.trackID] += ide.energy;
+        fTotalAbsEnergy[std::abs(ide.trackID)] += ide.energy;
+      }
+      fHitBegin.push_back(fTrackID.size());
+    }
+  }
+
+  std::vector<sim::TrackIDE> HitTruthTable::TrackIDEs(size_t hit) const
+  {
+    std::vector<sim::TrackIDE> ides;
+    ides.reserve(HitEnd(hit) - HitBegin(hit));
+    for (size_t i = HitBegin(hit); i < HitEnd(hit); ++i) {
+      sim::TrackIDE ide;
+      ide.trackID = fTrackID[i];
+      ide.energyFrac = fEnergyFrac[i];
+      ide.energy = fEnergy[i];
+      ide.numElectrons = fNumElectrons[i];
+      ides.push_back(ide);
+    }
+    return ides;
+  }
+
+  double HitTruthTable::TotalEnergy(int trackID, bool absID) const
+  {
+    auto const& totals = absID ? fTotalAbsEnergy : fTotalEnergy;
+    auto const itr = totals.find(trackID);
+    return itr == totals.end() ? 0. : itr->second;
+  }
+
+}
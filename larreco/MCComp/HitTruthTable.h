@@ -0,0 +1,91 @@
+/**
+ * \file HitTruthTable.h
+ *
+ * \ingroup MCComp
+ *
+ * \brief Class def header for a class HitTruthTable
+ */
+
+/** \addtogroup MCComp
+
+    @{*/
+#ifndef RECOTOOL_HITTRUTHTABLE_H
+#define RECOTOOL_HITTRUTHTABLE_H
+
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/Simulation/SimChannel.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace detinfo {
+  class DetectorClocksData;
+}
+
+/**
+   \class HitTruthTable
+   HitTruthTable back-tracks every hit of one hit collection once per event and keeps
+   hit => (track ID, energy, energy fraction) in flat columns. The entries of hit i
+   (the key of its art::Ptr) are [HitBegin(i), HitEnd(i)), in the order returned by the
+   BackTrackerService. Analyzers matching many reco objects to MC truth look hits up
+   here instead of calling the back tracker for every hit of every object.
+ */
+
+namespace btutil {
+
+  class HitTruthTable {
+
+  public:
+    HitTruthTable() {}
+
+    /**
+       Back-tracks all hits of the collection with the given product ID, using eve IDs
+       instead of track IDs if requested.
+    */
+    void Reset(detinfo::DetectorClocksData const& clockData,
+               art::ProductID const& hitProductID,
+               std::vector<recob::Hit> const& hits,
+               bool eveIDs = false);
+
+    /// True if the hit belongs to the back-tracked collection
+    bool Covers(art::Ptr<recob::Hit> const& hit) const
+    {
+      return hit.id() == fHitProductID && hit.key() < NHits();
+    }
+
+    size_t NHits() const { return fHitBegin.empty() ? 0 : fHitBegin.size() - 1; }
+
+    size_t HitBegin(size_t hit) const { return fHitBegin[hit]; }
+    size_t HitEnd(size_t hit) const { return fHitBegin[hit + 1]; }
+
+    int TrackID(size_t entry) const { return fTrackID[entry]; }
+    float Energy(size_t entry) const { return fEnergy[entry]; }
+    float EnergyFrac(size_t entry) const { return fEnergyFrac[entry]; }
+
+    /// The entries of one hit, as returned by the back tracker
+    std::vector<sim::TrackIDE> TrackIDEs(size_t hit) const;
+
+    /**
+       Energy of a track ID summed over all hits, accumulated in hit order. With absID
+       the track IDs are compared by their absolute value.
+    */
+    double TotalEnergy(int trackID, bool absID = false) const;
+
+  private:
+    art::ProductID fHitProductID;
+
+    std::vector<size_t> fHitBegin;
+    std::vector<int> fTrackID;
+    std::vector<float> fEnergy;
+    std::vector<float> fEnergyFrac;
+    std::vector<float> fNumElectrons;
+
+    std::unordered_map<int, double> fTotalEnergy;
+    std::unordered_map<int, double> fTotalAbsEnergy;
+  };
+}
+
+#endif
+/** @} */ // end of doxygen group
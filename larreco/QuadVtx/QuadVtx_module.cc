@@ -3,6 +3,7 @@
 #include "larreco/QuadVtx/HeatMap.h"
 
 // C/C++ standard libraries
+#include <atomic>
 #include <iostream>
 #include <random>
 #include <string>
@@ -28,7 +29,10 @@
 #include "TGraph.h"
 #include "TH2F.h"
 #include "TMatrixD.h"
-#include "TVectorD.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
 
 namespace quad {
 
@@ -186,6 +190,10 @@ namespace quad {
     unsigned int j0 = 0;
     unsigned int jmax = 0;
 
+    // Remember the range of partner lines of each line so that the
+    // combination below can be split between threads
+    std::vector<std::pair<unsigned int, unsigned int>> ranges(lines.size());
+
     long npts = 0;
     for (unsigned int i = 0; i + 1 < lines.size(); ++i) {
       const Line2D a = lines[i];
@@ -197,6 +205,7 @@ namespace quad {
       while (jmax < lines.size() && !CloseAngles(a.m, lines[jmax].m))
         ++jmax;
 
+      ranges[i] = {j0, jmax};
       npts += jmax - j0;
     }
 
@@ -207,33 +216,39 @@ namespace quad {
 
     mf::LogInfo() << npts << " cf " << product << " ie " << double(npts) / product << std::endl;
 
-    j0 = 0;
-    jmax = 0;
-
-    for (unsigned int i = 0; i + 1 < lines.size(); ++i) {
-      const Line2D a = lines[i];
-
-      j0 = std::max(j0, i + 1);
-      while (j0 < lines.size() && CloseAngles(a.m, lines[j0].m))
-        ++j0;
-      jmax = std::max(jmax, j0);
-      while (jmax < lines.size() && !CloseAngles(a.m, lines[jmax].m))
-        ++jmax;
-
-      for (unsigned int j = j0; j < jmax; j += stride) {
-        const Line2D& b = lines[j];
-
-        // x = mA * z + cA = mB * z + cB
-        const float z = (b.c - a.c) / (a.m - b.m);
-        const float x = a.m * z + a.c;
-
-        // No solutions within a line
-        if ((z < a.minz || z > a.maxz) && (z < b.minz || z > b.maxz)) {
-          const int iz = hm.ZToBin(z);
-          const int ix = hm.XToBin(x);
-          if (iz >= 0 && iz < hm.Nz && ix >= 0 && ix < hm.Nx) { hm.map[iz * hm.Nx + ix] += stride; }
-        }
-      } // end for i
+    // Each thread fills its own copy of the map, the copies are summed at the
+    // end. The entries are integer counts so the order of the sum is irrelevant.
+    tbb::enumerable_thread_specific<std::vector<float>> partialMaps(
+      [&hm] { return std::vector<float>(hm.map.size(), 0); });
+
+    tbb::parallel_for(
+      tbb::blocked_range<unsigned int>(0, lines.size() > 0 ? lines.size() - 1 : 0),
+      [&](const tbb::blocked_range<unsigned int>& range) {
+        float* map = partialMaps.local().data();
+
+        for (unsigned int i = range.begin(); i != range.end(); ++i) {
+          const Line2D a = lines[i];
+
+          for (unsigned int j = ranges[i].first; j < ranges[i].second; j += stride) {
+            const Line2D& b = lines[j];
+
+            // x = mA * z + cA = mB * z + cB
+            const float z = (b.c - a.c) / (a.m - b.m);
+            const float x = a.m * z + a.c;
+
+            // No solutions within a line
+            if ((z < a.minz || z > a.maxz) && (z < b.minz || z > b.maxz)) {
+              const int iz = hm.ZToBin(z);
+              const int ix = hm.XToBin(x);
+              if (iz >= 0 && iz < hm.Nz && ix >= 0 && ix < hm.Nx) { map[iz * hm.Nx + ix] += stride; }
+            }
+          } // end for j
+        }   // end for i
+      });
+
+    for (const std::vector<float>& partial : partialMaps) {
+      for (size_t k = 0; k < partial.size(); ++k)
+        hm.map[k] += partial[k];
     }
   }
 
@@ -258,8 +273,22 @@ namespace quad {
 
     M.Invert();
 
-    float bestscore = -1;
-    recob::tracking::Point_t bestr;
+    const double M00 = M(0, 0), M01 = M(0, 1), M10 = M(1, 0), M11 = M(1, 1);
+
+    // Best score found so far by any thread, only used to skip hopeless
+    // combinations. A combination is skipped only if it can't even equal the
+    // best, so the result doesn't depend on the order the threads run in.
+    std::atomic<float> bestbound(-1);
+    auto raiseBound = [&bestbound](float score) {
+      float prev = bestbound.load();
+      while (score > prev && !bestbound.compare_exchange_weak(prev, score)) {}
+    };
+
+    struct ZResult {
+      float score = -1;
+      recob::tracking::Point_t r;
+    };
+    std::vector<ZResult> zbest(hs[0].Nz);
 
     // Accumulate some statistics up front that will enable us to optimize
     std::vector<float> colMax[3];
@@ -270,24 +299,26 @@ namespace quad {
       }
     }
 
-    for (int iz = 0; iz < hs[0].Nz; ++iz) {
+    tbb::parallel_for(0, hs[0].Nz, [&](int iz) {
       const float z = hs[0].ZBinCenter(iz);
       const float bonus = 1; // works badly... exp((hs[0].maxz-z)/1000.);
 
+      float& bestscore = zbest[iz].score;
+
       for (int iu = 0; iu < hs[1].Nz; ++iu) {
         const float u = hs[1].ZBinCenter(iu);
         // r.Dot(d0) = z && r.Dot(d1) = u
-        TVectorD p(2);
-        p(0) = z;
-        p(1) = u;
-        const TVectorD r = M * p;
-        const float v = r[0] * dirs[2].Y() + r[1] * dirs[2].Z();
+        const double r0 = M00 * z + M01 * u;
+        const double r1 = M10 * z + M11 * u;
+        const float v = r0 * dirs[2].Y() + r1 * dirs[2].Z();
         const int iv = hs[2].ZToBin(v);
         if (iv < 0 || iv >= hs[2].Nz) continue;
-        const double y = r(0);
+        const double y = r0;
 
         // Even if the maxes were all at the same x we couldn't beat the record
-        if (colMax[0][iz] + colMax[1][iu] + colMax[2][iv] < bestscore) continue;
+        const float colBound = colMax[0][iz] + colMax[1][iu] + colMax[2][iv];
+        if (colBound < bestscore || colBound < bestbound.load(std::memory_order_relaxed))
+          continue;
 
         const float* h0 = &hs[0].map[Nx * iz];
         const float* h1 = &hs[1].map[Nx * iu];
@@ -303,9 +334,22 @@ namespace quad {
           }
         } // end for dx
 
-        if (bestix != -1) { bestr.SetXYZ(hs[0].XBinCenter(bestix), y, z); }
+        if (bestix != -1) {
+          zbest[iz].r.SetXYZ(hs[0].XBinCenter(bestix), y, z);
+          raiseBound(bestscore);
+        }
       } // end for u
-    }   // end for z
+    }); // end for z
+
+    // The first z with the highest score wins, as in a serial scan
+    float bestscore = -1;
+    recob::tracking::Point_t bestr;
+    for (const ZResult& res : zbest) {
+      if (res.score > bestscore) {
+        bestscore = res.score;
+        bestr = res.r;
+      }
+    }
 
     return bestr;
   }
@@ -420,15 +464,25 @@ namespace quad {
     for (int view = 0; view < 3; ++view) {
       if (pts[view].empty()) return false;
 
+      // Approximately cm bins
+      hms.emplace_back(maxz[view] - minz[view], minz[view], maxz[view], maxx - minx, minx, maxx);
+    }
+
+    // The views are independent, fill their maps concurrently
+    std::atomic<bool> noLines(false);
+    tbb::parallel_for(0, 3, [&](int view) {
       std::vector<Line2D> lines;
       LinesFromPoints(pts[view], lines);
 
-      if (lines.empty()) return false;
+      if (lines.empty()) {
+        noLines = true;
+        return;
+      }
+
+      MapFromLines(lines, hms[view]);
+    }); // end for view
 
-      // Approximately cm bins
-      hms.emplace_back(maxz[view] - minz[view], minz[view], maxz[view], maxx - minx, minx, maxx);
-      MapFromLines(lines, hms.back());
-    } // end for view
+    if (noLines) return false;
 
     vtx = FindPeak3D(hms, dirs);
 
@@ -438,16 +492,26 @@ namespace quad {
       const double x0 = vtx.X();
       const double z0 = vtx.Dot(dirs[view]);
 
+      // mm granularity
+      hms_zoom.emplace_back(50, z0 - 2.5, z0 + 2.5, 50, x0 - 2.5, x0 + 2.5);
+    }
+
+    tbb::parallel_for(0, 3, [&](int view) {
+      const double x0 = vtx.X();
+      const double z0 = vtx.Dot(dirs[view]);
+
       std::vector<Line2D> lines;
       LinesFromPoints(pts[view], lines, z0, x0, 2.5);
 
-      if (lines.empty()) return false; // How does this happen??
+      if (lines.empty()) { // How does this happen??
+        noLines = true;
+        return;
+      }
 
-      // mm granularity
-      hms_zoom.emplace_back(50, z0 - 2.5, z0 + 2.5, 50, x0 - 2.5, x0 + 2.5);
+      MapFromLines(lines, hms_zoom[view]);
+    });
 
-      MapFromLines(lines, hms_zoom.back());
-    }
+    if (noLines) return false;
 
     vtx = FindPeak3D(hms_zoom, dirs);
 
@@ -18,6 +18,7 @@
 #include "larcorealg/Geometry/WireGeo.h"
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "larreco/RecoAlg/APAGeometryAlg.h"
+#include "larreco/RecoAlg/GeometryCache.h"
 
 #include <algorithm>
 #include <cmath>
@@ -445,8 +446,9 @@ namespace apa {
 
     // Get the WireIDs and view for each channel, make sure views are different
     geo::WireIDIntersection widIntersect;
-    std::vector<geo::WireID> wids1 = fGeom->ChannelToWire(chan1);
-    std::vector<geo::WireID> wids2 = fGeom->ChannelToWire(chan2);
+    auto const& geometryCache = util::GeometryCache::Instance();
+    auto const wids1 = geometryCache.ChannelToWire(chan1);
+    auto const wids2 = geometryCache.ChannelToWire(chan2);
     geo::View_t view1 = fGeom->View(chan1);
     geo::View_t view2 = fGeom->View(chan2);
     if (view1 == view2) {
@@ -483,7 +485,8 @@ namespace apa {
         //                << wids2[i2].Plane    << "," << wids2[i2].Wire << ")" << std::endl;
 
         // Check if they even intersect; if they do, push back
-        if (fGeom->WireIDsIntersect(wids1[i1], wids2[i2], widIntersect)) {
+        if (geometryCache.MayIntersect(wids1[i1], wids2[i2]) &&
+            fGeom->WireIDsIntersect(wids1[i1], wids2[i2], widIntersect)) {
 
           //	  std::cout << "we have an intersect" << std::endl;
 
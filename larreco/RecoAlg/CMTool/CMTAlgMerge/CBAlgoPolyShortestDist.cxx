@@ -66,6 +66,12 @@ namespace cmtool {
       return false;
     }
 
+    //no two points can be closer than the bounding boxes of the polygons
+    //(the loop is still run in debug mode, for its printout)
+    if (!_debug && cluster1.GetParams().PolyObject.VertexDistSqrdLowerBound(
+                     cluster2.GetParams().PolyObject) >= _dist_sqrd_cut)
+      return false;
+
     //loop over the points on the first polygon and calculate
     //distance to each point on the second polygon
     //if any two points are close enough to each other,
@@ -6,6 +6,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 
 #include "lardata/Utilities/PxUtils.h"
 #include "larreco/RecoAlg/CMTool/CMToolBase/CBoolAlgoBase.h"
@@ -164,7 +165,7 @@ namespace cmtool {
     if (!_iter_ctr)
       _tmp_merged_clusters = _in_clusters;
     else
-      _tmp_merged_clusters = _out_clusters;
+      _tmp_merged_clusters = std::move(_out_clusters);
     _out_clusters.clear();
 
     bk.Reset(_tmp_merged_clusters.size());
@@ -192,8 +193,10 @@ namespace cmtool {
       _out_clusters.reserve(_tmp_merged_indexes.size());
       for (auto const& indexes_v : _tmp_merged_indexes) {
 
+        // each input cluster goes to exactly one output cluster, so the untouched
+        // ones are moved rather than copied (only the input count is used afterwards)
         if (indexes_v.size() == 1) {
-          _out_clusters.push_back(_tmp_merged_clusters.at(indexes_v.at(0)));
+          _out_clusters.push_back(std::move(_tmp_merged_clusters.at(indexes_v.at(0))));
           continue;
         }
 
@@ -212,7 +215,7 @@ namespace cmtool {
         (*_out_clusters.rbegin()).SetVerbose(false);
         (*_out_clusters.rbegin()).DisableFANN();
 
-        if ((*_out_clusters.rbegin()).SetHits(tmp_hits) < 1) continue;
+        if ((*_out_clusters.rbegin()).SetHits(std::move(tmp_hits)) < 1) continue;
         (*_out_clusters.rbegin()).FillParams(gser, true, true, true, true, true, false);
         (*_out_clusters.rbegin()).FillPolygon(gser);
       }
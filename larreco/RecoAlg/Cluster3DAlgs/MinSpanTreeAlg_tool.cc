@@ -26,6 +26,7 @@
 #include "larreco/RecoAlg/Cluster3DAlgs/kdTree.h"
 
 // std includes
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <unordered_map>
@@ -266,8 +267,19 @@ namespace lar_cluster3d {
     // Initialization
     size_t clusterIdx(0);
 
-    // This will contain our list of edges
-    reco::EdgeList curEdgeList;
+    // Candidate edges are kept in a binary heap ordered by weight, ties going to the edge found
+    // first. Edges to hits which have since been attached are not purged but dropped when they
+    // reach the top of the heap.
+    using HeapEdge = std::pair<reco::EdgeTuple, size_t>;
+
+    auto heapOrder = [](const HeapEdge& left, const HeapEdge& right) {
+      if (std::get<2>(left.first) != std::get<2>(right.first))
+        return std::get<2>(left.first) > std::get<2>(right.first);
+      return left.second > right.second;
+    };
+
+    std::vector<HeapEdge> curEdgeHeap;
+    size_t edgeCount(0);
 
     // Get the first point
     reco::HitPairList::iterator freeHitItr = hitPairList.begin();
@@ -290,15 +302,6 @@ namespace lar_cluster3d {
       // and the 3D hit status bits
       lastAddedHit->setStatusBit(reco::ClusterHit3D::CLUSTERATTACHED);
 
-      // Purge the current list to get rid of edges which point to hits already in the cluster
-      for (reco::EdgeList::iterator curEdgeItr = curEdgeList.begin();
-           curEdgeItr != curEdgeList.end();) {
-        if (std::get<1>(*curEdgeItr)->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED)
-          curEdgeItr = curEdgeList.erase(curEdgeItr);
-        else
-          curEdgeItr++;
-      }
-
       // Add the lastUsedHit to the current cluster
       curCluster->push_back(lastAddedHit);
 
@@ -316,12 +319,21 @@ namespace lar_cluster3d {
         if (!(pair.second->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED)) {
           double edgeWeight = lastAddedHit->getHitChiSquare() * pair.second->getHitChiSquare();
 
-          curEdgeList.push_back(reco::EdgeTuple(lastAddedHit, pair.second, edgeWeight));
+          curEdgeHeap.emplace_back(reco::EdgeTuple(lastAddedHit, pair.second, edgeWeight),
+                                   edgeCount++);
+          std::push_heap(curEdgeHeap.begin(), curEdgeHeap.end(), heapOrder);
         }
       }
 
+      // Drop edges which point to hits already in a cluster
+      while (!curEdgeHeap.empty() && (std::get<1>(curEdgeHeap.front().first)->getStatusBits() &
+                                      reco::ClusterHit3D::CLUSTERATTACHED)) {
+        std::pop_heap(curEdgeHeap.begin(), curEdgeHeap.end(), heapOrder);
+        curEdgeHeap.pop_back();
+      }
+
       // If the edge list is empty then we have a complete cluster
-      if (curEdgeList.empty()) {
+      if (curEdgeHeap.empty()) {
         std::cout << "-----------------------------------------------------------------------------"
                      "------------"
                   << std::endl;
@@ -351,13 +363,8 @@ namespace lar_cluster3d {
       }
       // Otherwise we are still processing the current cluster
       else {
-        // Sort the list of edges by distance
-        curEdgeList.sort([](const auto& left, const auto& right) {
-          return std::get<2>(left) < std::get<2>(right);
-        });
-
         // Populate the map with the edges...
-        reco::EdgeTuple& curEdge = curEdgeList.front();
+        const reco::EdgeTuple& curEdge = curEdgeHeap.front().first;
 
         (*curEdgeMap)[std::get<0>(curEdge)].push_back(curEdge);
         (*curEdgeMap)[std::get<1>(curEdge)].push_back(
@@ -397,13 +404,14 @@ namespace lar_cluster3d {
 
     // Do some spelunking...
     for (const auto& hit : hitPairList) {
-      if (!curEdgeMap[hit].empty() && curEdgeMap[hit].size() == 1) {
+      const reco::EdgeList& hitEdgeList = curEdgeMap[hit];
+
+      if (hitEdgeList.size() == 1) {
         float quality(0.);
 
-        reco::HitPairListPtr tempList =
-          DepthFirstSearch(curEdgeMap[hit].front(), curEdgeMap, quality);
+        reco::HitPairListPtr tempList = DepthFirstSearch(hitEdgeList.front(), curEdgeMap, quality);
 
-        tempList.push_front(std::get<0>(curEdgeMap[hit].front()));
+        tempList.push_front(std::get<0>(hitEdgeList.front()));
 
         if (quality > bestQuality) {
           longestCluster = tempList;
@@ -413,8 +421,8 @@ namespace lar_cluster3d {
         nIsolatedHits++;
       }
 
-      aveNumEdges += float(curEdgeMap[hit].size());
-      maxNumEdges = std::max(maxNumEdges, curEdgeMap[hit].size());
+      aveNumEdges += float(hitEdgeList.size());
+      maxNumEdges = std::max(maxNumEdges, hitEdgeList.size());
     }
 
     aveNumEdges /= float(hitPairList.size());
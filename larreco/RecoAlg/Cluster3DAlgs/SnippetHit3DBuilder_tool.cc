@@ -31,6 +31,7 @@
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/IHit3DBuilder.h"
+#include "larreco/RecoAlg/GeometryCache.h"
 
 // Eigen
 #include <Eigen/Core>
@@ -1683,6 +1684,8 @@ namespace lar_cluster3d {
       m_weHaveAllBeenHereBefore = true;
     }
 
+    auto const& geometryCache = util::GeometryCache::Instance();
+
     // Cycle through the recob hits to build ClusterHit2D objects and insert
     // them into the map
     for (const auto& recobHit : recobHitVec) {
@@ -1691,7 +1694,7 @@ namespace lar_cluster3d {
 
       // For some detectors we can have multiple wire ID's associated to a given channel.
       // So we recover the list of these wire IDs
-      const std::vector<geo::WireID>& wireIDs = m_geometry->ChannelToWire(recobHit->Channel());
+      const auto wireIDs = geometryCache.ChannelToWire(recobHit->Channel());
 
       // Start/End ticks to identify the snippet
       HitStartEndPair hitStartEndPair(recobHit->StartTick(), recobHit->EndTick());
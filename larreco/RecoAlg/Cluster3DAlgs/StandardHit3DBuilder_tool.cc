@@ -30,10 +30,14 @@
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/IHit3DBuilder.h"
+#include "larreco/RecoAlg/GeometryCache.h"
 
 // Eigen
 #include <Eigen/Core>
 
+// TBB
+#include "tbb/parallel_for.h"
+
 // std includes
 #include <iostream>
 #include <memory>
@@ -149,31 +153,49 @@ namespace lar_cluster3d {
                            reco::HitPairList& hitPairList) const;
 
     /**
-     *  @brief Given the ClusterHit2D objects, build the HitPairMap
+     *  @brief The hits of one plane in "start time" order, with the times used by the search
+     *         window and by the coarse pair time check copied to flat arrays
+     */
+    struct PlaneHitArrays {
+      HitVector hits;
+      std::vector<float> startTime; ///< peak time - NumSigmaPeakTime * rms
+      std::vector<float> endTime;   ///< peak time + NumSigmaPeakTime * rms
+      std::vector<float> peakTime;
+      std::vector<float> sigma; ///< rms, or distance to the nearest snippet end for long hits
+    };
+
+    using PlaneHitArraysVec = std::vector<PlaneHitArrays>;
+
+    /**
+     *  @brief Sort the hits of a plane into "start time" order and fill its arrays
      */
-    using PlaneHitVectorItrPairVec =
-      std::vector<std::pair<HitVector::iterator, HitVector::iterator>>;
+    void FillPlaneHitArrays(HitVector& hitVector, PlaneHitArrays& planeHitArrays) const;
 
-    size_t BuildHitPairMapByTPC(PlaneHitVectorItrPairVec& planeHitVectorItrPairVec,
+    /**
+     *  @brief Given the ClusterHit2D objects, build the HitPairMap
+     */
+    size_t BuildHitPairMapByTPC(PlaneHitArraysVec& planeHitArraysVec,
                                 reco::HitPairList& hitPairList) const;
 
     /**
-     *  @brief This builds a list of candidate hit pairs from lists of hits on two planes
+     *  @brief This builds a list of candidate hit pairs from lists of hits on two planes,
+     *         grouped by the wire of the second hit and in time order for each wire
      */
     using HitMatchPair = std::pair<const reco::ClusterHit2D*, reco::ClusterHit3D>;
     using HitMatchPairVec = std::vector<HitMatchPair>;
-    using HitMatchPairVecMap = std::map<geo::WireID, HitMatchPairVec>;
 
-    int findGoodHitPairs(const reco::ClusterHit2D*,
-                         HitVector::iterator&,
-                         HitVector::iterator&,
-                         HitMatchPairVecMap&) const;
+    int findGoodHitPairs(const PlaneHitArrays&,
+                         size_t,
+                         const PlaneHitArrays&,
+                         size_t,
+                         size_t,
+                         HitMatchPairVec&) const;
 
     /**
      *  @brief This algorithm takes lists of hit pairs and finds good triplets
      */
-    void findGoodTriplets(HitMatchPairVecMap&,
-                          HitMatchPairVecMap&,
+    void findGoodTriplets(HitMatchPairVec&,
+                          HitMatchPairVec&,
                           reco::HitPairList&,
                           bool = false) const;
 
@@ -295,11 +317,13 @@ namespace lar_cluster3d {
     mutable bool m_weHaveAllBeenHereBefore = false;
 
     const geo::Geometry* m_geometry;
+    const util::GeometryCache* m_geometryCache; ///< channel to wire table, crossed wire ranges
     const lariov::ChannelStatusProvider* m_channelFilter;
   };
 
   StandardHit3DBuilder::StandardHit3DBuilder(fhicl::ParameterSet const& pset)
     : m_geometry(art::ServiceHandle<geo::Geometry const>{}.get())
+    , m_geometryCache(&util::GeometryCache::Instance())
     , m_channelFilter(&art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider())
   {
     this->configure(pset);
@@ -527,29 +551,6 @@ namespace lar_cluster3d {
       float m_numRMS;
     };
 
-    using HitVectorItrPair = std::pair<HitVector::iterator, HitVector::iterator>;
-
-    class SetStartTimeOrder {
-    public:
-      SetStartTimeOrder() : m_numRMS(1.) {}
-      SetStartTimeOrder(float numRMS) : m_numRMS(numRMS) {}
-
-      bool operator()(const HitVectorItrPair& left, const HitVectorItrPair& right) const
-      {
-        // Protect against possible issue?
-        if (left.first != left.second && right.first != right.second) {
-          // Sort by "modified start time" of pulse
-          return (*left.first)->getTimeTicks() - m_numRMS * (*left.first)->getHit()->RMS() <
-                 (*right.first)->getTimeTicks() - m_numRMS * (*right.first)->getHit()->RMS();
-        }
-
-        return left.first != left.second;
-      }
-
-    private:
-      float m_numRMS;
-    };
-
     bool SetPairStartTimeOrder(const reco::ClusterHit3D& left, const reco::ClusterHit3D& right)
     {
       // Sort by "modified start time" of pulse
@@ -579,6 +580,8 @@ namespace lar_cluster3d {
     size_t nDeadChanHits(0);
 
     // Set up to loop over cryostats and tpcs...
+    std::vector<std::vector<HitVector*>> tpcHitVectors;
+
     for (size_t cryoIdx = 0; cryoIdx < m_geometry->Ncryostats(); cryoIdx++) {
       for (size_t tpcIdx = 0; tpcIdx < m_geometry->NTPC(); tpcIdx++) {
         PlaneToHitVectorMap::iterator mapItr0 =
@@ -595,30 +598,42 @@ namespace lar_cluster3d {
 
         if (nPlanesWithHits < 2) continue;
 
-        HitVector& hitVector0 = mapItr0->second;
-        HitVector& hitVector1 = mapItr1->second;
-        HitVector& hitVector2 = mapItr2->second;
-
-        // We are going to resort the hits into "start time" order...
-        std::sort(hitVector0.begin(),
-                  hitVector0.end(),
-                  SetHitEarliestTimeOrder(m_numSigmaPeakTime)); //SetHitStartTimeOrder);
-        std::sort(hitVector1.begin(),
-                  hitVector1.end(),
-                  SetHitEarliestTimeOrder(m_numSigmaPeakTime)); //SetHitStartTimeOrder);
-        std::sort(hitVector2.begin(),
-                  hitVector2.end(),
-                  SetHitEarliestTimeOrder(m_numSigmaPeakTime)); //SetHitStartTimeOrder);
-
-        PlaneHitVectorItrPairVec hitItrVec = {
-          HitVectorItrPair(hitVector0.begin(), hitVector0.end()),
-          HitVectorItrPair(hitVector1.begin(), hitVector1.end()),
-          HitVectorItrPair(hitVector2.begin(), hitVector2.end())};
-
-        totalNumHits += BuildHitPairMapByTPC(hitItrVec, hitPairList);
+        tpcHitVectors.push_back({&mapItr0->second, &mapItr1->second, &mapItr2->second});
       }
     }
 
+    // Hits in different TPCs are never paired so each TPC builds its own list, the lists are
+    // then appended in TPC order with their IDs shifted to the position in the full list
+    std::vector<reco::HitPairList> tpcHitPairLists(tpcHitVectors.size());
+
+    auto buildTPCHitPairs = [&](size_t tpcHitVecIdx) {
+      PlaneHitArraysVec planeHitArraysVec(3);
+
+      for (size_t planeIdx = 0; planeIdx < 3; planeIdx++)
+        FillPlaneHitArrays(*tpcHitVectors[tpcHitVecIdx][planeIdx], planeHitArraysVec[planeIdx]);
+
+      BuildHitPairMapByTPC(planeHitArraysVec, tpcHitPairLists[tpcHitVecIdx]);
+    };
+
+    // The diagnostic tree vectors are shared so the TPCs are done in turn when filling them
+    if (m_outputHistograms) {
+      for (size_t tpcHitVecIdx = 0; tpcHitVecIdx < tpcHitVectors.size(); tpcHitVecIdx++)
+        buildTPCHitPairs(tpcHitVecIdx);
+    }
+    else
+      tbb::parallel_for(size_t(0), tpcHitVectors.size(), buildTPCHitPairs);
+
+    for (auto& tpcHitPairList : tpcHitPairLists) {
+      size_t idOffset = hitPairList.size();
+
+      for (const auto& hitPair : tpcHitPairList)
+        hitPair.setID(hitPair.getID() + idOffset);
+
+      hitPairList.splice(hitPairList.end(), tpcHitPairList);
+
+      totalNumHits += hitPairList.size();
+    }
+
     // Return the hit pair list but sorted by z and y positions (faster traversal in next steps)
     hitPairList.sort(SetPairStartTimeOrder);
 
@@ -632,7 +647,37 @@ namespace lar_cluster3d {
     return hitPairList.size();
   }
 
-  size_t StandardHit3DBuilder::BuildHitPairMapByTPC(PlaneHitVectorItrPairVec& hitItrVec,
+  void StandardHit3DBuilder::FillPlaneHitArrays(HitVector& hitVector,
+                                                PlaneHitArrays& planeHitArrays) const
+  {
+    // We are going to resort the hits into "start time" order...
+    std::sort(hitVector.begin(), hitVector.end(), SetHitEarliestTimeOrder(m_numSigmaPeakTime));
+
+    planeHitArrays.hits = hitVector;
+    planeHitArrays.startTime.resize(hitVector.size());
+    planeHitArrays.endTime.resize(hitVector.size());
+    planeHitArrays.peakTime.resize(hitVector.size());
+    planeHitArrays.sigma.resize(hitVector.size());
+
+    for (size_t hitIdx = 0; hitIdx < hitVector.size(); hitIdx++) {
+      const reco::ClusterHit2D* hit = hitVector[hitIdx];
+      float hitPeak = hit->getTimeTicks();
+      float hitRMS = hit->getHit()->RMS();
+      float hitSigma = hitRMS;
+
+      // Basically, allow the range to extend to the nearest end of the snippet
+      if (hit->getHit()->DegreesOfFreedom() < 2)
+        hitSigma = std::min(hitPeak - float(hit->getHit()->StartTick()),
+                            float(hit->getHit()->EndTick()) - hitPeak);
+
+      planeHitArrays.startTime[hitIdx] = hitPeak - m_numSigmaPeakTime * hitRMS;
+      planeHitArrays.endTime[hitIdx] = hitPeak + m_numSigmaPeakTime * hitRMS;
+      planeHitArrays.peakTime[hitIdx] = hitPeak;
+      planeHitArrays.sigma[hitIdx] = hitSigma;
+    }
+  }
+
+  size_t StandardHit3DBuilder::BuildHitPairMapByTPC(PlaneHitArraysVec& planeHitArraysVec,
                                                     reco::HitPairList& hitPairList) const
   {
     /**
@@ -645,76 +690,91 @@ namespace lar_cluster3d {
      *         will evaluate the situation and in some instances keep the U-W pairs in order to keep efficiency high.
      */
 
-    // Define functions to set start/end iterators in the loop below
-    auto SetStartIterator =
-      [](HitVector::iterator startItr, HitVector::iterator endItr, float rms, float startTime) {
-        while (startItr != endItr) {
-          float numRMS(rms);
-          if ((*startItr)->getTimeTicks() + numRMS * (*startItr)->getHit()->RMS() < startTime)
-            startItr++;
-          else
-            break;
-        }
-        return startItr;
+    // The current position and the end of each plane's hit arrays
+    struct PlaneHitRange {
+      size_t plane;
+      size_t first;
+      size_t last;
+    };
+
+    std::vector<PlaneHitRange> hitRangeVec = {{0, 0, planeHitArraysVec[0].hits.size()},
+                                              {1, 0, planeHitArraysVec[1].hits.size()},
+                                              {2, 0, planeHitArraysVec[2].hits.size()}};
+
+    // Order planes by the "modified start time" of their next hit, exhausted planes last
+    auto SetStartTimeOrder = [&planeHitArraysVec](const PlaneHitRange& left,
+                                                  const PlaneHitRange& right) {
+      if (left.first != left.last && right.first != right.last)
+        return planeHitArraysVec[left.plane].startTime[left.first] <
+               planeHitArraysVec[right.plane].startTime[right.first];
+
+      return left.first != left.last;
+    };
+
+    // Define functions to set start/end indices in the loop below
+    auto SetStartIndex =
+      [](const PlaneHitArrays& planeHits, size_t first, size_t last, float startTime) {
+        while (first != last && planeHits.endTime[first] < startTime)
+          first++;
+        return first;
       };
 
-    auto SetEndIterator =
-      [](HitVector::iterator firstItr, HitVector::iterator endItr, float rms, float endTime) {
-        while (firstItr != endItr) {
-          float numRMS(rms);
-          if ((*firstItr)->getTimeTicks() - numRMS * (*firstItr)->getHit()->RMS() < endTime)
-            firstItr++;
-          else
-            break;
-        }
-        return firstItr;
+    auto SetEndIndex =
+      [](const PlaneHitArrays& planeHits, size_t first, size_t last, float endTime) {
+        while (first != last && planeHits.startTime[first] < endTime)
+          first++;
+        return first;
       };
 
+    // Since we'll use these many times in the internal loops, pre make the pairs for the second set of hits
+    HitMatchPairVec pair12Vec;
+    HitMatchPairVec pair13Vec;
+
     //*********************************************************************************
     // Basically, we try to loop until done...
     while (1) {
       // Sort so that the earliest hit time will be the first element, etc.
-      std::sort(hitItrVec.begin(), hitItrVec.end(), SetStartTimeOrder(m_numSigmaPeakTime));
+      std::sort(hitRangeVec.begin(), hitRangeVec.end(), SetStartTimeOrder);
 
       // This loop iteration's golden hit
-      const reco::ClusterHit2D* goldenHit = *hitItrVec[0].first;
+      const PlaneHitArrays& goldenPlane = planeHitArraysVec[hitRangeVec[0].plane];
+      size_t goldenIdx = hitRangeVec[0].first;
 
       // The range of history... (for this hit)
-      float goldenTimeStart = goldenHit->getTimeTicks() -
-                              m_numSigmaPeakTime * goldenHit->getHit()->RMS() -
-                              std::numeric_limits<float>::epsilon();
-      float goldenTimeEnd = goldenHit->getTimeTicks() +
-                            m_numSigmaPeakTime * goldenHit->getHit()->RMS() +
-                            std::numeric_limits<float>::epsilon();
-
-      // Set iterators to insure we'll be in the overlap ranges
-      HitVector::iterator hitItr1Start = SetStartIterator(
-        hitItrVec[1].first, hitItrVec[1].second, m_numSigmaPeakTime, goldenTimeStart);
-      HitVector::iterator hitItr1End =
-        SetEndIterator(hitItr1Start, hitItrVec[1].second, m_numSigmaPeakTime, goldenTimeEnd);
-      HitVector::iterator hitItr2Start = SetStartIterator(
-        hitItrVec[2].first, hitItrVec[2].second, m_numSigmaPeakTime, goldenTimeStart);
-      HitVector::iterator hitItr2End =
-        SetEndIterator(hitItr2Start, hitItrVec[2].second, m_numSigmaPeakTime, goldenTimeEnd);
-
-      // Since we'll use these many times in the internal loops, pre make the pairs for the second set of hits
-      HitMatchPairVecMap pair12Map;
-      HitMatchPairVecMap pair13Map;
-
-      size_t n12Pairs = findGoodHitPairs(goldenHit, hitItr1Start, hitItr1End, pair12Map);
-      size_t n13Pairs = findGoodHitPairs(goldenHit, hitItr2Start, hitItr2End, pair13Map);
+      float goldenTimeStart =
+        goldenPlane.startTime[goldenIdx] - std::numeric_limits<float>::epsilon();
+      float goldenTimeEnd = goldenPlane.endTime[goldenIdx] + std::numeric_limits<float>::epsilon();
+
+      // Set indices to insure we'll be in the overlap ranges
+      const PlaneHitArrays& plane1 = planeHitArraysVec[hitRangeVec[1].plane];
+      const PlaneHitArrays& plane2 = planeHitArraysVec[hitRangeVec[2].plane];
+
+      size_t hit1Start =
+        SetStartIndex(plane1, hitRangeVec[1].first, hitRangeVec[1].last, goldenTimeStart);
+      size_t hit1End = SetEndIndex(plane1, hit1Start, hitRangeVec[1].last, goldenTimeEnd);
+      size_t hit2Start =
+        SetStartIndex(plane2, hitRangeVec[2].first, hitRangeVec[2].last, goldenTimeStart);
+      size_t hit2End = SetEndIndex(plane2, hit2Start, hitRangeVec[2].last, goldenTimeEnd);
+
+      pair12Vec.clear();
+      pair13Vec.clear();
+
+      size_t n12Pairs =
+        findGoodHitPairs(goldenPlane, goldenIdx, plane1, hit1Start, hit1End, pair12Vec);
+      size_t n13Pairs =
+        findGoodHitPairs(goldenPlane, goldenIdx, plane2, hit2Start, hit2End, pair13Vec);
 
       if (n12Pairs > n13Pairs)
-        findGoodTriplets(pair12Map, pair13Map, hitPairList);
+        findGoodTriplets(pair12Vec, pair13Vec, hitPairList);
       else
-        findGoodTriplets(pair13Map, pair12Map, hitPairList);
+        findGoodTriplets(pair13Vec, pair12Vec, hitPairList);
 
-      hitItrVec[0].first++;
+      hitRangeVec[0].first++;
 
       int nPlanesWithHits(0);
 
-      for (auto& pair : hitItrVec)
-        if (pair.first != pair.second) nPlanesWithHits++;
+      for (const auto& hitRange : hitRangeVec)
+        if (hitRange.first != hitRange.last) nPlanesWithHits++;
 
       if (nPlanesWithHits < 2) break;
     }
@@ -722,96 +782,96 @@ namespace lar_cluster3d {
     return hitPairList.size();
   }
 
-  int StandardHit3DBuilder::findGoodHitPairs(const reco::ClusterHit2D* goldenHit,
-                                             HitVector::iterator& startItr,
-                                             HitVector::iterator& endItr,
-                                             HitMatchPairVecMap& hitMatchMap) const
+  int StandardHit3DBuilder::findGoodHitPairs(const PlaneHitArrays& goldenPlane,
+                                             size_t goldenIdx,
+                                             const PlaneHitArrays& planeHits,
+                                             size_t startIdx,
+                                             size_t endIdx,
+                                             HitMatchPairVec& hitMatchVec) const
   {
     int numPairs(0);
 
-    // Loop through the input secon hits and make pairs
-    while (startItr != endItr) {
-      const reco::ClusterHit2D* hit = *startItr++;
+    const reco::ClusterHit2D* goldenHit = goldenPlane.hits[goldenIdx];
+    float goldenPeak = goldenPlane.peakTime[goldenIdx];
+    float goldenWidth = m_hitWidthSclFctr * goldenPlane.sigma[goldenIdx];
+
+    // Loop through the input second hits and make pairs
+    for (size_t hitIdx = startIdx; hitIdx < endIdx; hitIdx++) {
+      // The coarse time check of makeHitPair, done here on the arrays to skip the hit lookups
+      if (!(fabs(goldenPeak - planeHits.peakTime[hitIdx]) <=
+            goldenWidth + m_hitWidthSclFctr * planeHits.sigma[hitIdx]))
+        continue;
+
+      const reco::ClusterHit2D* hit = planeHits.hits[hitIdx];
       reco::ClusterHit3D pair;
 
       // pair returned with a negative ave time is signal of failure
       if (!makeHitPair(pair, goldenHit, hit, m_hitWidthSclFctr)) continue;
 
-      geo::WireID wireID = hit->WireID();
-
-      hitMatchMap[wireID].emplace_back(hit, pair);
+      hitMatchVec.emplace_back(hit, pair);
 
       numPairs++;
     }
 
+    // Group the pairs by wire, keeping the time order on each wire
+    std::stable_sort(
+      hitMatchVec.begin(), hitMatchVec.end(), [](const auto& left, const auto& right) {
+        return left.first->WireID() < right.first->WireID();
+      });
+
     return numPairs;
   }
 
-  void StandardHit3DBuilder::findGoodTriplets(HitMatchPairVecMap& pair12Map,
-                                              HitMatchPairVecMap& pair13Map,
+  void StandardHit3DBuilder::findGoodTriplets(HitMatchPairVec& pair12Vec,
+                                              HitMatchPairVec& pair13Vec,
                                               reco::HitPairList& hitPairList,
                                               bool tagged) const
   {
     // Build triplets from the two lists of hit pairs
-    if (!pair12Map.empty()) {
+    if (!pair12Vec.empty()) {
       // temporary container for dead channel hits
       std::vector<reco::ClusterHit3D> tempDeadChanVec;
       reco::ClusterHit3D deadChanPair;
 
-      // Keep track of which third plane hits have been used
-      std::map<const reco::ClusterHit3D*, bool> usedPairMap;
-
-      // Initial population of this map with the pair13Map hits
-      for (const auto& pair13 : pair13Map) {
-        for (const auto& hit2Dhit3DPair : pair13.second)
-          usedPairMap[&hit2Dhit3DPair.second] = false;
-      }
+      // Keep track of which pairs have been used in a triplet
+      std::vector<bool> used12Vec(pair12Vec.size(), false);
+      std::vector<bool> used13Vec(pair13Vec.size(), false);
 
       // The outer loop is over all hit pairs made from the first two plane combinations
-      for (const auto& pair12 : pair12Map) {
-        if (pair12.second.empty()) continue;
-
-        // This loop is over hit pairs that share the same first two plane wires but may have different
-        // hit times on those wires
-        for (const auto& hit2Dhit3DPair12 : pair12.second) {
-          const reco::ClusterHit3D& pair1 = hit2Dhit3DPair12.second;
+      for (size_t idx12 = 0; idx12 < pair12Vec.size(); idx12++) {
+        const reco::ClusterHit3D& pair1 = pair12Vec[idx12].second;
 
-          // populate the map with initial value
-          usedPairMap[&pair1] = false;
+        // The simplest approach here is to loop over all possibilities and let the triplet builder weed out the weak candidates
+        for (size_t idx13 = 0; idx13 < pair13Vec.size(); idx13++) {
+          const reco::ClusterHit2D* hit2 = pair13Vec[idx13].first;
 
-          // The simplest approach here is to loop over all possibilities and let the triplet builder weed out the weak candidates
-          for (const auto& pair13 : pair13Map) {
-            if (pair13.second.empty()) continue;
+          // If success try for the triplet
+          reco::ClusterHit3D triplet;
 
-            for (const auto& hit2Dhit3DPair13 : pair13.second) {
-              const reco::ClusterHit2D* hit2 = hit2Dhit3DPair13.first;
-              const reco::ClusterHit3D& pair2 = hit2Dhit3DPair13.second;
-
-              // If success try for the triplet
-              reco::ClusterHit3D triplet;
-
-              if (makeHitTriplet(triplet, pair1, hit2)) {
-                triplet.setID(hitPairList.size());
-                hitPairList.emplace_back(triplet);
-                usedPairMap[&pair1] = true;
-                usedPairMap[&pair2] = true;
-              }
-            }
+          if (makeHitTriplet(triplet, pair1, hit2)) {
+            triplet.setID(hitPairList.size());
+            hitPairList.emplace_back(triplet);
+            used12Vec[idx12] = true;
+            used13Vec[idx13] = true;
           }
         }
       }
 
       // One more loop through the other pairs to check for sick channels
       if (m_numBadChannels > 0) {
-        for (const auto& pairMapPair : usedPairMap) {
-          if (pairMapPair.second) continue;
-
-          const reco::ClusterHit3D* pair = pairMapPair.first;
+        auto addDeadChannelPairs = [&](const HitMatchPairVec& pairVec,
+                                       const std::vector<bool>& usedVec) {
+          for (size_t idx = 0; idx < pairVec.size(); idx++) {
+            if (usedVec[idx]) continue;
+
+            // Here we look to see if we failed to make a triplet because the partner wire was dead/noisy/sick
+            if (makeDeadChannelPair(deadChanPair, pairVec[idx].second, 4, 0, 0.))
+              tempDeadChanVec.emplace_back(deadChanPair);
+          }
+        };
 
-          // Here we look to see if we failed to make a triplet because the partner wire was dead/noisy/sick
-          if (makeDeadChannelPair(deadChanPair, *pair, 4, 0, 0.))
-            tempDeadChanVec.emplace_back(deadChanPair);
-        }
+        addDeadChannelPairs(pair12Vec, used12Vec);
+        addDeadChannelPairs(pair13Vec, used13Vec);
 
         // Handle the dead wire triplets
         if (!tempDeadChanVec.empty()) {
@@ -875,117 +935,116 @@ namespace lar_cluster3d {
     bool result(false);
 
     // We assume in this routine that we are looking at hits in different views
-    // The first mission is to check that the wires intersect
+    // The mission is to check that the hit times agree and that the wires intersect
     const geo::WireID& hit1WireID = hit1->WireID();
     const geo::WireID& hit2WireID = hit2->WireID();
 
     geo::WireIDIntersection widIntersect;
 
-    if (m_geometry->WireIDsIntersect(hit1WireID, hit2WireID, widIntersect)) {
-      // Wires intersect so now we can check the timing
-      float hit1Peak = hit1->getTimeTicks();
-      float hit1Sigma = hit1->getHit()->RMS();
-
-      float hit2Peak = hit2->getTimeTicks();
-      float hit2Sigma = hit2->getHit()->RMS();
-
-      // "Long hits" are an issue... so we deal with these differently
-      int hit1NDF = hit1->getHit()->DegreesOfFreedom();
-      int hit2NDF = hit2->getHit()->DegreesOfFreedom();
-
-      // Basically, allow the range to extend to the nearest end of the snippet
-      if (hit1NDF < 2)
-        hit1Sigma = std::min(hit1Peak - float(hit1->getHit()->StartTick()),
-                             float(hit1->getHit()->EndTick()) - hit1Peak);
-      if (hit2NDF < 2)
-        hit2Sigma = std::min(hit2Peak - float(hit2->getHit()->StartTick()),
-                             float(hit2->getHit()->EndTick()) - hit2Peak);
-
-      // The "hit sigma" is the gaussian fit sigma of the hit, we need to expand a bit to allow hit overlap efficiency
-      float hit1Width = hitWidthSclFctr * hit1Sigma;
-      float hit2Width = hitWidthSclFctr * hit2Sigma;
-
-      // Coarse check hit times are "in range"
-      if (fabs(hit1Peak - hit2Peak) <= (hit1Width + hit2Width)) {
-        // Check to see that hit peak times are consistent with each other
-        float hit1SigSq = hit1Sigma * hit1Sigma;
-        float hit2SigSq = hit2Sigma * hit2Sigma;
-        float deltaPeakTime = std::fabs(hit1Peak - hit2Peak);
-        float sigmaPeakTime = std::sqrt(hit1SigSq + hit2SigSq);
-
-        // delta peak time consistency check here
-        if (deltaPeakTime < m_deltaPeakTimeSig *
-                              sigmaPeakTime) // 2 sigma consistency? (do this way to avoid divide)
-        {
-          float oneOverWghts = hit1SigSq * hit2SigSq / (hit1SigSq + hit2SigSq);
-          float avePeakTime = (hit1Peak / hit1SigSq + hit2Peak / hit2SigSq) * oneOverWghts;
-          float totalCharge = hit1->getHit()->Integral() + hit2->getHit()->Integral();
-          float hitChiSquare = std::pow((hit1Peak - avePeakTime), 2) / hit1SigSq +
-                               std::pow((hit2Peak - avePeakTime), 2) / hit2SigSq;
-
-          float xPositionHit1(hit1->getXPosition());
-          float xPositionHit2(hit2->getXPosition());
-          float xPosition = (xPositionHit1 / hit1SigSq + xPositionHit2 / hit2SigSq) * hit1SigSq *
-                            hit2SigSq / (hit1SigSq + hit2SigSq);
-
-          Eigen::Vector3f position(
-            xPosition, float(widIntersect.y), float(widIntersect.z) - m_zPosOffset);
-
-          // If to here then we need to sort out the hit pair code telling what views are used
-          unsigned statusBits = 1 << hit1->WireID().Plane | 1 << hit2->WireID().Plane;
-
-          // handle status bits for the 2D hits
-          if (hit1->getStatusBits() & reco::ClusterHit2D::USEDINPAIR)
-            hit1->setStatusBit(reco::ClusterHit2D::SHAREDINPAIR);
-          if (hit2->getStatusBits() & reco::ClusterHit2D::USEDINPAIR)
-            hit2->setStatusBit(reco::ClusterHit2D::SHAREDINPAIR);
-
-          hit1->setStatusBit(reco::ClusterHit2D::USEDINPAIR);
-          hit2->setStatusBit(reco::ClusterHit2D::USEDINPAIR);
-
-          reco::ClusterHit2DVec hitVector;
-
-          hitVector.resize(3, NULL);
-
-          hitVector[hit1->WireID().Plane] = hit1;
-          hitVector[hit2->WireID().Plane] = hit2;
-
-          unsigned int cryostatIdx = hit1->WireID().Cryostat;
-          unsigned int tpcIdx = hit1->WireID().TPC;
-
-          // Initialize the wireIdVec
-          std::vector<geo::WireID> wireIDVec = {geo::WireID(cryostatIdx, tpcIdx, 0, 0),
-                                                geo::WireID(cryostatIdx, tpcIdx, 1, 0),
-                                                geo::WireID(cryostatIdx, tpcIdx, 2, 0)};
-
-          wireIDVec[hit1->WireID().Plane] = hit1->WireID();
-          wireIDVec[hit2->WireID().Plane] = hit2->WireID();
-
-          // For compiling at the moment
-          std::vector<float> hitDelTSigVec = {0., 0., 0.};
-
-          hitDelTSigVec[hit1->WireID().Plane] = deltaPeakTime / sigmaPeakTime;
-          hitDelTSigVec[hit2->WireID().Plane] = deltaPeakTime / sigmaPeakTime;
-
-          // Create the 3D cluster hit
-          hitPair.initialize(hitPairCntr,
-                             statusBits,
-                             position,
-                             totalCharge,
-                             avePeakTime,
-                             deltaPeakTime,
-                             sigmaPeakTime,
-                             hitChiSquare,
-                             0.,
-                             0.,
-                             0.,
-                             0.,
-                             hitVector,
-                             hitDelTSigVec,
-                             wireIDVec);
-
-          result = true;
-        }
+    // The timing is checked first, it is much cheaper than the wire intersection
+    float hit1Peak = hit1->getTimeTicks();
+    float hit1Sigma = hit1->getHit()->RMS();
+
+    float hit2Peak = hit2->getTimeTicks();
+    float hit2Sigma = hit2->getHit()->RMS();
+
+    // "Long hits" are an issue... so we deal with these differently
+    int hit1NDF = hit1->getHit()->DegreesOfFreedom();
+    int hit2NDF = hit2->getHit()->DegreesOfFreedom();
+
+    // Basically, allow the range to extend to the nearest end of the snippet
+    if (hit1NDF < 2)
+      hit1Sigma = std::min(hit1Peak - float(hit1->getHit()->StartTick()),
+                           float(hit1->getHit()->EndTick()) - hit1Peak);
+    if (hit2NDF < 2)
+      hit2Sigma = std::min(hit2Peak - float(hit2->getHit()->StartTick()),
+                           float(hit2->getHit()->EndTick()) - hit2Peak);
+
+    // The "hit sigma" is the gaussian fit sigma of the hit, we need to expand a bit to allow hit overlap efficiency
+    float hit1Width = hitWidthSclFctr * hit1Sigma;
+    float hit2Width = hitWidthSclFctr * hit2Sigma;
+
+    // Coarse check hit times are "in range"
+    if (fabs(hit1Peak - hit2Peak) <= (hit1Width + hit2Width)) {
+      // Check to see that hit peak times are consistent with each other
+      float hit1SigSq = hit1Sigma * hit1Sigma;
+      float hit2SigSq = hit2Sigma * hit2Sigma;
+      float deltaPeakTime = std::fabs(hit1Peak - hit2Peak);
+      float sigmaPeakTime = std::sqrt(hit1SigSq + hit2SigSq);
+
+      // delta peak time consistency check here (2 sigma consistency? do this way to avoid
+      // divide), then check that the wires intersect
+      if (deltaPeakTime < m_deltaPeakTimeSig * sigmaPeakTime &&
+          m_geometryCache->MayIntersect(hit1WireID, hit2WireID) &&
+          m_geometry->WireIDsIntersect(hit1WireID, hit2WireID, widIntersect)) {
+        float oneOverWghts = hit1SigSq * hit2SigSq / (hit1SigSq + hit2SigSq);
+        float avePeakTime = (hit1Peak / hit1SigSq + hit2Peak / hit2SigSq) * oneOverWghts;
+        float totalCharge = hit1->getHit()->Integral() + hit2->getHit()->Integral();
+        float hitChiSquare = std::pow((hit1Peak - avePeakTime), 2) / hit1SigSq +
+                             std::pow((hit2Peak - avePeakTime), 2) / hit2SigSq;
+
+        float xPositionHit1(hit1->getXPosition());
+        float xPositionHit2(hit2->getXPosition());
+        float xPosition = (xPositionHit1 / hit1SigSq + xPositionHit2 / hit2SigSq) * hit1SigSq *
+                          hit2SigSq / (hit1SigSq + hit2SigSq);
+
+        Eigen::Vector3f position(
+          xPosition, float(widIntersect.y), float(widIntersect.z) - m_zPosOffset);
+
+        // If to here then we need to sort out the hit pair code telling what views are used
+        unsigned statusBits = 1 << hit1->WireID().Plane | 1 << hit2->WireID().Plane;
+
+        // handle status bits for the 2D hits
+        if (hit1->getStatusBits() & reco::ClusterHit2D::USEDINPAIR)
+          hit1->setStatusBit(reco::ClusterHit2D::SHAREDINPAIR);
+        if (hit2->getStatusBits() & reco::ClusterHit2D::USEDINPAIR)
+          hit2->setStatusBit(reco::ClusterHit2D::SHAREDINPAIR);
+
+        hit1->setStatusBit(reco::ClusterHit2D::USEDINPAIR);
+        hit2->setStatusBit(reco::ClusterHit2D::USEDINPAIR);
+
+        reco::ClusterHit2DVec hitVector;
+
+        hitVector.resize(3, NULL);
+
+        hitVector[hit1->WireID().Plane] = hit1;
+        hitVector[hit2->WireID().Plane] = hit2;
+
+        unsigned int cryostatIdx = hit1->WireID().Cryostat;
+        unsigned int tpcIdx = hit1->WireID().TPC;
+
+        // Initialize the wireIdVec
+        std::vector<geo::WireID> wireIDVec = {geo::WireID(cryostatIdx, tpcIdx, 0, 0),
+                                              geo::WireID(cryostatIdx, tpcIdx, 1, 0),
+                                              geo::WireID(cryostatIdx, tpcIdx, 2, 0)};
+
+        wireIDVec[hit1->WireID().Plane] = hit1->WireID();
+        wireIDVec[hit2->WireID().Plane] = hit2->WireID();
+
+        // For compiling at the moment
+        std::vector<float> hitDelTSigVec = {0., 0., 0.};
+
+        hitDelTSigVec[hit1->WireID().Plane] = deltaPeakTime / sigmaPeakTime;
+        hitDelTSigVec[hit2->WireID().Plane] = deltaPeakTime / sigmaPeakTime;
+
+        // Create the 3D cluster hit
+        hitPair.initialize(hitPairCntr,
+                           statusBits,
+                           position,
+                           totalCharge,
+                           avePeakTime,
+                           deltaPeakTime,
+                           sigmaPeakTime,
+                           hitChiSquare,
+                           0.,
+                           0.,
+                           0.,
+                           0.,
+                           hitVector,
+                           hitDelTSigVec,
+                           wireIDVec);
+
+        result = true;
       }
     }
 
@@ -1315,10 +1374,12 @@ namespace lar_cluster3d {
       // Want to refine position since we "know" the missing wire
       geo::WireIDIntersection widIntersect0;
 
-      if (m_geometry->WireIDsIntersect(wireID0, wireID, widIntersect0)) {
+      if (m_geometryCache->MayIntersect(wireID0, wireID) &&
+          m_geometry->WireIDsIntersect(wireID0, wireID, widIntersect0)) {
         geo::WireIDIntersection widIntersect1;
 
-        if (m_geometry->WireIDsIntersect(wireID1, wireID, widIntersect1)) {
+        if (m_geometryCache->MayIntersect(wireID1, wireID) &&
+            m_geometry->WireIDsIntersect(wireID1, wireID, widIntersect1)) {
           Eigen::Vector3f newPosition(
             pair.getPosition()[0], pair.getPosition()[1], pair.getPosition()[2]);
 
@@ -1578,7 +1639,7 @@ namespace lar_cluster3d {
 
       // For some detectors we can have multiple wire ID's associated to a given channel.
       // So we recover the list of these wire IDs
-      const std::vector<geo::WireID>& wireIDs = m_geometry->ChannelToWire(recobHit->Channel());
+      const auto wireIDs = m_geometryCache->ChannelToWire(recobHit->Channel());
 
       // And then loop over all possible to build out our maps
       for (const auto& wireID : wireIDs) {
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "TCanvas.h"
@@ -25,6 +27,60 @@
 
 namespace {
   constexpr double PI{3.14159265};
+
+  // Index of the point with the smallest sum of distances to all the points (the first
+  // one on ties), or -1 if there are none. Every sum is accumulated in point order, so
+  // the complete sums are the ones of the plain double loop; a candidate is dropped as
+  // soon as its partial sum exceeds the best complete one, which is safe because the
+  // partial sums never decrease. Candidates near the centroid are tried first, so that
+  // the bound becomes tight early.
+  int MinDistanceSumIndex(const std::vector<std::pair<double, double>>& points)
+  {
+    size_t const n = points.size();
+    if (n == 0) return -1;
+
+    auto distanceSum = [&points](size_t z, double bound) {
+      double sum = 0;
+      for (auto const& p : points) {
+        sum += std::hypot(points[z].first - p.first, points[z].second - p.second);
+        if (sum > bound) break;
+      }
+      return sum;
+    };
+
+    bool const finite = std::all_of(points.begin(), points.end(), [](auto const& p) {
+      return std::isfinite(p.first) && std::isfinite(p.second);
+    });
+    if (!finite) { // keep the exact behaviour of the full scan with NaN around
+      std::vector<double> sums(n);
+      for (size_t z = 0; z < n; ++z)
+        sums[z] = distanceSum(z, std::numeric_limits<double>::infinity());
+      return std::min_element(sums.begin(), sums.end()) - sums.begin();
+    }
+
+    double cx = 0, cy = 0;
+    for (auto const& p : points) {
+      cx += p.first / n;
+      cy += p.second / n;
+    }
+    std::vector<std::pair<double, size_t>> order;
+    order.reserve(n);
+    for (size_t z = 0; z < n; ++z)
+      order.emplace_back(std::hypot(points[z].first - cx, points[z].second - cy), z);
+    std::sort(order.begin(), order.end());
+
+    size_t best = n;
+    double bestSum = std::numeric_limits<double>::infinity();
+    for (auto const& candidate : order) {
+      size_t const z = candidate.second;
+      double const sum = distanceSum(z, bestSum);
+      if (best == n || sum < bestSum || (sum == bestSum && z < best)) {
+        best = z;
+        bestSum = sum;
+      }
+    }
+    return best;
+  }
 }
 
 namespace cluster {
@@ -46,6 +102,11 @@ namespace cluster {
   }
 
   int ClusterParamsAlg::SetHits(const std::vector<util::PxHit>& inhitlist)
+  {
+    return SetHits(std::vector<util::PxHit>(inhitlist));
+  }
+
+  int ClusterParamsAlg::SetHits(std::vector<util::PxHit>&& inhitlist)
   {
     Initialize();
 
@@ -56,9 +117,7 @@ namespace cluster {
       return -1;
     }
 
-    fHitVector.reserve(inhitlist.size());
-    for (auto h : inhitlist)
-      fHitVector.push_back(h);
+    fHitVector = std::move(inhitlist);
 
     fPlane = fHitVector[0].plane;
 
@@ -203,7 +262,8 @@ namespace cluster {
 
     fParams.N_Hits = fHitVector.size();
 
-    std::map<double, int> wireMap;
+    std::vector<double> wires;
+    wires.reserve(fHitVector.size());
 
     lar::util::StatCollector<double> charge, sumADC;
 
@@ -219,9 +279,16 @@ namespace cluster {
       charge.add(hit.charge);
       sumADC.add(hit.sumADC);
 
-      if (wireMap[hit.w] == 0) { uniquewires++; }
-      if (wireMap[hit.w] == 1) { multi_hit_wires++; }
-      wireMap[hit.w]++;
+      wires.push_back(hit.w);
+    }
+
+    // count the distinct wires, and those with more than one hit
+    std::sort(wires.begin(), wires.end());
+    for (auto iWire = wires.begin(); iWire != wires.end();) {
+      auto const iNext = std::upper_bound(iWire, wires.end(), *iWire);
+      uniquewires++;
+      if (iNext - iWire > 1) multi_hit_wires++;
+      iWire = iNext;
     }
 
     fParams.sum_charge = charge.Sum();
@@ -738,8 +805,6 @@ namespace cluster {
     double avgtime = averageHit.t;
     //vertex in tilda-space pair(x-til,y-til)
     std::vector<std::pair<double, double>> vertil;
-    //vector of the sum of the distance of a vector to every vertex in tilda-space
-    std::vector<double> vs;
     // $$This needs to be corrected//this is the good hits that are between strip
     std::vector<const util::PxHit*> ghits;
     ghits.reserve(subhit.size());
@@ -769,17 +834,11 @@ namespace cluster {
         } //if Wires are not the same
       }   //for over b
     }     //for over a
-    // look at the distance from a tilda-vertex to all other tilda-verticies
-    for (unsigned int z = 0; z < vertil.size(); z++) {
-      double vd = 0; //the distance for vertex... just needs to be something 0
-      for (unsigned int c = 0; c < vertil.size(); c++)
-        vd += std::hypot(vertil.at(z).first - vertil.at(c).first,
-                         vertil.at(z).second - vertil.at(c).second);
-      vs.push_back(vd);
-      vd = 0.0;
-    } //for z loop
-
-    if (vs.size() == 0) //al hits on same wire?!
+    // look at the distance from a tilda-vertex to all other tilda-verticies and
+    // find the min of the sum: this will get me the area where things are most linear
+    int minvs = MinDistanceSumIndex(vertil);
+
+    if (minvs < 0) //al hits on same wire?!
     {
       if (verbose)
         std::cout << "vertil list is empty. all subhits are on the same wire?" << std::endl;
@@ -792,9 +851,6 @@ namespace cluster {
       fTimeRecord_ProcTime.push_back(localWatch.RealTime());
       return;
     }
-    //need to find the min of the distance of vertex in tilda-space
-    //this will get me the area where things are most linear
-    int minvs = std::min_element(vs.begin(), vs.end()) - vs.begin();
     // now use the min position to find the vertex in tilda-space
     //now need to look a which hits are between the tilda lines from the points
     //in the tilda space everything in wire time is based on the new origin which is at the average wire/time
@@ -33,6 +33,8 @@ namespace cluster {
     size_t MinNHits() const { return fMinNHits; }
 
     int SetHits(const std::vector<util::PxHit>&);
+    /// Same as above, taking over the hit list instead of copying it
+    int SetHits(std::vector<util::PxHit>&&);
 
     void SetRefineDirectionQMin(double qmin) { fQMinRefDir = qmin; }
 
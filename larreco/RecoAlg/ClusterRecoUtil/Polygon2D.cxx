@@ -1,6 +1,7 @@
 #include "Polygon2D.h"
 
 #include <iostream>
+#include <limits>
 #include <math.h>
 
 //------------------------------------------------
@@ -67,6 +68,7 @@ Polygon2D::Polygon2D(const Polygon2D& poly1, const Polygon2D& poly2)
   if (!(poly1.PolyOverlap(poly2))) {
     std::vector<std::pair<float, float>> nullpoint;
     vertices = nullpoint;
+    UpdateCache();
     return;
   }
 
@@ -111,9 +113,51 @@ Polygon2D::Polygon2D(const Polygon2D& poly1, const Polygon2D& poly2)
   }   //for all segments in poly1
 
   vertices = IntersectionPoints;
+  UpdateCache();
   return;
 }
 
+//-----------------------------
+void Polygon2D::UpdateCache()
+{
+  xs.clear();
+  ys.clear();
+  boxMin.first = boxMin.second = std::numeric_limits<float>::infinity();
+  boxMax.first = boxMax.second = -std::numeric_limits<float>::infinity();
+  if (vertices.empty()) return;
+
+  xs.reserve(vertices.size() + 1);
+  ys.reserve(vertices.size() + 1);
+  for (auto const& v : vertices) {
+    xs.push_back(v.first);
+    ys.push_back(v.second);
+    //NaN coordinates never compare, so they stay out of the box
+    if (v.first < boxMin.first) boxMin.first = v.first;
+    if (v.first > boxMax.first) boxMax.first = v.first;
+    if (v.second < boxMin.second) boxMin.second = v.second;
+    if (v.second > boxMax.second) boxMax.second = v.second;
+  }
+  xs.push_back(vertices.front().first);
+  ys.push_back(vertices.front().second);
+}
+
+//-------------------------------------------------------------------------
+double Polygon2D::VertexDistSqrdLowerBound(const Polygon2D& poly2) const
+{
+  //every vertex coordinate difference is at least as large as the gap between the
+  //boxes, and float rounding, squaring and summing all preserve that order
+  float dx = 0, dy = 0;
+  if (boxMax.first < poly2.boxMin.first)
+    dx = poly2.boxMin.first - boxMax.first;
+  else if (poly2.boxMax.first < boxMin.first)
+    dx = boxMin.first - poly2.boxMax.first;
+  if (boxMax.second < poly2.boxMin.second)
+    dy = poly2.boxMin.second - boxMax.second;
+  else if (poly2.boxMax.second < boxMin.second)
+    dy = boxMin.second - poly2.boxMax.second;
+  return pow(dx, 2) + pow(dy, 2);
+}
+
 //---------------------------
 float Polygon2D::Area() const
 {
@@ -249,19 +293,20 @@ bool Polygon2D::PolyOverlapSegments(const Polygon2D& poly2) const
   //if contained in one another then they also overlap:
   if ((this->Contained(poly2)) or (poly2.Contained(*this))) { return true; }
   //loop over the two polygons checking wehther
-  //two segments ever intersect
-  for (unsigned int i = 0; i < this->Size(); i++) {
-    for (unsigned int j = 0; j < poly2.Size(); j++) {
-      if (SegmentOverlap(this->Point(i).first,
-                         this->Point(i).second,
-                         this->Point(i + 1).first,
-                         this->Point(i + 1).second,
-                         poly2.Point(j).first,
-                         poly2.Point(j).second,
-                         poly2.Point(j + 1).first,
-                         poly2.Point(j + 1).second)) {
+  //two segments ever intersect: this is SegmentOverlap() on all pairs, but the side
+  //of each vertex of this polygon with respect to a segment of poly2 is computed once
+  //and shared by the two segments it belongs to
+  if (!Size()) return false;
+  for (unsigned int j = 0; j < poly2.Size(); j++) {
+    double const Cx = poly2.xs[j], Cy = poly2.ys[j];
+    double const Dx = poly2.xs[j + 1], Dy = poly2.ys[j + 1];
+    bool sideA = Clockwise(xs[0], ys[0], Cx, Cy, Dx, Dy);
+    for (unsigned int i = 0; i < Size(); i++) {
+      bool const sideB = Clockwise(xs[i + 1], ys[i + 1], Cx, Cy, Dx, Dy);
+      if ((sideA != sideB) and (Clockwise(xs[i], ys[i], xs[i + 1], ys[i + 1], Cx, Cy) !=
+                                Clockwise(xs[i], ys[i], xs[i + 1], ys[i + 1], Dx, Dy)))
         return true;
-      }
+      sideA = sideB;
     }
   }
   return false;
@@ -274,17 +319,19 @@ bool Polygon2D::PointInside(const std::pair<float, float>& point) const
   //any ray originating at point will cross polygon
   //even number of times if point outside
   //odd number of times if point inside
+  //(the ray is cut towards (10000,10000), and the side of each vertex with respect
+  //to it is computed once for the two segments sharing that vertex)
+  if (!Size()) return false;
+  double const Cx = 10000.0, Cy = 10000.0;
+  double const Dx = point.first, Dy = point.second;
   int intersections = 0;
+  bool sideA = Clockwise(xs[0], ys[0], Cx, Cy, Dx, Dy);
   for (unsigned int i = 0; i < this->Size(); i++) {
-    if (SegmentOverlap(this->Point(i).first,
-                       this->Point(i).second,
-                       this->Point(i + 1).first,
-                       this->Point(i + 1).second,
-                       10000.0,
-                       10000.0,
-                       point.first,
-                       point.second))
+    bool const sideB = Clockwise(xs[i + 1], ys[i + 1], Cx, Cy, Dx, Dy);
+    if ((sideA != sideB) and (Clockwise(xs[i], ys[i], xs[i + 1], ys[i + 1], Cx, Cy) !=
+                              Clockwise(xs[i], ys[i], xs[i + 1], ys[i + 1], Dx, Dy)))
       intersections += 1;
+    sideA = sideB;
   }
   if ((intersections % 2) == 0)
     return false;
@@ -336,4 +383,5 @@ void Polygon2D::UntanglePolygon()
       }
     } //second loop
   }   //first loop
+  UpdateCache();
 }
@@ -15,6 +15,7 @@
 #ifndef RECOTOOL_POLYGON2D_H
 #define RECOTOOL_POLYGON2D_H
 
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -34,9 +35,21 @@ class Polygon2D {
 private:
   std::vector<std::pair<float, float>> vertices;
 
+  //vertex coordinates in separate arrays, with the first vertex repeated at the end,
+  //and the bounding box of the vertices; they are updated whenever vertices change
+  std::vector<double> xs, ys;
+  std::pair<float, float> boxMin{std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::infinity()};
+  std::pair<float, float> boxMax{-std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity()};
+  void UpdateCache();
+
 public:
   Polygon2D() {}
-  Polygon2D(const std::vector<std::pair<float, float>>& points) { vertices = points; }
+  Polygon2D(const std::vector<std::pair<float, float>>& points) : vertices(points)
+  {
+    UpdateCache();
+  }
   Polygon2D(const Polygon2D& poly1, const Polygon2D& poly2); /// Create Intersection Polygon
   unsigned int Size() const { return vertices.size(); }
   const std::pair<float, float>& Point(unsigned int p) const;
@@ -49,6 +62,13 @@ public:
   bool PointInside(const std::pair<float, float>& point) const;
   bool Contained(const Polygon2D& poly2) const; /// check if poly2 is inside poly1
   void UntanglePolygon();
+  /// lower corner of the bounding box (+infinity if there are no vertices)
+  const std::pair<float, float>& BoxMin() const { return boxMin; }
+  /// upper corner of the bounding box (-infinity if there are no vertices)
+  const std::pair<float, float>& BoxMax() const { return boxMax; }
+  /// lower bound from the bounding boxes on pow(dx,2)+pow(dy,2), with dx and dy the float
+  /// coordinate differences between a vertex of this polygon and a vertex of poly2
+  double VertexDistSqrdLowerBound(const Polygon2D& poly2) const;
 };
 /** @} */ // end of doxygen group
 
@@ -1,6 +1,5 @@
 #include "larreco/RecoAlg/DBScan3DAlg.h"
 #include "larcore/Geometry/Geometry.h"
-#include "larcorealg/CoreUtils/NumericUtils.h" // util::absDiff()
 #include "larcorealg/Geometry/GeometryCore.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/SpacePoint.h"
@@ -11,9 +10,14 @@
 #include "cetlib/pow.h"
 #include "fhiclcpp/ParameterSet.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
-#include <stdio.h>
-#include <stdlib.h>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
 
 cluster::DBScan3DAlg::DBScan3DAlg(fhicl::ParameterSet const& pset)
   : epsilon(pset.get<float>("epsilon"))
@@ -30,25 +34,7 @@ void cluster::DBScan3DAlg::init(const std::vector<art::Ptr<recob::SpacePoint>>&
                                 art::FindManyP<recob::Hit>& hitFromSp)
 {
 
-  if (badchannelmap.empty()) {
-    lariov::ChannelStatusProvider const& channelStatus =
-      art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
-    geo::GeometryCore const* geom = &*(art::ServiceHandle<geo::Geometry const>());
-    // build a map to count bad channels around each wire ID
-    for (auto& pid : geom->Iterate<geo::PlaneID>()) {
-      for (auto& wid1 : geom->Iterate<geo::WireID>(pid)) {
-        unsigned int nbadchs = 0;
-        for (auto& wid2 : geom->Iterate<geo::WireID>(pid)) {
-          if (wid1 == wid2) continue;
-          if (lar::util::absDiff(wid1.Wire, wid2.Wire) < neighbors &&
-              !channelStatus.IsGood(geom->PlaneWireToChannel(wid2)))
-            ++nbadchs;
-        }
-        badchannelmap[wid1] = nbadchs;
-      }
-    }
-    std::cout << "Done building bad channel map." << std::endl;
-  }
+  if (badchannelmap.empty()) build_bad_channel_map();
 
   points.clear();
   for (auto& spt : sps) {
@@ -59,80 +45,151 @@ void cluster::DBScan3DAlg::init(const std::vector<art::Ptr<recob::SpacePoint>>&
     point.nbadchannels = 0;
     auto& hits = hitFromSp.at(spt.key());
     for (auto& hit : hits) {
-      point.nbadchannels += badchannelmap[hit->WireID()];
+      point.nbadchannels += bad_channels(hit->WireID());
     }
     points.push_back(point);
   }
 }
 
-node_t* cluster::DBScan3DAlg::create_node(unsigned int index)
+//----------------------------------------------------------
+void cluster::DBScan3DAlg::build_bad_channel_map()
 {
-  node_t* n = (node_t*)calloc(1, sizeof(node_t));
-  if (n == NULL)
-    perror("Failed to allocate node.");
-  else {
-    n->index = index;
-    n->next = NULL;
+  lariov::ChannelStatusProvider const& channelStatus =
+    art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
+  geo::GeometryCore const* geom = &*(art::ServiceHandle<geo::Geometry const>());
+  // count bad channels around each wire ID from a running sum of the bad channels of the plane
+  for (auto& pid : geom->Iterate<geo::PlaneID>()) {
+    unsigned int const nwires = geom->Nwires(pid);
+    std::vector<unsigned int> badsum(nwires + 1, 0);
+    for (auto& wid : geom->Iterate<geo::WireID>(pid))
+      badsum[wid.Wire + 1] =
+        badsum[wid.Wire] + (channelStatus.IsGood(geom->PlaneWireToChannel(wid)) ? 0 : 1);
+
+    auto& nbadchs = badchannelmap[pid];
+    nbadchs.assign(nwires, 0);
+    if (neighbors == 0) continue;
+    for (unsigned int wire = 0; wire < nwires; ++wire) {
+      // wires closer than `neighbors`, not counting the wire itself
+      unsigned int const first = wire < neighbors - 1 ? 0 : wire - (neighbors - 1);
+      unsigned int const last = std::min(nwires - 1, wire + (neighbors - 1));
+      nbadchs[wire] = badsum[last + 1] - badsum[first] - (badsum[wire + 1] - badsum[wire]);
+    }
   }
-  return n;
+  std::cout << "Done building bad channel map." << std::endl;
 }
 
-int cluster::DBScan3DAlg::append_at_end(unsigned int index, epsilon_neighbours_t* en)
+unsigned int cluster::DBScan3DAlg::bad_channels(geo::WireID const& wid) const
 {
-  node_t* n = create_node(index);
-  if (n == NULL) {
-    free(en);
-    return FAILURE;
-  }
-  if (en->head == NULL) {
-    en->head = n;
-    en->tail = n;
-  }
-  else {
-    en->tail->next = n;
-    en->tail = n;
-  }
-  ++(en->num_members);
-  return SUCCESS;
+  auto const itr = badchannelmap.find(wid.asPlaneID());
+  if (itr == badchannelmap.end() || wid.Wire >= itr->second.size()) return 0;
+  return itr->second[wid.Wire];
 }
 
-epsilon_neighbours_t* cluster::DBScan3DAlg::get_epsilon_neighbours(unsigned int index)
+//----------------------------------------------------------
+void cluster::DBScan3DAlg::find_neighbours()
 {
-  epsilon_neighbours_t* en = (epsilon_neighbours_t*)calloc(1, sizeof(epsilon_neighbours_t));
-  if (en == NULL) {
-    perror("Failed to allocate epsilon neighbours.");
-    return en;
+  unsigned int const npts = points.size();
+  neighbours_begin.assign(npts + 1, 0);
+  neighbours.clear();
+  if (npts == 0) return;
+
+  // Points are binned in cubic cells of side sqrt(epsilon). A point is compared only with the
+  // points of the cells that overlap the cube around it which contains every point that can
+  // pass the distance cut; the bad channel term of dist() widens it, so its half size is
+  // computed with the largest bad channel count of all points, plus a small margin.
+  double const cell = epsilon > 0 ? std::sqrt(epsilon) : 1.;
+  unsigned int maxbad = 0;
+  double lo[3], hi[3];
+  for (unsigned int k = 0; k < 3; ++k) {
+    lo[k] = points[0].sp->XYZ()[k];
+    hi[k] = lo[k];
   }
-  for (unsigned int i = 0; i < points.size(); ++i) {
-    if (i == index) continue;
-    if (dist(&points[index], &points[i]) > epsilon)
-      continue;
-    else {
-      if (append_at_end(i, en) == FAILURE) {
-        destroy_epsilon_neighbours(en);
-        en = NULL;
-        break;
-      }
+  for (auto const& point : points) {
+    maxbad = std::max(maxbad, point.nbadchannels);
+    for (unsigned int k = 0; k < 3; ++k) {
+      lo[k] = std::min(lo[k], double(point.sp->XYZ()[k]));
+      hi[k] = std::max(hi[k], double(point.sp->XYZ()[k]));
     }
   }
-  return en;
-}
 
-void cluster::DBScan3DAlg::destroy_epsilon_neighbours(epsilon_neighbours_t* en)
-{
-  if (en) {
-    node_t *t, *h = en->head;
-    while (h) {
-      t = h->next;
-      free(h);
-      h = t;
-    }
-    free(en);
+  int64_t ncells[3];
+  for (unsigned int k = 0; k < 3; ++k)
+    ncells[k] = int64_t((hi[k] - lo[k]) / cell) + 1;
+  auto cellIndex = [&](double x, unsigned int k) {
+    return std::clamp(int64_t(std::floor((x - lo[k]) / cell)), int64_t(0), ncells[k] - 1);
+  };
+  auto cellKey = [&](int64_t ix, int64_t iy, int64_t iz) {
+    return uint64_t(ix) + uint64_t(ncells[0]) * (uint64_t(iy) + uint64_t(ncells[1]) * uint64_t(iz));
+  };
+
+  // points sorted by cell, and the range of each occupied cell
+  std::vector<std::pair<uint64_t, unsigned int>> cellPoints(npts);
+  for (unsigned int i = 0; i < npts; ++i) {
+    Double32_t const* xyz = points[i].sp->XYZ();
+    auto const key = cellKey(cellIndex(xyz[0], 0), cellIndex(xyz[1], 1), cellIndex(xyz[2], 2));
+    cellPoints[i] = {key, i};
+  }
+  std::sort(cellPoints.begin(), cellPoints.end());
+  std::unordered_map<uint64_t, std::pair<unsigned int, unsigned int>> cells;
+  for (unsigned int i = 0; i < npts; ++i) {
+    auto& range = cells.try_emplace(cellPoints[i].first, i, i).first->second;
+    range.second = i + 1;
   }
+
+  // calls f(j) for every other point j which may be an epsilon neighbour of point i
+  auto forEachCandidate = [&](unsigned int i, auto&& f) {
+    Double32_t const* xyz = points[i].sp->XYZ();
+    double const reach = (points[i].nbadchannels + maxbad) * badchannelweight;
+    double const halfSize = std::sqrt(epsilon + reach * reach) * (1. + 1e-6) + 1e-6;
+    int64_t first[3], last[3];
+    for (unsigned int k = 0; k < 3; ++k) {
+      first[k] = cellIndex(xyz[k] - halfSize, k);
+      last[k] = cellIndex(xyz[k] + halfSize, k);
+    }
+    for (int64_t iz = first[2]; iz <= last[2]; ++iz)
+      for (int64_t iy = first[1]; iy <= last[1]; ++iy)
+        for (int64_t ix = first[0]; ix <= last[0]; ++ix) {
+          auto const itr = cells.find(cellKey(ix, iy, iz));
+          if (itr == cells.end()) continue;
+          for (unsigned int c = itr->second.first; c < itr->second.second; ++c) {
+            unsigned int const j = cellPoints[c].second;
+            if (j != i) f(j);
+          }
+        }
+  };
+
+  // count the neighbours, then fill them in index order at the offsets of each point
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, npts),
+                    [&](tbb::blocked_range<unsigned int> const& r) {
+                      for (unsigned int i = r.begin(); i != r.end(); ++i) {
+                        size_t n = 0;
+                        forEachCandidate(i, [&](unsigned int j) {
+                          if (!(dist(&points[i], &points[j]) > epsilon)) ++n;
+                        });
+                        neighbours_begin[i + 1] = n;
+                      }
+                    });
+  for (unsigned int i = 0; i < npts; ++i)
+    neighbours_begin[i + 1] += neighbours_begin[i];
+  neighbours.resize(neighbours_begin[npts]);
+
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, npts),
+                    [&](tbb::blocked_range<unsigned int> const& r) {
+                      for (unsigned int i = r.begin(); i != r.end(); ++i) {
+                        size_t n = neighbours_begin[i];
+                        forEachCandidate(i, [&](unsigned int j) {
+                          if (!(dist(&points[i], &points[j]) > epsilon)) neighbours[n++] = j;
+                        });
+                        std::sort(neighbours.begin() + neighbours_begin[i],
+                                  neighbours.begin() + neighbours_begin[i + 1]);
+                      }
+                    });
 }
 
 void cluster::DBScan3DAlg::dbscan()
 {
+  find_neighbours();
+
   unsigned int i, cluster_id = 0;
   for (i = 0; i < points.size(); ++i) {
     if (points[i].cluster_id == UNCLASSIFIED) {
@@ -143,61 +200,37 @@ void cluster::DBScan3DAlg::dbscan()
 
 int cluster::DBScan3DAlg::expand(unsigned int index, unsigned int cluster_id)
 {
-  int return_value = NOT_CORE_POINT;
-  epsilon_neighbours_t* seeds = get_epsilon_neighbours(index);
-  if (seeds == NULL) return FAILURE;
-
-  if (seeds->num_members < minpts)
+  if (num_neighbours(index) < minpts) {
     points[index].cluster_id = NOISE;
-  else {
-    points[index].cluster_id = cluster_id;
-    node_t* h = seeds->head;
-    while (h) {
-      points[h->index].cluster_id = cluster_id;
-      h = h->next;
-    }
+    return NOT_CORE_POINT;
+  }
 
-    h = seeds->head;
-    while (h) {
-      spread(h->index, seeds, cluster_id);
-      h = h->next;
-    }
+  points[index].cluster_id = cluster_id;
+  seeds.assign(neighbours.begin() + neighbours_begin[index],
+               neighbours.begin() + neighbours_begin[index + 1]);
+  for (auto const seed : seeds)
+    points[seed].cluster_id = cluster_id;
 
-    return_value = CORE_POINT;
-  }
-  destroy_epsilon_neighbours(seeds);
-  return return_value;
+  // seeds found by spread() are appended and visited in turn
+  for (size_t s = 0; s < seeds.size(); ++s)
+    spread(seeds[s], cluster_id);
+
+  return CORE_POINT;
 }
 
-int cluster::DBScan3DAlg::spread(unsigned int index,
-                                 epsilon_neighbours_t* seeds,
-                                 unsigned int cluster_id)
+void cluster::DBScan3DAlg::spread(unsigned int index, unsigned int cluster_id)
 {
-  epsilon_neighbours_t* spread = get_epsilon_neighbours(index);
-  if (spread == NULL) return FAILURE;
-  if (spread->num_members >= minpts) {
-    node_t* n = spread->head;
-    point_t* d;
-    while (n) {
-      d = &points[n->index];
-      if (d->cluster_id == NOISE || d->cluster_id == UNCLASSIFIED) {
-        if (d->cluster_id == UNCLASSIFIED) {
-          if (append_at_end(n->index, seeds) == FAILURE) {
-            destroy_epsilon_neighbours(spread);
-            return FAILURE;
-          }
-        }
-        d->cluster_id = cluster_id;
-      }
-      n = n->next;
+  if (num_neighbours(index) < minpts) return;
+  for (size_t n = neighbours_begin[index]; n < neighbours_begin[index + 1]; ++n) {
+    point_t* d = &points[neighbours[n]];
+    if (d->cluster_id == NOISE || d->cluster_id == UNCLASSIFIED) {
+      if (d->cluster_id == UNCLASSIFIED) seeds.push_back(neighbours[n]);
+      d->cluster_id = cluster_id;
     }
   }
-
-  destroy_epsilon_neighbours(spread);
-  return SUCCESS;
 }
 
-float cluster::DBScan3DAlg::dist(point_t* a, point_t* b) const
+float cluster::DBScan3DAlg::dist(point_t const* a, point_t const* b) const
 {
   Double32_t const* a_xyz = a->sp->XYZ();
   Double32_t const* b_xyz = b->sp->XYZ();
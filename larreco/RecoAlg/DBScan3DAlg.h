@@ -60,18 +60,6 @@ struct point_s {
   int cluster_id;
 };
 
-typedef struct node_s node_t;
-struct node_s {
-  unsigned int index;
-  node_t* next;
-};
-
-typedef struct epsilon_neighbours_s epsilon_neighbours_t;
-struct epsilon_neighbours_s {
-  unsigned int num_members;
-  node_t *head, *tail;
-};
-
 namespace cluster {
 
   //---------------------------------------------------------------
@@ -90,15 +78,25 @@ namespace cluster {
     unsigned int minpts;
     double badchannelweight;
     unsigned int neighbors;
-    std::map<geo::WireID, int> badchannelmap;
-
-    node_t* create_node(unsigned int index);
-    int append_at_end(unsigned int index, epsilon_neighbours_t* en);
-    epsilon_neighbours_t* get_epsilon_neighbours(unsigned int index);
-    void destroy_epsilon_neighbours(epsilon_neighbours_t* en);
+    // number of bad channels less than `neighbors` wires away from each wire of a plane
+    std::map<geo::PlaneID, std::vector<unsigned int>> badchannelmap;
+
+    // the epsilon neighbours of point i, in index order, are
+    // neighbours[neighbours_begin[i]] ... neighbours[neighbours_begin[i + 1] - 1]
+    std::vector<size_t> neighbours_begin;
+    std::vector<unsigned int> neighbours;
+    std::vector<unsigned int> seeds;
+
+    void build_bad_channel_map();
+    unsigned int bad_channels(geo::WireID const& wid) const;
+    void find_neighbours();
+    size_t num_neighbours(unsigned int index) const
+    {
+      return neighbours_begin[index + 1] - neighbours_begin[index];
+    }
     int expand(unsigned int index, unsigned int cluster_id);
-    int spread(unsigned int index, epsilon_neighbours_t* seeds, unsigned int cluster_id);
-    float dist(point_t* a, point_t* b) const;
+    void spread(unsigned int index, unsigned int cluster_id);
+    float dist(point_t const* a, point_t const* b) const;
 
   }; // class DBScan3DAlg
 } // namespace
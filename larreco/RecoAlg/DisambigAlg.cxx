@@ -24,6 +24,7 @@
 #include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
 #include "lardataobj/RecoBase/Hit.h"
 #include "larreco/RecoAlg/DisambigAlg.h"
+#include "larreco/RecoAlg/GeometryCache.h"
 
 #include <cmath>
 #include <cstdlib>
@@ -313,7 +314,8 @@ namespace apa {
     // wireID adjacent to supplied *wid*.  Returns number of NEW hits
     // made.
 
-    raw::ChannelID_t Dchan = geom->PlaneWireToChannel(Dwid);
+    auto const& geometryCache = util::GeometryCache::Instance();
+    raw::ChannelID_t Dchan = geometryCache.PlaneWireToChannel(Dwid);
     geo::View_t view = geom->View(Dchan);
     if (view == geo::kZ)
       throw cet::exception("MakeCloseHits") << "Function not meant for non-wrapped channels.\n";
@@ -337,7 +339,7 @@ namespace apa {
       art::Ptr<recob::Hit> closeHit = fChannelToHits[chan][i];
       double st = closeHit->PeakTimeMinusRMS();
       double et = closeHit->PeakTimePlusRMS();
-      std::vector<geo::WireID> wids = geom->ChannelToWire(chan);
+      auto const wids = geometryCache.ChannelToWire(chan);
 
       if (!(Dmin <= st && st <= Dmax) && !(Dmin <= et && et <= Dmax)) continue;
 
@@ -664,6 +666,7 @@ namespace apa {
                                          unsigned int apa)
   {
     unsigned int nDisambiguations(0);
+    auto const& geometryCache = util::GeometryCache::Instance();
 
     // loop through all hits that are still ambiguous
     for (auto const& ambighitPtr : fAPAToUVHits[apa]) {
@@ -672,7 +675,7 @@ namespace apa {
       std::pair<double, double> ambigChanTime(ambigchan * 1., ambighit.PeakTime());
       if (fHasBeenDisambiged[apa][ambigChanTime]) continue;
       geo::View_t view = ambighit.View();
-      std::vector<geo::WireID> ambigwids = geom->ChannelToWire(ambigchan);
+      auto const ambigwids = geometryCache.ChannelToWire(ambigchan);
       std::vector<unsigned int> widDcounts(ambigwids.size(), 0);
       std::vector<unsigned int> widAcounts(ambigwids.size(), 0);
 
@@ -683,12 +686,13 @@ namespace apa {
         // An other-view-hit overlaps in time, see what
         // wids of the ambiguous hit's channels it overlaps
         raw::ChannelID_t chan = hit.Channel();
-        std::vector<geo::WireID> wids = geom->ChannelToWire(chan);
+        auto const wids = geometryCache.ChannelToWire(chan);
         std::pair<double, double> ChanTime(chan * 1., hit.PeakTime());
         geo::WireIDIntersection widIntersect; // only so we can use the function
         if (fHasBeenDisambiged[apa][ChanTime]) {
           for (size_t a = 0; a < ambigwids.size(); a++)
             if (ambigwids[a].TPC == fChanTimeToWid[ChanTime].TPC &&
+                geometryCache.MayIntersect(ambigwids[a], fChanTimeToWid[ChanTime]) &&
                 geom->WireIDsIntersect(ambigwids[a], fChanTimeToWid[ChanTime], widIntersect))
               widDcounts[a]++;
         }
@@ -698,6 +702,7 @@ namespace apa {
           for (size_t a = 0; a < ambigwids.size(); a++)
             for (size_t w = 0; w < wids.size(); w++)
               if (ambigwids[a].TPC == wids[w].TPC &&
+                  geometryCache.MayIntersect(ambigwids[a], wids[w]) &&
                   geom->WireIDsIntersect(ambigwids[a], wids[w], widIntersect))
                 widAcounts[a]++;
         }
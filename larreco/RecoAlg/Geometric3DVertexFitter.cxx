@@ -89,12 +89,7 @@ trkf::VertexWrapper trkf::Geometric3DVertexFitter::fitTracks(
   if (vtx.isValid() == false || vtx.tracksSize() < 2) return vtx;
 
   // then add other tracks and update vertex measurement
-  for (auto tk = tracks.begin() + 2; tk < tracks.end(); ++tk) {
-    auto sipv = sip(detProp, vtx, *tk);
-    if (debugLevel > 1) std::cout << "sip=" << sipv << std::endl;
-    if (sipv > sipCut) continue;
-    addTrackToVertex(detProp, vtx, *tk);
-  }
+  addTracksToVertex(detProp, vtx, tracks.begin() + 2, tracks.end());
   return vtx;
 }
 
@@ -125,12 +120,7 @@ trkf::VertexWrapper trkf::Geometric3DVertexFitter::fitTracksWithVtx(
   if (vtx.isValid() == false || vtx.tracks().size() < 2) return vtx;
 
   // then add other tracks and update vertex measurement
-  for (auto tk = tracks.begin() + 2; tk < tracks.end(); ++tk) {
-    auto sipv = sip(detProp, vtx, *tk);
-    if (debugLevel > 1) std::cout << "sip=" << sipv << std::endl;
-    if (sipv > sipCut) continue;
-    addTrackToVertex(detProp, vtx, *tk);
-  }
+  addTracksToVertex(detProp, vtx, tracks.begin() + 2, tracks.end());
   return vtx;
 }
 
@@ -356,6 +346,12 @@ trkf::VertexWrapper trkf::Geometric3DVertexFitter::fitTwoTracks(
     was.first.position(), was.first.covariance6D().Sub<SMatrixSym33>(0, 0), was.second, ndof);
   vtx.addTrack(tk1);
   vtx.addTrack(tk2);
+  if (downdateUnbiased) {
+    const auto& pos1 = state1.position();
+    const auto& pos2 = state2.position();
+    addTrackInformation(vtx, SVector3(pos1.X(), pos1.Y(), pos1.Z()), cov1, target);
+    addTrackInformation(vtx, SVector3(pos2.X(), pos2.Y(), pos2.Z()), cov2, target);
+  }
 
   if (debugLevel > 0) {
     std::cout << "vtxpos=" << vtx.position() << std::endl;
@@ -422,10 +418,34 @@ trkf::Geometric3DVertexFitter::ParsCovsOnPlane trkf::Geometric3DVertexFitter::ge
   return ParsCovsOnPlane(par1, par2, cov1, cov2, target);
 }
 
+void trkf::Geometric3DVertexFitter::addTracksToVertex(
+  detinfo::DetectorPropertiesData const& detProp,
+  trkf::VertexWrapper& vtx,
+  TrackRefVec::const_iterator begin,
+  TrackRefVec::const_iterator end) const
+{
+  for (auto tk = begin; tk < end; ++tk) {
+    // the state propagated for the sip cut is the one used to update the vertex
+    ParsCovsOnPlane pcp = getParsCovsOnPlane(detProp, vtx, *tk);
+    auto sipv = sip(pcp);
+    if (debugLevel > 1) std::cout << "sip=" << sipv << std::endl;
+    if (sipv > sipCut) continue;
+    addTrackToVertex(vtx, *tk, pcp);
+  }
+}
+
 void trkf::Geometric3DVertexFitter::addTrackToVertex(detinfo::DetectorPropertiesData const& detProp,
                                                      trkf::VertexWrapper& vtx,
                                                      const recob::Track& tk) const
 {
+  ParsCovsOnPlane pcp = getParsCovsOnPlane(detProp, vtx, tk);
+  addTrackToVertex(vtx, tk, pcp);
+}
+
+void trkf::Geometric3DVertexFitter::addTrackToVertex(trkf::VertexWrapper& vtx,
+                                                     const recob::Track& tk,
+                                                     ParsCovsOnPlane& pcp) const
+{
 
   if (debugLevel > 0) {
     std::cout << "adding track with start=" << tk.Start() << " dir=" << tk.StartDirection()
@@ -433,13 +453,20 @@ void trkf::Geometric3DVertexFitter::addTrackToVertex(detinfo::DetectorProperties
     std::cout << "covariance=\n" << tk.VertexCovarianceGlobal6D() << std::endl;
   }
 
-  ParsCovsOnPlane pcp = getParsCovsOnPlane(detProp, vtx, tk);
   std::pair<TrackState, double> was = weightedAverageState(pcp);
   if (was.second <= (util::kBogusD - 1.)) { return; }
 
+  // the track measurement in 3D, from its offset to the vertex (which lies on the plane)
+  SVector3 trkpos;
+  if (downdateUnbiased) {
+    const SVector3 vtxpos(vtx.position().X(), vtx.position().Y(), vtx.position().Z());
+    trkpos = vtxpos + ROOT::Math::Transpose(planeProjection(pcp.plane)) * (pcp.par2 - pcp.par1);
+  }
+
   const int ndof = 2; // Each measurement is 2D because it is defined on a plane
   vtx.addTrackAndUpdateVertex(
     was.first.position(), was.first.covariance6D().Sub<SMatrixSym33>(0, 0), was.second, ndof, tk);
+  if (downdateUnbiased) addTrackInformation(vtx, trkpos, pcp.cov2, pcp.plane);
 
   if (debugLevel > 0) {
     std::cout << "updvtxpos=" << vtx.position() << std::endl;
@@ -515,6 +542,69 @@ double trkf::Geometric3DVertexFitter::pDist(const VertexWrapper& vtx, const reco
   return tk.Trajectory().StartDirection().Dot(vtx.position() - tk.Trajectory().Start());
 }
 
+trkf::Geometric3DVertexFitter::SMatrix23 trkf::Geometric3DVertexFitter::planeProjection(
+  const recob::tracking::Plane& plane) const
+{
+  // rows are the directions of the local position parameters on the plane
+  return plane.Global6DToLocal5DJacobian(false, Vector_t()).Sub<SMatrix23>(0, 0);
+}
+
+void trkf::Geometric3DVertexFitter::addTrackInformation(trkf::VertexWrapper& vtx,
+                                                        const SVector3& trkpos,
+                                                        const SMatrixSym22& trkcov,
+                                                        const recob::tracking::Plane& plane) const
+{
+  // without it the vertex information is incomplete, and unbiasedVertex refits instead
+  SMatrixSym22 trkinv = trkcov;
+  if (!trkinv.Invert()) return;
+
+  VertexWrapper::TrackInformation info;
+  info.weight = ROOT::Math::SimilarityT(planeProjection(plane), trkinv);
+  info.weightedPos = info.weight * trkpos;
+  info.posChi2 = ROOT::Math::Dot(trkpos, info.weightedPos);
+  vtx.addTrackInformation(info);
+}
+
+bool trkf::Geometric3DVertexFitter::downdateVertex(const trkf::VertexWrapper& vtx,
+                                                   size_t itk,
+                                                   trkf::VertexWrapper& ubvtx) const
+{
+  // The fit accumulates the information of the 2D track measurements on their planes, so the
+  // least squares vertex of the other tracks follows from removing the information of this one.
+  if (!vtx.hasTrackInformation()) return false;
+  const auto& total = vtx.totalInformation();
+  const auto& removed = vtx.trackInformation()[itk];
+
+  SMatrixSym33 ubcov = total.weight - removed.weight;
+  const SVector3 ubweightedpos = total.weightedPos - removed.weightedPos;
+  const double ubposchi2 = total.posChi2 - removed.posChi2;
+
+  // the other tracks may not constrain all three coordinates, e.g. the first two tracks of the fit
+  // are both measured on the plane orthogonal to the first one
+  double det = 0.;
+  const double scale = ubcov.Trace() / 3.;
+  if (!ubcov.Det2(det) || !(det > 1e-12 * scale * scale * scale)) return false;
+  if (!ubcov.Invert()) return false;
+
+  const SVector3 ubpos = ubcov * ubweightedpos;
+  const double ubchi2 = ubposchi2 - ROOT::Math::Dot(ubpos, ubweightedpos);
+  const int ndof = 2 * (vtx.tracksSize() - 1) - 3; // Each measurement is 2D
+  ubvtx = VertexWrapper(
+    recob::tracking::Point_t(ubpos[0], ubpos[1], ubpos[2]), ubcov, ubchi2, ndof);
+  for (size_t it = 0; it != vtx.tracksSize(); ++it) {
+    if (it == itk) continue;
+    ubvtx.addTrack(vtx.tracks()[it]);
+    ubvtx.addTrackInformation(vtx.trackInformation()[it]);
+  }
+
+  if (debugLevel > 1) {
+    std::cout << "downdated vtxpos=" << ubvtx.position() << std::endl;
+    std::cout << "downdated vtxcov=\n" << ubvtx.covariance() << std::endl;
+  }
+
+  return true;
+}
+
 trkf::VertexWrapper trkf::Geometric3DVertexFitter::unbiasedVertex(
   detinfo::DetectorPropertiesData const& detProp,
   const trkf::VertexWrapper& vtx,
@@ -523,6 +613,11 @@ trkf::VertexWrapper trkf::Geometric3DVertexFitter::unbiasedVertex(
   auto ittoerase = vtx.findTrack(tk);
   if (ittoerase == vtx.tracksSize()) { return vtx; }
   else {
+    // removing a track of a two track vertex leaves a single track measurement
+    if (downdateUnbiased && vtx.tracksSize() > 2) {
+      VertexWrapper ubvtx;
+      if (downdateVertex(vtx, ittoerase, ubvtx)) return ubvtx;
+    }
     auto tks = vtx.tracksWithoutElement(ittoerase);
     return fitTracks(detProp, tks);
   }
@@ -532,65 +627,40 @@ double trkf::Geometric3DVertexFitter::chi2Unbiased(detinfo::DetectorPropertiesDa
                                                    const trkf::VertexWrapper& vtx,
                                                    const recob::Track& tk) const
 {
-  auto ittoerase = vtx.findTrack(tk);
-  if (ittoerase == vtx.tracksSize()) { return chi2(detProp, vtx, tk); }
-  else {
-    auto tks = vtx.tracksWithoutElement(ittoerase);
-    return chi2(detProp, fitTracks(detProp, tks), tk);
-  }
+  return chi2(detProp, unbiasedVertex(detProp, vtx, tk), tk);
 }
 
 double trkf::Geometric3DVertexFitter::ipUnbiased(detinfo::DetectorPropertiesData const& detProp,
                                                  const trkf::VertexWrapper& vtx,
                                                  const recob::Track& tk) const
 {
-  auto ittoerase = vtx.findTrack(tk);
-  if (ittoerase == vtx.tracksSize()) { return ip(detProp, vtx, tk); }
-  else {
-    auto tks = vtx.tracksWithoutElement(ittoerase);
-    return ip(detProp, fitTracks(detProp, tks), tk);
-  }
+  return ip(detProp, unbiasedVertex(detProp, vtx, tk), tk);
 }
 
 double trkf::Geometric3DVertexFitter::ipErrUnbiased(detinfo::DetectorPropertiesData const& detProp,
                                                     const trkf::VertexWrapper& vtx,
                                                     const recob::Track& tk) const
 {
-  auto ittoerase = vtx.findTrack(tk);
-  if (ittoerase == vtx.tracksSize()) { return ipErr(detProp, vtx, tk); }
-  else {
-    auto tks = vtx.tracksWithoutElement(ittoerase);
-    return ipErr(detProp, fitTracks(detProp, tks), tk);
-  }
+  return ipErr(detProp, unbiasedVertex(detProp, vtx, tk), tk);
 }
 
 double trkf::Geometric3DVertexFitter::sipUnbiased(detinfo::DetectorPropertiesData const& detProp,
                                                   const trkf::VertexWrapper& vtx,
                                                   const recob::Track& tk) const
 {
-  auto ittoerase = vtx.findTrack(tk);
-  if (ittoerase == vtx.tracksSize()) { return sip(detProp, vtx, tk); }
-  else {
-    auto tks = vtx.tracksWithoutElement(ittoerase);
-    return sip(detProp, fitTracks(detProp, tks), tk);
-  }
+  return sip(detProp, unbiasedVertex(detProp, vtx, tk), tk);
 }
 
 double trkf::Geometric3DVertexFitter::pDistUnbiased(detinfo::DetectorPropertiesData const& detProp,
                                                     const trkf::VertexWrapper& vtx,
                                                     const recob::Track& tk) const
 {
-  auto ittoerase = vtx.findTrack(tk);
-  if (ittoerase == vtx.tracksSize()) { return pDist(vtx, tk); }
-  else {
-    auto tks = vtx.tracksWithoutElement(ittoerase);
-    return pDist(fitTracks(detProp, tks), tk);
-  }
+  return pDist(unbiasedVertex(detProp, vtx, tk), tk);
 }
 
 std::vector<recob::VertexAssnMeta> trkf::Geometric3DVertexFitter::computeMeta(
   detinfo::DetectorPropertiesData const& detProp,
-  const VertexWrapper& vtx)
+  const VertexWrapper& vtx) const
 {
   return computeMeta(detProp, vtx, vtx.tracks());
 }
@@ -598,7 +668,7 @@ std::vector<recob::VertexAssnMeta> trkf::Geometric3DVertexFitter::computeMeta(
 std::vector<recob::VertexAssnMeta> trkf::Geometric3DVertexFitter::computeMeta(
   detinfo::DetectorPropertiesData const& detProp,
   const VertexWrapper& vtx,
-  const std::vector<art::Ptr<recob::Track>>& arttracks)
+  const std::vector<art::Ptr<recob::Track>>& arttracks) const
 {
   TrackRefVec tracks;
   for (auto t : arttracks)
@@ -609,7 +679,7 @@ std::vector<recob::VertexAssnMeta> trkf::Geometric3DVertexFitter::computeMeta(
 std::vector<recob::VertexAssnMeta> trkf::Geometric3DVertexFitter::computeMeta(
   detinfo::DetectorPropertiesData const& detProp,
   const VertexWrapper& vtx,
-  const TrackRefVec& trks)
+  const TrackRefVec& trks) const
 {
   std::vector<recob::VertexAssnMeta> result;
   for (auto tk : trks) {
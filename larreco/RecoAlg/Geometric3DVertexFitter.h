@@ -44,6 +44,10 @@ namespace trkf {
    * of the n-1 track vertex position and the point of closest approach of the n-th track.
    * Methods to obtain the (unbiased) propagation distance, impact parameter, impact parameter error, impact parameter significance, and chi2
    * of a track with respect to the vertex are provided.
+   * With downdateUnbiased, the fit also keeps in the VertexWrapper the information (inverse covariance) of each
+   * track measurement, from the states already propagated by the fit, and the unbiased vertex is the least squares
+   * vertex of the other tracks' information instead of a refit; it falls back to the refit when those do not
+   * constrain all three coordinates.
    *
    * Inputs are: a set of tracks; interface is provided allowing these to be passed directly of through a PFParticle hierarchy.
    *
@@ -69,6 +73,12 @@ namespace trkf {
         Name("sipCut"),
         Comment(
           "Cut on maximum impact parameter significance to use the track in the vertex fit.")};
+      fhicl::Atom<bool> downdateUnbiased{
+        Name("downdateUnbiased"),
+        Comment("Keep the information of the track measurements used in the fit, and obtain the "
+                "unbiased vertex by removing that of the track instead of refitting the vertex "
+                "from the other tracks."),
+        false};
     };
 
     struct TracksFromVertexSorter {
@@ -100,7 +110,7 @@ namespace trkf {
     // Constructor
     Geometric3DVertexFitter(const fhicl::Table<Config>& o,
                             const fhicl::Table<TrackStatePropagator::Config>& p)
-      : debugLevel(o().debugLevel()), sipCut(o().sipCut())
+      : debugLevel(o().debugLevel()), sipCut(o().sipCut()), downdateUnbiased(o().downdateUnbiased())
     {
       prop = std::make_unique<TrackStatePropagator>(p);
     }
@@ -131,14 +141,14 @@ namespace trkf {
                           const recob::Track& tk) const;
 
     std::vector<recob::VertexAssnMeta> computeMeta(detinfo::DetectorPropertiesData const& detProp,
-                                                   const VertexWrapper& vtx);
+                                                   const VertexWrapper& vtx) const;
     std::vector<recob::VertexAssnMeta> computeMeta(
       detinfo::DetectorPropertiesData const& detProp,
       const VertexWrapper& vtx,
-      const std::vector<art::Ptr<recob::Track>>& arttracks);
+      const std::vector<art::Ptr<recob::Track>>& arttracks) const;
     std::vector<recob::VertexAssnMeta> computeMeta(detinfo::DetectorPropertiesData const& detProp,
                                                    const VertexWrapper& vtx,
-                                                   const TrackRefVec& trks);
+                                                   const TrackRefVec& trks) const;
 
     double chi2(detinfo::DetectorPropertiesData const& detProp,
                 const VertexWrapper& vtx,
@@ -177,6 +187,7 @@ namespace trkf {
     std::unique_ptr<TrackStatePropagator> prop;
     int debugLevel;
     double sipCut;
+    bool downdateUnbiased;
 
     double chi2(const ParsCovsOnPlane& pcp) const;
     double ip(const ParsCovsOnPlane& pcp) const;
@@ -185,6 +196,18 @@ namespace trkf {
     ParsCovsOnPlane getParsCovsOnPlane(detinfo::DetectorPropertiesData const& detProp,
                                        const trkf::VertexWrapper& vtx,
                                        const recob::Track& tk) const;
+    void addTracksToVertex(detinfo::DetectorPropertiesData const& detProp,
+                           VertexWrapper& vtx,
+                           TrackRefVec::const_iterator begin,
+                           TrackRefVec::const_iterator end) const;
+    void addTrackToVertex(VertexWrapper& vtx, const recob::Track& tk, ParsCovsOnPlane& pcp) const;
+    using SMatrix23 = ROOT::Math::SMatrix<double, 2, 3>;
+    SMatrix23 planeProjection(const recob::tracking::Plane& plane) const;
+    void addTrackInformation(VertexWrapper& vtx,
+                             const SVector3& trkpos,
+                             const SMatrixSym22& trkcov,
+                             const recob::tracking::Plane& plane) const;
+    bool downdateVertex(const VertexWrapper& vtx, size_t itk, VertexWrapper& ubvtx) const;
     std::pair<TrackState, double> weightedAverageState(ParsCovsOnPlane& pcop) const
     {
       return weightedAverageState(pcop.par1, pcop.par2, pcop.cov1, pcop.cov2, pcop.plane);
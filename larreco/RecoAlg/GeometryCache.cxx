@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////
+//
+// \file GeometryCache.cxx
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "larreco/RecoAlg/GeometryCache.h"
+
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "cetlib_except/exception.h"
+#include "larcore/Geometry/Geometry.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+  // the wires are extended by this length (cm) at both ends before finding the wires they
+  // cross, far beyond the tolerance of the geometry intersection check
+  constexpr double kEndMargin = 5.;
+
+  // wires between the wire coordinates of the two ends, widened by one wire on each side
+  std::pair<int, int> CrossedRange(double c0, double c1)
+  {
+    constexpr double lowest = std::numeric_limits<int>::min();
+    constexpr double highest = std::numeric_limits<int>::max();
+    if (!std::isfinite(c0) || !std::isfinite(c1))
+      return {std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    double const first = std::clamp(std::floor(std::min(c0, c1)) - 1., lowest, highest);
+    double const last = std::clamp(std::ceil(std::max(c0, c1)) + 1., lowest, highest);
+    return {static_cast<int>(first), static_cast<int>(last)};
+  }
+
+}
+
+namespace util {
+
+  //----------------------------------------------------------
+  GeometryCache::GeometryCache(geo::GeometryCore const& geom)
+    : fGeom(&geom), fNChannels(geom.Nchannels()), fMaxPlanes(geom.MaxPlanes())
+  {
+    // channel to wires, in the order of the channel map
+    fChannelBegin.reserve(fNChannels + 1);
+    fChannelBegin.push_back(0);
+    for (raw::ChannelID_t channel = 0; channel < fNChannels; ++channel) {
+      for (auto const& wid : geom.ChannelToWire(channel))
+        fChannelWires.push_back(wid);
+      fChannelBegin.push_back(fChannelWires.size());
+    }
+
+    // planes and wires to channels; the TPCs come cryostat by cryostat
+    for (auto const& tpcgeom : geom.Iterate<geo::TPCGeo>()) {
+      geo::TPCID const& tpcid = tpcgeom.ID();
+      if (tpcid.TPC == 0) fCryostatTPCBegin.push_back(fTPCPlaneBegin.size());
+      fTPCPlaneBegin.push_back(fPitch.size());
+      for (auto const& planeid : geom.Iterate<geo::PlaneID>(tpcid)) {
+        fPlaneWireBegin.push_back(fWireChannels.size());
+        fPitch.push_back(geom.WirePitch(planeid));
+        unsigned int const nwires = geom.Nwires(planeid);
+        for (unsigned int wire = 0; wire < nwires; ++wire)
+          fWireChannels.push_back(geom.PlaneWireToChannel(geo::WireID(planeid, wire)));
+      }
+    }
+
+    // wires of the other planes of the TPC crossed by each wire
+    fCrossedBegin.assign(fPitch.size() * fMaxPlanes, 0);
+    for (auto const& tpcgeom : geom.Iterate<geo::TPCGeo>()) {
+      geo::TPCID const& tpcid = tpcgeom.ID();
+      for (auto const& planeidA : geom.Iterate<geo::PlaneID>(tpcid)) {
+        geo::PlaneGeo const& planeA = geom.Plane(planeidA);
+        for (auto const& planeidB : geom.Iterate<geo::PlaneID>(tpcid)) {
+          if (planeidB == planeidA) continue;
+          geo::PlaneGeo const& planeB = geom.Plane(planeidB);
+          fCrossedBegin[PlaneIndex(planeidA) * fMaxPlanes + planeidB.Plane] = fCrossedWires.size();
+          for (unsigned int wire = 0; wire < planeA.Nwires(); ++wire) {
+            geo::WireGeo const& wiregeo = planeA.Wire(wire);
+            auto const start = wiregeo.GetStart();
+            auto const end = wiregeo.GetEnd();
+            auto const dir = (end - start).Unit();
+            fCrossedWires.push_back(CrossedRange(planeB.WireCoordinate(start - kEndMargin * dir),
+                                                 planeB.WireCoordinate(end + kEndMargin * dir)));
+          }
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------
+  GeometryCache const& GeometryCache::Instance()
+  {
+    geo::GeometryCore const* geom = art::ServiceHandle<geo::Geometry const>()->provider();
+    static GeometryCache const cache(*geom);
+    if (cache.fGeom != geom)
+      throw cet::exception("GeometryCache")
+        << "The geometry service provides a different geometry than the one the cache was "
+           "filled from\n";
+    return cache;
+  }
+
+  //----------------------------------------------------------
+  void GeometryCache::ThrowUnknownChannel(raw::ChannelID_t channel)
+  {
+    throw cet::exception("Geometry") << "Can't find ChannelToWire for channel " << channel << "\n";
+  }
+
+  //----------------------------------------------------------
+  bool GeometryCache::MayIntersect(geo::WireID const& a, geo::WireID const& b) const
+  {
+    if (a.Cryostat != b.Cryostat || a.TPC != b.TPC || a.Plane == b.Plane) return true;
+    auto const& crossed =
+      fCrossedWires[fCrossedBegin[PlaneIndex(a) * fMaxPlanes + b.Plane] + a.Wire];
+    int const wire = b.Wire;
+    return wire >= crossed.first && wire <= crossed.second;
+  }
+
+}
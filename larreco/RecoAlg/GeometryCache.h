@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////
+//
+// \file GeometryCache.h
+//
+// Read-only tables of the geometry answers asked for in hot loops:
+// the wire IDs of each channel, the channel of each wire, the wire
+// pitch of each plane, and for each wire the range of wires of the other
+// planes of its TPC which it can cross. The tables are filled once from
+// the geometry and never modified afterwards, so one instance can be
+// shared by all threads. The geometry must not change during the job.
+// Instance() builds the cache of the geometry service at its first call
+// and throws if the service later provides a different geometry.
+//
+////////////////////////////////////////////////////////////////////////
+#ifndef GEOMETRYCACHE_H
+#define GEOMETRYCACHE_H
+
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace geo {
+  class GeometryCore;
+}
+
+namespace util {
+
+  class GeometryCache {
+  public:
+    /// The wire IDs of one channel, pointing into the table
+    class WireIDRange {
+    public:
+      WireIDRange(geo::WireID const* first, geo::WireID const* last) : fFirst(first), fLast(last)
+      {}
+
+      geo::WireID const* begin() const { return fFirst; }
+      geo::WireID const* end() const { return fLast; }
+      size_t size() const { return fLast - fFirst; }
+      bool empty() const { return fFirst == fLast; }
+      geo::WireID const& operator[](size_t i) const { return fFirst[i]; }
+      geo::WireID const& front() const { return *fFirst; }
+
+    private:
+      geo::WireID const* fFirst;
+      geo::WireID const* fLast;
+    };
+
+    explicit GeometryCache(geo::GeometryCore const& geom);
+
+    /// The cache of the geometry service, filled at the first call and kept for the whole
+    /// job; throws cet::exception if the service geometry is not the one it was filled from
+    static GeometryCache const& Instance();
+
+    /// The wire IDs of GeometryCore::ChannelToWire, in the same order; throws cet::exception
+    /// like the geometry if the channel is not in the channel map
+    WireIDRange ChannelToWire(raw::ChannelID_t channel) const
+    {
+      if (channel >= fNChannels) ThrowUnknownChannel(channel);
+      return {fChannelWires.data() + fChannelBegin[channel],
+              fChannelWires.data() + fChannelBegin[channel + 1]};
+    }
+
+    /// The channel of GeometryCore::PlaneWireToChannel
+    raw::ChannelID_t PlaneWireToChannel(geo::WireID const& wid) const
+    {
+      size_t const plane = PlaneIndex(wid);
+      return fWireChannels[fPlaneWireBegin[plane] + wid.Wire];
+    }
+
+    /// The pitch of GeometryCore::WirePitch
+    double WirePitch(geo::PlaneID const& pid) const { return fPitch[PlaneIndex(pid)]; }
+
+    /// False only if GeometryCore::WireIDsIntersect is false for this pair of wires: wire b
+    /// is out of the range of wires of its plane crossed by wire a, extended at both ends.
+    /// Pairs in different TPCs or in the same plane are left to the geometry.
+    bool MayIntersect(geo::WireID const& a, geo::WireID const& b) const;
+
+  private:
+    [[noreturn]] static void ThrowUnknownChannel(raw::ChannelID_t channel);
+
+    /// Index of the plane in the flat tables
+    size_t PlaneIndex(geo::PlaneID const& pid) const
+    {
+      return fTPCPlaneBegin[fCryostatTPCBegin[pid.Cryostat] + pid.TPC] + pid.Plane;
+    }
+
+    geo::GeometryCore const* fGeom; ///< the geometry the tables were filled from
+
+    raw::ChannelID_t fNChannels;
+    std::vector<size_t> fChannelBegin;
+    std::vector<geo::WireID> fChannelWires;
+
+    std::vector<size_t> fCryostatTPCBegin;
+    std::vector<size_t> fTPCPlaneBegin;
+    unsigned int fMaxPlanes;
+
+    std::vector<size_t> fPlaneWireBegin;
+    std::vector<raw::ChannelID_t> fWireChannels;
+    std::vector<double> fPitch;
+
+    // for each plane and each other plane of its TPC (fMaxPlanes entries per plane), the
+    // offset of the ranges of wires crossed by its wires in fCrossedWires
+    std::vector<size_t> fCrossedBegin;
+    std::vector<std::pair<int, int>> fCrossedWires;
+  };
+
+}
+
+#endif
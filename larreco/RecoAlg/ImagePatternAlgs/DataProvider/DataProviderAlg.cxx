@@ -13,6 +13,7 @@
 #include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
+#include "larreco/RecoAlg/GeometryCache.h"
 namespace detinfo {
   class DetectorClocksData;
 }
@@ -24,11 +25,39 @@ namespace geo {
 
 #include "CLHEP/Random/RandGauss.h"
 
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
 #include <optional>
 #include <string>
 #include <vector>
 
+namespace {
+  // max of src over [d - r, d + r] for each d, window clipped to the vector
+  void runningMax(std::vector<float> const& src, size_t r, std::vector<float>& dst)
+  {
+    size_t n = src.size();
+    dst.resize(n);
+    if (n == 0) { return; }
+
+    std::vector<size_t> wedge(n);
+    size_t head = 0, tail = 0, next = 0;
+    for (size_t d = 0; d < n; ++d) {
+      size_t d1 = std::min(d + r, n - 1);
+      for (; next <= d1; ++next) {
+        while ((tail > head) && !(src[wedge[tail - 1]] > src[next])) {
+          --tail;
+        }
+        wedge[tail++] = next;
+      }
+      while (wedge[head] + r < d) {
+        ++head;
+      }
+      dst[d] = src[wedge[head]];
+    }
+  }
+}
+
 img::DataProviderAlg::DataProviderAlg(const Config& config)
   : fAlgView{}
   , fDownscaleMode(img::DataProviderAlg::kMax)
@@ -105,6 +134,7 @@ img::DataProviderAlg::DataProviderAlg(const Config& config)
   fBlurKernel = config.BlurKernel();
   fNoiseSigma = config.NoiseSigma();
   fCoherentSigma = config.CoherentSigma();
+  fPoolMaxRadius = config.PoolMaxRadius();
 }
 // ------------------------------------------------------
 
@@ -148,6 +178,21 @@ float img::DataProviderAlg::poolMax(int wire, int drift, size_t r) const
   if (!fDownscaleFullView) { rd *= fDriftWindow; }
 
   size_t didx = getDriftIndex(drift);
+
+  // for the precomputed radius take the max over wires of the running max along drift
+  if ((r == fPoolMaxRadius) && !fPoolMaxDrift.empty() && (wire >= 0) && (drift >= 0) &&
+      ((unsigned int)wire < fAlgView.fNWires) && (didx < fAlgView.fNCachedDrifts)) {
+    int w0 = std::max(wire - (int)rw, 0);
+    int w1 = std::min(wire + (int)rw, (int)fAlgView.fNWires - 1);
+
+    float max_adc = 0;
+    for (int w = w0; w <= w1; ++w) {
+      float adc = fPoolMaxDrift[w][didx];
+      if (adc > max_adc) { max_adc = adc; }
+    }
+    return max_adc;
+  }
+
   int d0 = didx - rd;
   if (d0 < 0) { d0 = 0; }
   int d1 = didx + rd;
@@ -169,6 +214,17 @@ float img::DataProviderAlg::poolMax(int wire, int drift, size_t r) const
 
   return max_adc;
 }
+
+void img::DataProviderAlg::fillPoolMaxDrift()
+{
+  size_t rd = fPoolMaxRadius;
+  if (!fDownscaleFullView) { rd *= fDriftWindow; }
+
+  fPoolMaxDrift.resize(fAlgView.fWireDriftData.size());
+  tbb::parallel_for(size_t(0), fPoolMaxDrift.size(), [&](size_t w) {
+    runningMax(fAlgView.fWireDriftData[w], rd, fPoolMaxDrift[w]);
+  });
+}
 // ------------------------------------------------------
 
 //float img::DataProviderAlg::poolSum(int wire, int drift, size_t r) const
@@ -307,42 +363,64 @@ bool img::DataProviderAlg::setWireDriftData(detinfo::DetectorClocksData const& c
   size_t ndrifts = det_prop.NumberTimeSamples();
 
   fAlgView = resizeView(clock_data, det_prop, nwires, ndrifts);
+  fPoolMaxDrift.clear();
 
   auto const& channelStatus =
     art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
+  auto const& geometryCache = util::GeometryCache::Instance();
+
+  // find the wires to be filled, in the input order
+  struct WireJob {
+    recob::Wire const* wire;
+    size_t w_idx;
+    std::optional<std::vector<float>> wire_data;
+    double adcSum = 0;
+    size_t adcArea = 0;
+  };
+  std::vector<WireJob> jobs;
+  jobs.reserve(wires.size());
 
-  bool allWrong = true;
   for (auto const& wire : wires) {
     auto wireChannelNumber = wire.Channel();
     if (!channelStatus.IsGood(wireChannelNumber)) { continue; }
 
-    size_t w_idx = 0;
-    for (auto const& id : fGeometry->ChannelToWire(wireChannelNumber)) {
+    for (auto const& id : geometryCache.ChannelToWire(wireChannelNumber)) {
       if ((id.Plane == plane) && (id.TPC == tpc) && (id.Cryostat == cryo)) {
-        w_idx = id.Wire;
-
-        auto adc = wire.Signal();
-        if (adc.size() < ndrifts) {
+        if (wire.NSignal() < ndrifts) {
           mf::LogWarning("DataProviderAlg") << "Wire ADC vector size lower than NumberTimeSamples.";
           continue; // not critical, maybe other wires are OK, so continue
         }
-        auto wire_data = setWireData(adc, w_idx);
-        if (!wire_data) {
-          mf::LogWarning("DataProviderAlg") << "Wire data not set.";
-          continue; // also not critical, try to set other wires
-        }
-        fAlgView.fWireDriftData[w_idx] = *wire_data;
-        for (auto v : adc) {
-          if (v >= fAdcSumThr) {
-            fAdcSumOverThr += v;
-            fAdcAreaOverThr++;
-          }
-        }
+        jobs.push_back({&wire, id.Wire, std::nullopt});
+      }
+    }
+  }
 
-        fAlgView.fWireChannels[w_idx] = wireChannelNumber;
-        allWrong = false;
+  // unpacking and downscaling the wires are independent of each other
+  tbb::parallel_for(size_t(0), jobs.size(), [&](size_t j) {
+    auto& job = jobs[j];
+    auto adc = job.wire->Signal();
+    job.wire_data = setWireData(adc, job.w_idx);
+    if (!job.wire_data) { return; }
+    for (auto v : adc) {
+      if (v >= fAdcSumThr) {
+        job.adcSum += v;
+        job.adcArea++;
       }
     }
+  });
+
+  bool allWrong = true;
+  for (auto& job : jobs) {
+    if (!job.wire_data) {
+      mf::LogWarning("DataProviderAlg") << "Wire data not set.";
+      continue; // also not critical, try to set other wires
+    }
+    fAlgView.fWireDriftData[job.w_idx] = std::move(*job.wire_data);
+    fAdcSumOverThr += job.adcSum;
+    fAdcAreaOverThr += job.adcArea;
+
+    fAlgView.fWireChannels[job.w_idx] = job.wire->Channel();
+    allWrong = false;
   }
   if (allWrong) {
     mf::LogError("DataProviderAlg")
@@ -354,6 +432,8 @@ bool img::DataProviderAlg::setWireDriftData(detinfo::DetectorClocksData const& c
   addWhiteNoise();
   addCoherentNoise();
 
+  fillPoolMaxDrift();
+
   return true;
 }
 // ------------------------------------------------------
@@ -423,15 +503,20 @@ void img::DataProviderAlg::applyBlur()
     src[w] = fAlgView.fWireDriftData[w];
   }
 
-  for (size_t w = margin_left; w < fAlgView.fWireDriftData.size() - margin_right; ++w) {
-    for (size_t d = 0; d < fAlgView.fWireDriftData[w].size(); ++d) {
-      float sum = 0;
+  // kernel taps in the outer loop so the drift loop vectorizes; each pixel still
+  // accumulates the taps in the same order
+  tbb::parallel_for(
+    margin_left, fAlgView.fWireDriftData.size() - margin_right, [&](size_t w) {
+      auto& dst = fAlgView.fWireDriftData[w];
+      std::fill(dst.begin(), dst.end(), 0.0F);
       for (size_t i = 0; i < fBlurKernel.size(); ++i) {
-        sum += fBlurKernel[i] * src[w + i - margin_left][d];
+        float const k = fBlurKernel[i];
+        auto const* row = src[w + i - margin_left].data();
+        for (size_t d = 0; d < dst.size(); ++d) {
+          dst[d] += k * row[d];
+        }
       }
-      fAlgView.fWireDriftData[w][d] = sum;
-    }
-  }
+    });
 }
 // ------------------------------------------------------
 
@@ -96,6 +96,11 @@ public:
     fhicl::Atom<float> NoiseSigma{Name("NoiseSigma"), Comment("White noise sigma")};
 
     fhicl::Atom<float> CoherentSigma{Name("CoherentSigma"), Comment("Coherent noise sigma")};
+
+    fhicl::Atom<unsigned int> PoolMaxRadius{
+      Name("PoolMaxRadius"),
+      Comment("Patch radius (in pixels) of poolMax calls served from a precomputed table"),
+      2};
   };
 
   DataProviderAlg(const fhicl::ParameterSet& pset)
@@ -152,7 +157,9 @@ public:
   double getAdcSum() const { return fAdcSumOverThr; }
   size_t getAdcArea() const { return fAdcAreaOverThr; }
 
-  /// Pool max value in a patch around the wire/drift pixel.
+  /// Pool max value in a patch around the wire/drift pixel. For the configured PoolMaxRadius
+  /// the running max along drift is precomputed with the view, so repeated calls (e.g. PMA
+  /// validation) are cheap; other radii scan the patch.
   float poolMax(int wire, int drift, size_t r = 0) const;
 
   /// Pool sum of pixels in a patch around the wire/drift pixel.
@@ -252,6 +259,10 @@ private:
 
   CLHEP::HepJamesRandom fRndEngine;
 
+  void fillPoolMaxDrift();
+  size_t fPoolMaxRadius;
+  std::vector<std::vector<float>> fPoolMaxDrift; // running max along drift, filled with the view
+
   void applyBlur();
   std::vector<float> fBlurKernel; // blur not applied if empty
 
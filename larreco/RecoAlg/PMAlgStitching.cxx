@@ -14,7 +14,26 @@
 
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
-#include "TVector3.h"
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+  // Distance in the yz plane of point to the line through linePos along lineDir.
+  double GetYZLineDistance(const TVector3& linePos, const TVector3& point, const TVector3& lineDir)
+  {
+    double dy = point.Y() - linePos.Y();
+    double dz = point.Z() - linePos.Z();
+    double norm = std::hypot(lineDir.Y(), lineDir.Z());
+    if (norm == 0) return std::hypot(dy, dz);
+    return std::abs(dy * lineDir.Z() - dz * lineDir.Y()) / norm;
+  }
+
+}
 
 // Constructor
 pma::PMAlgStitching::PMAlgStitching(const pma::PMAlgStitching::Config& config)
@@ -23,6 +42,7 @@ pma::PMAlgStitching::PMAlgStitching(const pma::PMAlgStitching::Config& config)
   // Set parameters from the config.
   fStitchingThreshold = config.StitchingThreshold();
   fNodesFromEnd = config.NodesFromEnd();
+  fFitStitchShift = config.FitStitchShift();
 
   // Get CPA and APA positions.
   GetTPCXOffsets();
@@ -59,12 +79,34 @@ void pma::PMAlgStitching::StitchTracks(const detinfo::DetectorClocksData& clockD
   // Special case for fNodesFromEnd = 0
   if (minTrkLength < 6) minTrkLength = 6;
 
+  // Also check that these tpcs do meet at the stitching surface (not a problem for protoDUNE).
+  const double surfaceGap = 10.0;
+
+  // Track ends, recalculated only when tracks have been changed by a stitch.
+  std::vector<std::vector<TrackEnd>> ends;
+  std::vector<std::pair<double, size_t>> surfaceIndex;
+  bool updateEnds = true;
+
+  // Scores and shifts of the four options (front/back of track 1 to front/back of
+  // track 2) for each candidate track 2.
+  struct PairScores {
+    double score[4];
+    double shift[4];
+  };
+  std::vector<size_t> candidates;
+  std::vector<PairScores> pairScores;
+
   // Loop over the track collection
   unsigned int t = 0;
   while (t < tracks.size()) {
 
+    if (updateEnds) {
+      GetTrackEnds(tracks, minTrkLength, isCPA, ends, surfaceIndex);
+      updateEnds = false;
+    }
+
     pma::Track3D* t1 = tracks[t].Track();
-    if (t1->Nodes().size() < minTrkLength) {
+    if (ends[t].empty()) {
       ++t;
       continue;
     }
@@ -72,114 +114,104 @@ void pma::PMAlgStitching::StitchTracks(const detinfo::DetectorClocksData& clockD
     // Look through the following tracks for one to stitch
     pma::Track3D* bestTrkMatch = 0x0;
 
-    // Don't use the very end points of the tracks in case of scatter or distortion.
-    TVector3 trk1Front = t1->Nodes()[(fNodesFromEnd)]->Point3D();
-    TVector3 trk1Back = t1->Nodes()[t1->Nodes().size() - 1 - fNodesFromEnd]->Point3D();
-    TVector3 trk1FrontDir = (trk1Front - t1->Nodes()[(fNodesFromEnd + 1)]->Point3D()).Unit();
-    TVector3 trk1BackDir =
-      (trk1Back - t1->Nodes()[t1->Nodes().size() - 1 - (fNodesFromEnd + 1)]->Point3D()).Unit();
+    // Only tracks with an end at a surface close to one of the surfaces of this track can
+    // be stitched to it.
+    candidates.clear();
+    for (const TrackEnd& end1 : ends[t]) {
+      double xMin = end1.offset - surfaceGap - 1e-6;
+      double xMax = end1.offset + surfaceGap + 1e-6;
+      auto it = std::lower_bound(
+        surfaceIndex.begin(), surfaceIndex.end(), std::make_pair(xMin, size_t(0)));
+      for (; it != surfaceIndex.end() && it->first <= xMax; ++it) {
+        if (it->second > t) candidates.push_back(it->second);
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // The candidates are independent, score them in parallel. The best one is then
+    // chosen in track order.
+    pairScores.resize(candidates.size());
+    tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, candidates.size()), [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t c = r.begin(); c != r.end(); ++c) {
+          const std::vector<TrackEnd>& ends2 = ends[candidates[c]];
+          PairScores& scores = pairScores[c];
+          for (int i = 0; i < 4; ++i) {
+            scores.score[i] = std::numeric_limits<double>::max();
+            scores.shift[i] = 0;
+          }
 
-    // For stitching, we need to consider both ends of the track.
-    double offsetFront1 = GetTPCOffset(t1->FrontTPC(), t1->FrontCryo(), isCPA);
-    double offsetBack1 = GetTPCOffset(t1->BackTPC(), t1->BackCryo(), isCPA);
+          // If the points to match are in the same TPC, then don't bother.
+          // Remember we have 4 points to consider here.
+          bool giveUp = false;
+          for (const TrackEnd& end1 : ends[t]) {
+            for (const TrackEnd& end2 : ends2) {
+              if (end1.tpc == end2.tpc) giveUp = true;
+            }
+          }
+          // If the tracks have one end in the same TPC, give up.
+          if (giveUp) continue;
+
+          // Loop over the four options
+          for (int i = 0; i < 4; ++i) {
+            const TrackEnd& end1 = ends[t][i < 2 ? 0 : 1];
+            const TrackEnd& end2 = ends2[i % 2 == 0 ? 0 : 1];
+
+            if (std::fabs(end1.offset - end2.offset) > surfaceGap) continue;
+
+            // Make sure the x directions point towards eachother (could be an issue for matching a short track)
+            if (end1.dir.X() * end2.dir.X() > 0) { continue; }
+
+            // The score can not be below the distances of each point to the line of
+            // the other track in the yz plane, whatever the shift is.
+            if (GetYZLineDistance(end1.pos, end2.pos, end1.dir) +
+                  GetYZLineDistance(end2.pos, end1.pos, end2.dir) >
+                fStitchingThreshold + 1e-3) {
+              continue;
+            }
+
+            double xShift1 = end1.shift;
+            if (fFitStitchShift) {
+              scores.score[i] =
+                GetFittedStitchShift(end1.pos, end2.pos, end1.dir, end2.dir, xShift1);
+            }
+            else {
+              TVector3 t1Pos = end1.pos;
+              TVector3 t2Pos = end2.pos;
+              TVector3 t1Dir = end1.dir;
+              TVector3 t2Dir = end2.dir;
+              scores.score[i] = GetOptimalStitchShift(t1Pos, t2Pos, t1Dir, t2Dir, xShift1);
+            }
+            scores.shift[i] = xShift1;
+          }
+        }
+      });
 
     bool isBestFront1 = false;
     bool isBestFront2 = false;
     double xBestShift = 0;
-    double frontShift1 = t1->Nodes()[0]->Point3D().X() - offsetFront1;
-    double backShift1 = t1->Nodes()[t1->Nodes().size() - 1]->Point3D().X() - offsetBack1;
 
     double bestMatchScore = 99999;
 
-    for (unsigned int u = t + 1; u < tracks.size(); ++u) {
+    for (size_t c = 0; c < candidates.size(); ++c) {
 
+      const unsigned int u = candidates[c];
       pma::Track3D* t2 = tracks[u].Track();
-      if (t2->Nodes().size() < minTrkLength) continue;
-
-      // Don't use the very end points of the tracks in case of scatter or distortion.
-      TVector3 trk2Front = t2->Nodes()[(fNodesFromEnd)]->Point3D();
-      TVector3 trk2Back = t2->Nodes()[t2->Nodes().size() - 1 - fNodesFromEnd]->Point3D();
-      TVector3 trk2FrontDir = (trk2Front - t2->Nodes()[(fNodesFromEnd + 1)]->Point3D()).Unit();
-      TVector3 trk2BackDir =
-        (trk2Back - t2->Nodes()[t2->Nodes().size() - 1 - (fNodesFromEnd + 1)]->Point3D()).Unit();
-
-      // For stitching, we need to consider both ends of the track.
-      double offsetFront2 = GetTPCOffset(t2->FrontTPC(), t2->FrontCryo(), isCPA);
-      double offsetBack2 = GetTPCOffset(t2->BackTPC(), t2->BackCryo(), isCPA);
-
-      // If the points to match are in the same TPC, then don't bother.
-      // Remember we have 4 points to consider here.
-      bool giveUp = false;
-      geo::TPCID tpc1(0, 0);
-      geo::TPCID tpc2(0, 0);
-      // Front-to-front
-      tpc1 = geo::TPCID(t1->FrontCryo(), t1->FrontTPC());
-      tpc2 = geo::TPCID(t2->FrontCryo(), t2->FrontTPC());
-      if (tpc1 == tpc2) giveUp = true;
-      // Front-to-back
-      tpc2 = geo::TPCID(t2->BackCryo(), t2->BackTPC());
-      if (tpc1 == tpc2) giveUp = true;
-      // Back-to-front
-      tpc1 = geo::TPCID(t1->BackCryo(), t1->BackTPC());
-      tpc2 = geo::TPCID(t2->FrontCryo(), t2->FrontTPC());
-      if (tpc1 == tpc2) giveUp = true;
-      // Back-to-back
-      tpc2 = geo::TPCID(t2->BackCryo(), t2->BackTPC());
-      if (tpc1 == tpc2) giveUp = true;
-
-      // If the tracks have one end in the same TPC, give up.
-      if (giveUp) continue;
-
-      // Also check that these tpcs do meet at the stitching surface (not a problem for protoDUNE).
-      double surfaceGap = 10.0;
-      bool carryOn[4] = {true, true, true, true};
-      if (fabs(offsetFront1 - offsetFront2) > surfaceGap) carryOn[0] = false;
-      if (fabs(offsetFront1 - offsetBack2) > surfaceGap) carryOn[1] = false;
-      if (fabs(offsetBack1 - offsetFront2) > surfaceGap) carryOn[2] = false;
-      if (fabs(offsetBack1 - offsetBack2) > surfaceGap) carryOn[3] = false;
-
-      // Loop over the four options
-      for (int i = 0; i < 4; ++i) {
-
-        if (!carryOn[i]) continue;
-
-        TVector3 t1Pos;
-        TVector3 t2Pos;
-        TVector3 t1Dir;
-        TVector3 t2Dir;
-        double xShift1;
-        if (i < 2) {
-          t1Pos = trk1Front;
-          t1Dir = trk1FrontDir;
-          xShift1 = frontShift1;
-        }
-        else {
-          t1Pos = trk1Back;
-          t1Dir = trk1BackDir;
-          xShift1 = backShift1;
-        }
-        if (i % 2 == 0) {
-          t2Pos = trk2Front;
-          t2Dir = trk2FrontDir;
-        }
-        else {
-          t2Pos = trk2Back;
-          t2Dir = trk2BackDir;
-        }
 
-        // Make sure the x directions point towards eachother (could be an issue for matching a short track)
-        if (t1Dir.X() * t2Dir.X() > 0) { continue; }
-        //        t1Pos.SetX(t1Pos.X() - xShift1);
-        //        t2Pos.SetX(t2Pos.X() + xShift1);
+      for (int i = 0; i < 4; ++i) {
 
-        double score = 0;
-        //        score = GetTrackPairDelta(t1Pos,t2Pos,t1Dir,t2Dir);
-        score = GetOptimalStitchShift(t1Pos, t2Pos, t1Dir, t2Dir, xShift1);
+        double score = pairScores[c].score[i];
 
         if (score < fStitchingThreshold && score < bestMatchScore) {
 
+          const TVector3& t1Pos = ends[t][i < 2 ? 0 : 1].pos;
+          const TVector3& t1Dir = ends[t][i < 2 ? 0 : 1].dir;
+          const TVector3& t2Pos = ends[u][i % 2 == 0 ? 0 : 1].pos;
+          const TVector3& t2Dir = ends[u][i % 2 == 0 ? 0 : 1].dir;
+
           bestTrkMatch = t2;
-          xBestShift = xShift1;
+          xBestShift = pairScores[c].shift[i];
           bestMatchScore = score;
           if (i < 2) { isBestFront1 = true; }
           else {
@@ -207,6 +239,8 @@ void pma::PMAlgStitching::StitchTracks(const detinfo::DetectorClocksData& clockD
     // If we found a match, do something about it.
     if (bestTrkMatch != 0x0) {
 
+      updateEnds = true;
+
       bool flip1 = false;
       bool flip2 = false;
       bool reverse = false;
@@ -333,6 +367,64 @@ double pma::PMAlgStitching::GetOptimalStitchShift(TVector3& pos1,
   return bestScore;
 }
 
+// Minimise the matching score over the same window of shifts. With D the x distance of
+// the shifted points and a their yz separation, the two extrapolation distances are
+// |a + D*dir1_yz/dir1_x| and |a + D*dir2_yz/dir2_x|, so the score is convex in the shift
+// and its minimum is found by bisection on the sign of the derivative.
+double pma::PMAlgStitching::GetFittedStitchShift(const TVector3& pos1,
+                                                 const TVector3& pos2,
+                                                 const TVector3& dir1,
+                                                 const TVector3& dir2,
+                                                 double& shift) const
+{
+
+  if (dir1.X() == 0 || dir2.X() == 0) {
+    shift = 99999;
+    return 99999;
+  }
+
+  double ay = pos1.Y() - pos2.Y();
+  double az = pos1.Z() - pos2.Z();
+  double u[2][2] = {{dir1.Y() / dir1.X(), dir1.Z() / dir1.X()},
+                    {dir2.Y() / dir2.X(), dir2.Z() / dir2.X()}};
+
+  auto score = [&](double s) {
+    double d = pos2.X() - pos1.X() + 2 * s;
+    return std::hypot(ay + d * u[0][0], az + d * u[0][1]) +
+           std::hypot(ay + d * u[1][0], az + d * u[1][1]);
+  };
+  auto slope = [&](double s) {
+    double d = pos2.X() - pos1.X() + 2 * s;
+    double sum = 0;
+    for (int k = 0; k < 2; ++k) {
+      double ry = ay + d * u[k][0];
+      double rz = az + d * u[k][1];
+      double r = std::hypot(ry, rz);
+      if (r > 0) sum += (ry * u[k][0] + rz * u[k][1]) / r;
+    }
+    return sum;
+  };
+
+  double lo = shift - 5.;
+  double hi = shift + 5.;
+  if (slope(lo) >= 0) { hi = lo; }
+  else if (slope(hi) <= 0) {
+    lo = hi;
+  }
+  else {
+    while (hi - lo > 1e-6) {
+      double mid = 0.5 * (lo + hi);
+      if (slope(mid) > 0) { hi = mid; }
+      else {
+        lo = mid;
+      }
+    }
+  }
+
+  shift = 0.5 * (lo + hi);
+  return score(shift);
+}
+
 // Perform the extrapolation between the two vectors and return the distance between them.
 double pma::PMAlgStitching::GetTrackPairDelta(TVector3& pos1,
                                               TVector3& pos2,
@@ -356,6 +448,46 @@ double pma::PMAlgStitching::GetTrackPairDelta(TVector3& pos1,
   return delta;
 }
 
+// Collect the stitching points of all tracks
+void pma::PMAlgStitching::GetTrackEnds(const pma::TrkCandidateColl& tracks,
+                                       unsigned int minTrkLength,
+                                       bool isCPA,
+                                       std::vector<std::vector<TrackEnd>>& ends,
+                                       std::vector<std::pair<double, size_t>>& surfaceIndex)
+{
+
+  ends.assign(tracks.size(), std::vector<TrackEnd>());
+  surfaceIndex.clear();
+
+  for (size_t t = 0; t < tracks.size(); ++t) {
+
+    const pma::Track3D* trk = tracks[t].Track();
+    const auto& nodes = trk->Nodes();
+    if (nodes.size() < minTrkLength) continue;
+
+    // Don't use the very end points of the tracks in case of scatter or distortion.
+    TrackEnd front;
+    front.pos = nodes[fNodesFromEnd]->Point3D();
+    front.dir = (front.pos - nodes[fNodesFromEnd + 1]->Point3D()).Unit();
+    front.offset = GetTPCOffset(trk->FrontTPC(), trk->FrontCryo(), isCPA);
+    front.shift = nodes[0]->Point3D().X() - front.offset;
+    front.tpc = geo::TPCID(trk->FrontCryo(), trk->FrontTPC());
+
+    TrackEnd back;
+    back.pos = nodes[nodes.size() - 1 - fNodesFromEnd]->Point3D();
+    back.dir = (back.pos - nodes[nodes.size() - 1 - (fNodesFromEnd + 1)]->Point3D()).Unit();
+    back.offset = GetTPCOffset(trk->BackTPC(), trk->BackCryo(), isCPA);
+    back.shift = nodes[nodes.size() - 1]->Point3D().X() - back.offset;
+    back.tpc = geo::TPCID(trk->BackCryo(), trk->BackTPC());
+
+    ends[t] = {front, back};
+    surfaceIndex.emplace_back(front.offset, t);
+    surfaceIndex.emplace_back(back.offset, t);
+  }
+
+  std::sort(surfaceIndex.begin(), surfaceIndex.end());
+}
+
 // Get the CPA and APA positions from the geometry
 void pma::PMAlgStitching::GetTPCXOffsets()
 {
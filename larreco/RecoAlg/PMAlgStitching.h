@@ -7,6 +7,8 @@
 #define PMAlgStitching_h
 
 #include <map>
+#include <utility>
+#include <vector>
 
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Comment.h"
@@ -14,7 +16,7 @@
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 
-class TVector3;
+#include "TVector3.h"
 
 namespace detinfo {
   class DetectorClocksData;
@@ -42,6 +44,12 @@ public:
       Name("NodesFromEnd"),
       Comment("Number of nodes we step back from the ends of the tracks to perform the stitching "
               "extrapolation.")};
+
+    fhicl::Atom<bool> FitStitchShift{
+      Name("FitStitchShift"),
+      Comment("Minimise the stitching score over a continuous x shift instead of scanning it in "
+              "0.1cm steps. The shift window is the same (+/-5cm)."),
+      false};
   };
 
   // Constructor
@@ -67,8 +75,30 @@ private:
                                TVector3& dir1,
                                TVector3& dir2,
                                double& shift) const;
+  double GetFittedStitchShift(const TVector3& pos1,
+                              const TVector3& pos2,
+                              const TVector3& dir1,
+                              const TVector3& dir2,
+                              double& shift) const;
   double GetTrackPairDelta(TVector3& pos1, TVector3& pos2, TVector3& dir1, TVector3& dir2) const;
 
+  // Stitching point and direction of one track end and the surface it is stitched at.
+  struct TrackEnd {
+    TVector3 pos;
+    TVector3 dir;
+    double offset; // x of the CPA or APA of the TPC of this end
+    double shift;  // x shift moving the end node onto the surface
+    geo::TPCID tpc;
+  };
+
+  // Front and back ends of each track (none if it is too short to be stitched), and
+  // the (surface x, track index) of all ends sorted by x.
+  void GetTrackEnds(const pma::TrkCandidateColl& tracks,
+                    unsigned int minTrkLength,
+                    bool isCPA,
+                    std::vector<std::vector<TrackEnd>>& ends,
+                    std::vector<std::pair<double, size_t>>& surfaceIndex);
+
   void GetTPCXOffsets();
   double GetTPCOffset(unsigned int tpc, unsigned int cryo, bool isCPA);
 
@@ -80,6 +110,7 @@ private:
                               // successful stitch.
   unsigned int fNodesFromEnd; // Number of nodes we step back to make the stitch
                               // extrapolation. Require to mitigate end effects on tracks.
+  bool fFitStitchShift;       // Minimise over a continuous shift rather than in steps.
 };
 
 #endif
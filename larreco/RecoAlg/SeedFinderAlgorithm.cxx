@@ -77,12 +77,11 @@ namespace trkf {
     // If we got here, we have enough spacepoints to potentially make seeds from these hits.
 
     // This is table will let us quickly look up which hits are in a given view / channel.
-    //  structure is OrgHits[View][Channel] = {index1,index2...}
-    // where the indices are of HitsFlat[index].
+    //  structure is OrgHits.OnChannel(View, Channel) = {index1,index2...}
+    // where the indices are of HitsFlat[index]. It also holds the hit coordinates
+    // used by the fits, so that they are converted only once.
 
-    std::vector<std::vector<std::vector<int>>> OrgHits(3);
-    for (size_t n = 0; n != 3; ++n)
-      OrgHits[n].resize(fNChannels);
+    HitTable OrgHits(detProp, HitsFlat, fPitches);
 
     // These two tables contain the hit to spacepoint mappings
 
@@ -97,12 +96,6 @@ namespace trkf {
 
     std::vector<char> HitStatus(HitsFlat.size(), 0);
 
-    // Fill the organizing map
-
-    for (size_t i = 0; i != HitsFlat.size(); ++i) {
-      OrgHits[HitsFlat.at(i)->View()][HitsFlat.at(i)->Channel()].push_back(i);
-    }
-
     // Fill the spacepoint / hit lookups
 
     for (size_t iSP = 0; iSP != spts.size(); ++iSP) {
@@ -114,11 +107,11 @@ namespace trkf {
         float ThisTime = HitsThisSP.at(iH)->PeakTime();
         float eta = 0.001;
 
-        for (size_t iOrg = 0; iOrg != OrgHits[ThisView][ThisChannel].size(); ++iOrg) {
-          if (fabs(ThisTime - HitsFlat.at(OrgHits[ThisView][ThisChannel][iOrg])->PeakTime()) <
-              eta) {
-            SpacePointsPerHit.at(OrgHits[ThisView][ThisChannel][iOrg]).push_back(iSP);
-            HitsPerSpacePoint.at(iSP).push_back(OrgHits[ThisView][ThisChannel][iOrg]);
+        auto const HitsThisChannel = OrgHits.OnChannel(ThisView, ThisChannel);
+        for (size_t iOrg = 0; iOrg != HitsThisChannel.size(); ++iOrg) {
+          if (fabs(ThisTime - HitsFlat.at(HitsThisChannel[iOrg])->PeakTime()) < eta) {
+            SpacePointsPerHit.at(HitsThisChannel[iOrg]).push_back(iSP);
+            HitsPerSpacePoint.at(iSP).push_back(HitsThisChannel[iOrg]);
           }
         }
       }
@@ -149,8 +142,7 @@ namespace trkf {
       std::vector<int> PointsUsed;
 
       // Find exactly one seed, starting at high Z
-      recob::Seed TheSeed =
-        FindSeedAtEnd(detProp, spts, PointStatus, PointsUsed, HitsFlat, OrgHits);
+      recob::Seed TheSeed = FindSeedAtEnd(spts, PointStatus, PointsUsed, HitsFlat, OrgHits);
 
       // If it was a good seed, collect up the relevant spacepoints
       // and add the seed to the return vector
@@ -164,7 +156,7 @@ namespace trkf {
           }
         }
         PointStatus[PointsUsed.at(0)] = 1;
-        ConsolidateSeed(detProp, TheSeed, HitsFlat, HitStatus, OrgHits, false);
+        ConsolidateSeed(TheSeed, HitsFlat, HitStatus, OrgHits, false);
       }
 
       if (TheSeed.IsValid()) {
@@ -189,8 +181,7 @@ namespace trkf {
             TVector3 Center, Direction;
             std::vector<double> ViewRMS;
             std::vector<int> HitsPerView;
-            GetCenterAndDirection(
-              detProp, HitsFlat, PresentHitList, Center, Direction, ViewRMS, HitsPerView);
+            GetCenterAndDirection(OrgHits, PresentHitList, Center, Direction, ViewRMS, HitsPerView);
 
             Direction = Direction.Unit() * TheSeed.GetLength();
 
@@ -208,7 +199,7 @@ namespace trkf {
             if (nViewsWithHits < 2) TheSeed.SetValidity(false);
 
             if (TheSeed.IsValid())
-              ConsolidateSeed(detProp, TheSeed, HitsFlat, HitStatus, OrgHits, fExtendSeeds);
+              ConsolidateSeed(TheSeed, HitsFlat, HitStatus, OrgHits, fExtendSeeds);
 
             // if we accidentally invalidated the seed, go back to the old one and escape
             else {
@@ -287,8 +278,7 @@ namespace trkf {
 
       std::vector<art::PtrVector<recob::Hit>> HitsInThisCollection(3);
 
-      GetCenterAndDirection(
-        detProp, HitsFlat, ListAllHits, SeedCenter, SeedDirection, ViewRMS, HitsPerView);
+      GetCenterAndDirection(OrgHits, ListAllHits, SeedCenter, SeedDirection, ViewRMS, HitsPerView);
 
       bool ThrowOutSeed = false;
 
@@ -304,7 +294,7 @@ namespace trkf {
       if (nViewsWithHits < 2 || (nViewsWithHits < 3 && !fAllow2DSeeds)) ThrowOutSeed = true;
 
       if (!ThrowOutSeed) {
-        ConsolidateSeed(detProp, TheSeed, HitsFlat, HitStatus, OrgHits, false);
+        ConsolidateSeed(TheSeed, HitsFlat, HitStatus, OrgHits, false);
 
         // Now we have consolidated, grab the right
         //  hits to find the RMS and refitted direction
@@ -314,7 +304,7 @@ namespace trkf {
         }
         std::vector<int> HitsPerView;
         GetCenterAndDirection(
-          detProp, HitsFlat, ListAllHits, SeedCenter, SeedDirection, ViewRMS, HitsPerView);
+          OrgHits, ListAllHits, SeedCenter, SeedDirection, ViewRMS, HitsPerView);
 
         int nViewsWithHits(0);
         for (size_t n = 0; n != 3; ++n) {
@@ -349,7 +339,6 @@ namespace trkf {
     SpacePointsPerHit.clear();
     HitsPerSpacePoint.clear();
     PointStatus.clear();
-    OrgHits.clear();
     HitStatus.clear();
 
     for (size_t i = 0; i != ReturnVector.size(); ++i) {
@@ -369,11 +358,10 @@ namespace trkf {
   // Latest extendseed method
   //
 
-  void SeedFinderAlgorithm::ConsolidateSeed(detinfo::DetectorPropertiesData const& detProp,
-                                            recob::Seed& TheSeed,
+  void SeedFinderAlgorithm::ConsolidateSeed(recob::Seed& TheSeed,
                                             art::PtrVector<recob::Hit> const& HitsFlat,
                                             std::vector<char>& HitStatus,
-                                            std::vector<std::vector<std::vector<int>>>& OrgHits,
+                                            HitTable const& OrgHits,
                                             bool Extend) const
   {
 
@@ -388,7 +376,7 @@ namespace trkf {
     for (size_t i = 0; i != HitStatus.size(); ++i) {
       if (HitStatus.at(i) == 2) {
         double disp, s;
-        GetHitDistAndProj(detProp, TheSeed, HitsFlat.at(i), disp, s);
+        GetHitDistAndProj(TheSeed, OrgHits, i, disp, s);
         if (fabs(s) > 1.2) {
           // This hit is not rightfully part of this seed, toss it.
           HitStatus[i] = 0;
@@ -425,18 +413,19 @@ namespace trkf {
       uint32_t LowestChan = itP->second.begin()->first;
       uint32_t HighestChan = itP->second.rbegin()->first;
       for (uint32_t c = LowestChan; c != HighestChan; ++c) {
-        for (size_t h = 0; h != OrgHits[View][c].size(); ++h) {
-          if (HitStatus[OrgHits[View][c].at(h)] == 0) {
-            GetHitDistAndProj(detProp, TheSeed, HitsFlat[OrgHits[View][c].at(h)], dist, s);
+        auto const HitsThisChannel = OrgHits.OnChannel(View, c);
+        for (size_t h = 0; h != HitsThisChannel.size(); ++h) {
+          if (HitStatus[HitsThisChannel.at(h)] == 0) {
+            GetHitDistAndProj(TheSeed, OrgHits, HitsThisChannel.at(h), dist, s);
             if (dist < fHitResolution) {
               NHitsThisSeed++;
 
-              HitStatus[OrgHits[View][c].at(h)] = 2;
+              HitStatus[HitsThisChannel.at(h)] = 2;
 
-              HitsInThisSeed[View][c].push_back(OrgHits[View][c].at(h));
+              HitsInThisSeed[View][c].push_back(HitsThisChannel.at(h));
             }
             else
-              HitStatus[OrgHits[View][c].at(h)] = 0;
+              HitStatus[HitsThisChannel.at(h)] = 0;
           }
         }
       }
@@ -496,18 +485,19 @@ namespace trkf {
         if (LowestChanInSeed[View] > 0) {
           for (uint32_t c = LowestChanInSeed[View] - 1; c != 0; --c) {
             bool GotOneThisChannel = false;
-            for (size_t h = 0; h != OrgHits[View][c].size(); ++h) {
-              if (HitStatus[OrgHits[View][c][h]] == 0) {
-                GetHitDistAndProj(detProp, TheSeed, HitsFlat[OrgHits[View][c].at(h)], dist, s);
+            auto const HitsThisChannel = OrgHits.OnChannel(View, c);
+            for (size_t h = 0; h != HitsThisChannel.size(); ++h) {
+              if (HitStatus[HitsThisChannel[h]] == 0) {
+                GetHitDistAndProj(TheSeed, OrgHits, HitsThisChannel.at(h), dist, s);
                 if (dist < fHitResolution) {
                   GotOneThisChannel = true;
                   if (s < 0) {
                     ToAddNegativeS[View].push_back(s);
-                    ToAddNegativeH[View].push_back(OrgHits[View][c].at(h));
+                    ToAddNegativeH[View].push_back(HitsThisChannel.at(h));
                   }
                   else {
                     ToAddPositiveS[View].push_back(s);
-                    ToAddPositiveH[View].push_back(OrgHits[View][c].at(h));
+                    ToAddPositiveH[View].push_back(HitsThisChannel.at(h));
                   }
                 }
               }
@@ -519,19 +509,20 @@ namespace trkf {
 
           for (uint32_t c = HighestChanInSeed[View] + 1; c != fNChannels; ++c) {
             bool GotOneThisChannel = false;
-            for (size_t h = 0; h != OrgHits[View][c].size(); ++h) {
-              if (HitStatus[OrgHits[View][c][h]] == 0) {
-                GetHitDistAndProj(detProp, TheSeed, HitsFlat[OrgHits[View][c].at(h)], dist, s);
+            auto const HitsThisChannel = OrgHits.OnChannel(View, c);
+            for (size_t h = 0; h != HitsThisChannel.size(); ++h) {
+              if (HitStatus[HitsThisChannel[h]] == 0) {
+                GetHitDistAndProj(TheSeed, OrgHits, HitsThisChannel.at(h), dist, s);
                 if (dist < fHitResolution) {
                   GotOneThisChannel = true;
                   if (s < 0) {
 
                     ToAddNegativeS[View].push_back(s);
-                    ToAddNegativeH[View].push_back(OrgHits[View][c].at(h));
+                    ToAddNegativeH[View].push_back(HitsThisChannel.at(h));
                   }
                   else {
                     ToAddPositiveS[View].push_back(s);
-                    ToAddPositiveH[View].push_back(OrgHits[View][c].at(h));
+                    ToAddPositiveH[View].push_back(HitsThisChannel.at(h));
                   }
                 }
               }
@@ -601,26 +592,18 @@ namespace trkf {
 
   //------------------------------------------------------------
 
-  void SeedFinderAlgorithm::GetHitDistAndProj(detinfo::DetectorPropertiesData const& detProp,
-                                              recob::Seed const& ASeed,
-                                              art::Ptr<recob::Hit> const& AHit,
+  void SeedFinderAlgorithm::GetHitDistAndProj(recob::Seed const& ASeed,
+                                              HitTable const& OrgHits,
+                                              size_t iHit,
                                               double& disp,
                                               double& s) const
   {
-    art::ServiceHandle<geo::Geometry const> geom;
+    auto const& xyzStart = OrgHits.WireZeroStart(iHit);
+    auto const& xyzEnd = OrgHits.WireZeroEnd(iHit);
 
-    double xyzStart[3], xyzEnd[3];
+    double HitX = OrgHits.Coords(iHit).HitX;
 
-    constexpr geo::TPCID tpcid{0, 0};
-    geo::PlaneID const planeID{tpcid, AHit->WireID().Plane};
-
-    geom->WireEndPoints(geo::WireID{planeID, 0}, xyzStart, xyzEnd);
-
-    double HitX = detProp.ConvertTicksToX(AHit->PeakTime(), planeID);
-    double HitXHigh = detProp.ConvertTicksToX(AHit->PeakTimePlusRMS(), planeID);
-    double HitXLow = detProp.ConvertTicksToX(AHit->PeakTimeMinusRMS(), planeID);
-
-    double HitWidth = HitXHigh - HitXLow;
+    double HitWidth = OrgHits.Coords(iHit).HitWidth;
 
     double pt[3], dir[3], err[3];
 
@@ -642,13 +625,11 @@ namespace trkf {
   // Try to find one seed at the high Z end of a set of spacepoints
   //
 
-  recob::Seed SeedFinderAlgorithm::FindSeedAtEnd(
-    detinfo::DetectorPropertiesData const& detProp,
-    std::vector<recob::SpacePoint> const& Points,
-    std::vector<char>& PointStatus,
-    std::vector<int>& PointsInRange,
-    art::PtrVector<recob::Hit> const& HitsFlat,
-    std::vector<std::vector<std::vector<int>>>& OrgHits) const
+  recob::Seed SeedFinderAlgorithm::FindSeedAtEnd(std::vector<recob::SpacePoint> const& Points,
+                                                 std::vector<char>& PointStatus,
+                                                 std::vector<int>& PointsInRange,
+                                                 art::PtrVector<recob::Hit> const& HitsFlat,
+                                                 HitTable const& OrgHits) const
   {
     // This pointer will be returned later
     recob::Seed ReturnSeed;
@@ -726,9 +707,10 @@ namespace trkf {
         geo::View_t View = (*itHit)->View();
 
         double eta = 0.01;
-        for (size_t iH = 0; iH != OrgHits[View][Channel].size(); ++iH) {
-          if (fabs(HitsFlat[OrgHits[View][Channel][iH]]->PeakTime() - (*itHit)->PeakTime()) < eta) {
-            HitMap[OrgHits[View][Channel][iH]] = true;
+        auto const HitsThisChannel = OrgHits.OnChannel(View, Channel);
+        for (size_t iH = 0; iH != HitsThisChannel.size(); ++iH) {
+          if (fabs(HitsFlat[HitsThisChannel[iH]]->PeakTime() - (*itHit)->PeakTime()) < eta) {
+            HitMap[HitsThisChannel[iH]] = true;
           }
         }
       }
@@ -741,8 +723,7 @@ namespace trkf {
     std::vector<double> ViewRMS;
     std::vector<int> HitsPerView;
 
-    GetCenterAndDirection(
-      detProp, HitsFlat, HitList, SeedCenter, SeedDirection, ViewRMS, HitsPerView);
+    GetCenterAndDirection(OrgHits, HitList, SeedCenter, SeedDirection, ViewRMS, HitsPerView);
 
     HitMap.clear();
     HitList.clear();
@@ -785,8 +766,7 @@ namespace trkf {
 
   //-----------------------------------------------------------
 
-  void SeedFinderAlgorithm::GetCenterAndDirection(detinfo::DetectorPropertiesData const& detProp,
-                                                  art::PtrVector<recob::Hit> const& HitsFlat,
+  void SeedFinderAlgorithm::GetCenterAndDirection(HitTable const& OrgHits,
                                                   std::vector<int>& HitsToUse,
                                                   TVector3& Center,
                                                   TVector3& Direction,
@@ -797,11 +777,6 @@ namespace trkf {
 
     std::map<uint32_t, bool> HitsClaimed;
 
-    // We'll store hit coordinates in each view into this vector
-
-    std::vector<std::vector<double>> HitTimes(3);
-    std::vector<std::vector<double>> HitWires(3);
-    std::vector<std::vector<double>> HitWidths(3);
     std::vector<double> MeanWireCoord(3, 0);
     std::vector<double> MeanTimeCoord(3, 0);
 
@@ -810,32 +785,19 @@ namespace trkf {
     std::vector<double> x(3, 0), y(3, 0), xx(3, 0), xy(3, 0), yy(3, 0), sig(3, 0);
 
     for (size_t i = 0; i != HitsToUse.size(); ++i) {
-      auto itHit = HitsFlat.begin() + HitsToUse[i];
-
-      size_t ViewIndex;
+      auto const& Coords = OrgHits.Coords(HitsToUse[i]);
 
-      auto const hitView = (*itHit)->View();
-      if (hitView == geo::kU)
-        ViewIndex = 0;
-      else if (hitView == geo::kV)
-        ViewIndex = 1;
-      else if (hitView == geo::kW)
-        ViewIndex = 2;
-      else {
+      if (Coords.ViewIndex < 0) {
         throw art::Exception(art::errors::LogicError)
-          << "SpacePointAlg does not support view " << geo::PlaneGeo::ViewName(hitView) << " (#"
-          << hitView << ")\n";
+          << "SpacePointAlg does not support view " << geo::PlaneGeo::ViewName(Coords.View)
+          << " (#" << Coords.View << ")\n";
       }
-      double WireCoord = (*itHit)->WireID().Wire * fPitches.at(ViewIndex);
-      double TimeCoord = detProp.ConvertTicksToX((*itHit)->PeakTime(), ViewIndex, 0, 0);
-      double TimeUpper = detProp.ConvertTicksToX((*itHit)->PeakTimePlusRMS(), ViewIndex, 0, 0);
-      double TimeLower = detProp.ConvertTicksToX((*itHit)->PeakTimeMinusRMS(), ViewIndex, 0, 0);
-      double Width = fabs(0.5 * (TimeUpper - TimeLower));
-      double Width2 = pow(Width, 2);
+      size_t ViewIndex = Coords.ViewIndex;
 
-      HitWires.at(ViewIndex).push_back(WireCoord);
-      HitTimes.at(ViewIndex).push_back(TimeCoord);
-      HitWidths.at(ViewIndex).push_back(fabs(0.5 * (TimeUpper - TimeLower)));
+      double WireCoord = Coords.WireCoord;
+      double TimeCoord = Coords.TimeCoord;
+      double Width = Coords.Width;
+      double Width2 = pow(Width, 2);
 
       MeanWireCoord.at(ViewIndex) += WireCoord;
       MeanTimeCoord.at(ViewIndex) += TimeCoord;
@@ -924,6 +886,110 @@ namespace trkf {
     }
   }
 
+  //-----------------------------------------------
+  SeedFinderAlgorithm::HitTable::HitTable(detinfo::DetectorPropertiesData const& detProp,
+                                          art::PtrVector<recob::Hit> const& HitsFlat,
+                                          std::vector<double> const& Pitches)
+  {
+    art::ServiceHandle<geo::Geometry const> geom;
+
+    // Channel range of the hits in each view. Channels outside it have no hits,
+    //  which is all the seed extension needs to know to stop there.
+    std::array<uint32_t, 3> LastChannel{{0, 0, 0}};
+    std::array<bool, 3> ViewHasHits{{false, false, false}};
+    fFirstChannel.fill(0);
+    for (size_t i = 0; i != HitsFlat.size(); ++i) {
+      size_t View = HitsFlat[i]->View();
+      if (View >= 3) continue;
+      uint32_t Channel = HitsFlat[i]->Channel();
+      if (!ViewHasHits[View] || Channel < fFirstChannel[View]) fFirstChannel[View] = Channel;
+      if (!ViewHasHits[View] || Channel > LastChannel[View]) LastChannel[View] = Channel;
+      ViewHasHits[View] = true;
+    }
+
+    // Counting sort of the hit indices by channel; the indices stay in increasing
+    //  order on each channel
+    for (size_t n = 0; n != 3; ++n)
+      fChannelBegin[n].assign(ViewHasHits[n] ? LastChannel[n] - fFirstChannel[n] + 2 : 1, 0);
+    for (size_t i = 0; i != HitsFlat.size(); ++i) {
+      size_t View = HitsFlat[i]->View();
+      if (View < 3) ++fChannelBegin[View][HitsFlat[i]->Channel() - fFirstChannel[View] + 1];
+    }
+    std::array<std::vector<size_t>, 3> Next;
+    for (size_t n = 0; n != 3; ++n) {
+      for (size_t c = 1; c != fChannelBegin[n].size(); ++c)
+        fChannelBegin[n][c] += fChannelBegin[n][c - 1];
+      Next[n].assign(fChannelBegin[n].begin(), fChannelBegin[n].end() - 1);
+      fHitIndices[n].resize(fChannelBegin[n].back());
+    }
+    for (size_t i = 0; i != HitsFlat.size(); ++i) {
+      size_t View = HitsFlat[i]->View();
+      if (View >= 3) continue;
+      fHitIndices[View][Next[View][HitsFlat[i]->Channel() - fFirstChannel[View]]++] = i;
+    }
+
+    // Coordinates of the hits as used by GetCenterAndDirection and GetHitDistAndProj
+    constexpr geo::TPCID tpcid{0, 0};
+    std::vector<bool> HaveWireZero;
+    fCoords.resize(HitsFlat.size());
+    for (size_t i = 0; i != HitsFlat.size(); ++i) {
+      recob::Hit const& AHit = *HitsFlat[i];
+      HitCoords& Coords = fCoords[i];
+
+      Coords.View = AHit.View();
+      if (Coords.View == geo::kU)
+        Coords.ViewIndex = 0;
+      else if (Coords.View == geo::kV)
+        Coords.ViewIndex = 1;
+      else if (Coords.View == geo::kW)
+        Coords.ViewIndex = 2;
+      else
+        Coords.ViewIndex = -1;
+      Coords.WireCoord = Coords.TimeCoord = Coords.Width = 0;
+      if (Coords.ViewIndex >= 0) {
+        size_t ViewIndex = Coords.ViewIndex;
+        Coords.WireCoord = AHit.WireID().Wire * Pitches.at(ViewIndex);
+        Coords.TimeCoord = detProp.ConvertTicksToX(AHit.PeakTime(), ViewIndex, 0, 0);
+        double TimeUpper = detProp.ConvertTicksToX(AHit.PeakTimePlusRMS(), ViewIndex, 0, 0);
+        double TimeLower = detProp.ConvertTicksToX(AHit.PeakTimeMinusRMS(), ViewIndex, 0, 0);
+        Coords.Width = fabs(0.5 * (TimeUpper - TimeLower));
+      }
+
+      geo::PlaneID const planeID{tpcid, AHit.WireID().Plane};
+      Coords.Plane = planeID.Plane;
+      Coords.HitX = detProp.ConvertTicksToX(AHit.PeakTime(), planeID);
+      double HitXHigh = detProp.ConvertTicksToX(AHit.PeakTimePlusRMS(), planeID);
+      double HitXLow = detProp.ConvertTicksToX(AHit.PeakTimeMinusRMS(), planeID);
+      Coords.HitWidth = HitXHigh - HitXLow;
+
+      if (Coords.Plane >= HaveWireZero.size()) {
+        HaveWireZero.resize(Coords.Plane + 1, false);
+        fWireZeroStart.resize(Coords.Plane + 1);
+        fWireZeroEnd.resize(Coords.Plane + 1);
+      }
+      if (!HaveWireZero[Coords.Plane]) {
+        geom->WireEndPoints(geo::WireID{planeID, 0},
+                            fWireZeroStart[Coords.Plane].data(),
+                            fWireZeroEnd[Coords.Plane].data());
+        HaveWireZero[Coords.Plane] = true;
+      }
+    }
+  }
+
+  //-----------------------------------------------
+  SeedFinderAlgorithm::HitTable::Range SeedFinderAlgorithm::HitTable::OnChannel(
+    geo::View_t View,
+    uint32_t Channel) const
+  {
+    size_t n = View;
+    if (n >= 3 || Channel < fFirstChannel[n] ||
+        Channel - fFirstChannel[n] + 1 >= fChannelBegin[n].size())
+      return Range{nullptr, nullptr};
+    size_t c = Channel - fFirstChannel[n];
+    int const* Indices = fHitIndices[n].data();
+    return Range{Indices + fChannelBegin[n][c], Indices + fChannelBegin[n][c + 1]};
+  }
+
   //-----------------------------------------------
   void SeedFinderAlgorithm::CalculateGeometricalElements()
   {
@@ -11,6 +11,8 @@
 
 #include "TVector3.h"
 
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
 namespace detinfo {
   class DetectorClocksData;
   class DetectorPropertiesData;
@@ -22,6 +24,10 @@ namespace recob {
   class Hit;
 }
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 
 namespace trkf {
@@ -67,6 +73,68 @@ namespace trkf {
     // Return the SpacePointAlg, as configured for the Seed Finding
 
   private:
+    //----------------------
+    // Per-call hit tables
+    //----------------------
+
+    // The hits of one FindSeeds call, organized once: the hit indices (into
+    //  HitsFlat) on each channel of each view, in increasing order, and the
+    //  coordinates of each hit used by the seed fits.
+    class HitTable {
+    public:
+      // Indices of the hits on one channel
+      struct Range {
+        const int* first;
+        const int* last;
+        size_t size() const { return last - first; }
+        int operator[](size_t i) const { return first[i]; }
+        int at(size_t i) const
+        {
+          if (i >= size()) throw std::out_of_range("HitTable::Range::at");
+          return first[i];
+        }
+      };
+
+      // Coordinates of one hit
+      struct HitCoords {
+        geo::View_t View;
+        int ViewIndex;    // 0, 1, 2 for U, V, W; -1 if not supported
+        double WireCoord; // wire number times pitch
+        double TimeCoord; // X of the peak time, view index used as plane
+        double Width;     // half the X width of the peak time +/- RMS, same
+        double HitX;      // X of the peak time in the hit plane of TPC 0
+        double HitWidth;  // X width of the peak time +/- RMS, same
+        unsigned int Plane;
+      };
+
+      HitTable(detinfo::DetectorPropertiesData const& detProp,
+               art::PtrVector<recob::Hit> const& HitsFlat,
+               std::vector<double> const& Pitches);
+
+      // Hits on a channel; empty outside the channel range of the hits
+      Range OnChannel(geo::View_t View, uint32_t Channel) const;
+
+      HitCoords const& Coords(size_t iHit) const { return fCoords[iHit]; }
+
+      // End points of wire 0 in the plane of the hit
+      std::array<double, 3> const& WireZeroStart(size_t iHit) const
+      {
+        return fWireZeroStart[fCoords[iHit].Plane];
+      }
+      std::array<double, 3> const& WireZeroEnd(size_t iHit) const
+      {
+        return fWireZeroEnd[fCoords[iHit].Plane];
+      }
+
+    private:
+      std::array<uint32_t, 3> fFirstChannel;
+      std::array<std::vector<size_t>, 3> fChannelBegin;
+      std::array<std::vector<int>, 3> fHitIndices;
+      std::vector<HitCoords> fCoords;
+      std::vector<std::array<double, 3>> fWireZeroStart;
+      std::vector<std::array<double, 3>> fWireZeroEnd;
+    };
+
     //----------------------
     // Internal methods
     //----------------------
@@ -80,36 +148,33 @@ namespace trkf {
     //  The second argument returns the hits catalogued by which
     //  seed they fell into (if any)
 
-    recob::Seed FindSeedAtEnd(detinfo::DetectorPropertiesData const& detProp,
-                              std::vector<recob::SpacePoint> const&,
+    recob::Seed FindSeedAtEnd(std::vector<recob::SpacePoint> const&,
                               std::vector<char>&,
                               std::vector<int>&,
                               art::PtrVector<recob::Hit> const& HitsFlat,
-                              std::vector<std::vector<std::vector<int>>>& OrgHits) const;
+                              HitTable const& OrgHits) const;
     // Find one seed at high Z from the spacepoint collection given. Latter arguments are
     //  for internal book keeping.
 
     //    size_t                      CountHits(std::vector<recob::SpacePoint> const& Points);
     // Counting the number of hits in each view which are associated with a set of SPs
 
-    void GetCenterAndDirection(detinfo::DetectorPropertiesData const& detProp,
-                               art::PtrVector<recob::Hit> const& HitsFlat,
+    void GetCenterAndDirection(HitTable const& OrgHits,
                                std::vector<int>& HitsToUse,
                                TVector3& Center,
                                TVector3& Direction,
                                std::vector<double>& ViewRMS,
                                std::vector<int>& HitsPerView) const;
 
-    void ConsolidateSeed(detinfo::DetectorPropertiesData const& detProp,
-                         recob::Seed& TheSeed,
+    void ConsolidateSeed(recob::Seed& TheSeed,
                          art::PtrVector<recob::Hit> const&,
                          std::vector<char>& HitStatus,
-                         std::vector<std::vector<std::vector<int>>>& OrgHits,
+                         HitTable const& OrgHits,
                          bool Extend) const;
 
-    void GetHitDistAndProj(detinfo::DetectorPropertiesData const& detProp,
-                           recob::Seed const& ASeed,
-                           art::Ptr<recob::Hit> const& AHit,
+    void GetHitDistAndProj(recob::Seed const& ASeed,
+                           HitTable const& OrgHits,
+                           size_t iHit,
                            double& disp,
                            double& s) const;
 
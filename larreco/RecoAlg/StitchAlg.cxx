@@ -12,8 +12,12 @@
 #include "larreco/RecoAlg/StitchAlg.h"
 
 // C/C++ standard libraries
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 //Framework includes:
@@ -23,6 +27,76 @@
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+namespace {
+
+  // Track end points hashed into cubic cells at least as large as the separation
+  // tolerance, so ends closer than the tolerance are in the same or adjacent cells.
+  // Points whose cell can not be computed are kept apart and always returned.
+  class EndPointGrid {
+  public:
+    explicit EndPointGrid(double sepTol) : fCellSize(sepTol * (1. + 1e-6)) {}
+
+    void Add(const TVector3& point, int track)
+    {
+      if (!(fCellSize > 0)) return; // nothing can be matched
+      Cell cell;
+      if (GetCell(point, cell))
+        fCells[cell].push_back(track);
+      else
+        fOther.push_back(track);
+    }
+
+    // appends the tracks with index above minTrack having an end near point
+    void Neighbours(const TVector3& point, int minTrack, std::vector<int>& tracks) const
+    {
+      for (int track : fOther)
+        if (track > minTrack) tracks.push_back(track);
+      Cell cell;
+      if (!GetCell(point, cell)) return;
+      Cell near;
+      for (long long dx = -1; dx <= 1; ++dx) {
+        near[0] = cell[0] + dx;
+        for (long long dy = -1; dy <= 1; ++dy) {
+          near[1] = cell[1] + dy;
+          for (long long dz = -1; dz <= 1; ++dz) {
+            near[2] = cell[2] + dz;
+            auto const itr = fCells.find(near);
+            if (itr == fCells.end()) continue;
+            for (int track : itr->second)
+              if (track > minTrack) tracks.push_back(track);
+          }
+        }
+      }
+    }
+
+  private:
+    using Cell = std::array<long long, 3>;
+
+    struct CellHash {
+      size_t operator()(const Cell& c) const
+      {
+        std::hash<long long> h;
+        return h(c[0]) ^ (h(c[1]) * 0x9e3779b97f4a7c15) ^ (h(c[2]) * 0xc2b2ae3d27d4eb4f);
+      }
+    };
+
+    bool GetCell(const TVector3& point, Cell& cell) const
+    {
+      for (int i = 0; i < 3; ++i) {
+        double const c = std::floor(point[i] / fCellSize);
+        if (!(std::abs(c) < 1e15)) return false;
+        cell[i] = static_cast<long long>(c);
+      }
+      return true;
+    }
+
+    double fCellSize;
+    std::unordered_map<Cell, std::vector<int>, CellHash> fCells;
+    std::vector<int> fOther;
+  };
+
+}
+
 trkf::StitchAlg::StitchAlg(fhicl::ParameterSet const& pset)
 {
   ftNo = 0;
@@ -50,22 +124,40 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
 
   EvtArg.getByLabel(trackModuleLabelArg, ftListHandle);
 
-  // An element of fh and ft for each outer track. Keep the cos and sep parameters of the match and a string that indicates whether it's the second track's head or tail that gives the match, along with ii, jj, the indices of the outer and inner tracks.
+  // An element of fh and ft for each outer track. Keep the cos and sep parameters of the match and the end of the second track (head or tail) that gives the match, along with ii, jj, the indices of the outer and inner tracks.
   ft.clear();
   fh.clear();
 
   int ntrack = ftListHandle->size();
   //    std::cout << "StitchAlg.FindHeadsAndTails: Number of tracks in " << ntrack << std::endl;
+
+  // End points and directions of all tracks, and a grid of the end points so that
+  // only tracks with an end within the separation tolerance are considered as inner
+  // tracks. The others can not satisfy any of the match conditions below.
+  std::vector<TVector3> start(ntrack), end(ntrack), startDir(ntrack), endDir(ntrack);
+  EndPointGrid grid(fSepTol);
   for (int ii = 0; ii < ntrack; ++ii) {
-    art::Ptr<recob::Track> ptrack1(ftListHandle, ii);
-    const recob::Track& track1 = *ptrack1;
-    const TVector3 start1(track1.Vertex<TVector3>());
-    const TVector3 end1(track1.End<TVector3>());
-    const TVector3 start1Dir(track1.VertexDirection<TVector3>());
-    const TVector3 end1Dir(track1.EndDirection<TVector3>());
+    const recob::Track& track = (*ftListHandle)[ii];
+    start[ii] = track.Vertex<TVector3>();
+    end[ii] = track.End<TVector3>();
+    startDir[ii] = track.VertexDirection<TVector3>();
+    endDir[ii] = track.EndDirection<TVector3>();
+    grid.Add(start[ii], ii);
+    grid.Add(end[ii], ii);
+  }
+
+  // outer tracks whose head (tail) got matched to each track
+  std::vector<std::vector<int>> headMatches(ntrack), tailMatches(ntrack);
+
+  std::vector<int> candidates;
+  for (int ii = 0; ii < ntrack; ++ii) {
+    const TVector3& start1(start[ii]);
+    const TVector3& end1(end[ii]);
+    const TVector3& start1Dir(startDir[ii]);
+    const TVector3& end1Dir(endDir[ii]);
     // For each outer track, make a vector of 1 candidate track. Doesn't need to be a vector except for desire to have a 2-iteration history.
-    std::vector<std::tuple<std::string, int, int, double, double>> headvv;
-    std::vector<std::tuple<std::string, int, int, double, double>> tailvv;
+    std::vector<EndMatch> headvv;
+    std::vector<EndMatch> tailvv;
 
     // For head/tail keep a vector of candidate (cos,sep)
     std::vector<std::vector<std::pair<double, double>>> matchhead;
@@ -74,14 +166,19 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
     bool head(false);
     bool tail(false);
 
-    for (int jj = ii + 1; jj < ntrack; ++jj) {
-      art::Ptr<recob::Track> ptrack2(ftListHandle, jj);
-      const recob::Track& track2 = *ptrack2;
-      const TVector3& start2(track2.Vertex<TVector3>());
-      const TVector3& end2(track2.End<TVector3>());
-      const TVector3& start2Dir(track2.VertexDirection<TVector3>());
-      const TVector3& end2Dir(track2.EndDirection<TVector3>());
-      std::string sHT2("NA"); // track2 (receptor track) H or T is tagged as matched
+    // inner tracks in increasing index order, as the selection below depends on it
+    candidates.clear();
+    grid.Neighbours(start1, ii, candidates);
+    grid.Neighbours(end1, ii, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (int jj : candidates) {
+      const TVector3& start2(start[jj]);
+      const TVector3& end2(end[jj]);
+      const TVector3& start2Dir(startDir[jj]);
+      const TVector3& end2Dir(endDir[jj]);
+      TrackEnd sHT2(TrackEnd::kNone); // track2 (receptor track) H or T is tagged as matched
 
       bool c12((std::abs(start1Dir.Dot(end2Dir)) > fCosAngTol) &&
                ((start1 - end2).Mag() < fSepTol));
@@ -93,16 +190,16 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
 
       if (c12 || c21 || c11 || c22) {
 
-        sHT2 = "NA";
+        sHT2 = TrackEnd::kNone;
         if (c12 || c11) { head = true; }
-        if (c11) { sHT2 = "H"; }
+        if (c11) { sHT2 = TrackEnd::kHead; }
         else if (c12) {
-          sHT2 = "T";
+          sHT2 = TrackEnd::kTail;
         }
         if (c21 || c22) { tail = true; }
-        if (c21) { sHT2 = "H"; }
+        if (c21) { sHT2 = TrackEnd::kHead; }
         else if (c22) {
-          sHT2 = "T";
+          sHT2 = TrackEnd::kTail;
         }
 
         if (head && tail) // split the tie by distance
@@ -138,15 +235,13 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
               matchhead.size() == 1) {
             if (matchhead.size() > 1) matchhead.erase(matchhead.begin());
             if (headvv.size() > 1) headvv.erase(headvv.begin());
-            if (!sHT2.compare("H")) {
-              auto tupTmp = std::make_tuple(
-                sHT2, ii, jj, matchhead.back().at(0).first, matchhead.back().at(0).second);
-              headvv.push_back(tupTmp);
+            if (sHT2 == TrackEnd::kHead) {
+              headvv.push_back(
+                {sHT2, ii, jj, matchhead.back().at(0).first, matchhead.back().at(0).second});
             }
             else {
-              auto tupTmp = std::make_tuple(
-                sHT2, ii, jj, matchhead.back().at(1).first, matchhead.back().at(1).second);
-              headvv.push_back(tupTmp);
+              headvv.push_back(
+                {sHT2, ii, jj, matchhead.back().at(1).first, matchhead.back().at(1).second});
             }
           }
           else
@@ -172,15 +267,13 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
               matchtail.size() == 1) {
             if (matchtail.size() > 1) matchtail.erase(matchtail.begin());
             if (tailvv.size() > 1) tailvv.erase(tailvv.begin());
-            if (!sHT2.compare("T")) {
-              auto tupTmp = std::make_tuple(
-                sHT2, ii, jj, matchtail.back().at(0).first, matchtail.back().at(0).second);
-              tailvv.push_back(tupTmp);
+            if (sHT2 == TrackEnd::kTail) {
+              tailvv.push_back(
+                {sHT2, ii, jj, matchtail.back().at(0).first, matchtail.back().at(0).second});
             }
             else {
-              auto tupTmp = std::make_tuple(
-                sHT2, ii, jj, matchtail.back().at(1).first, matchtail.back().at(1).second);
-              tailvv.push_back(tupTmp);
+              tailvv.push_back(
+                {sHT2, ii, jj, matchtail.back().at(1).first, matchtail.back().at(1).second});
             }
           }
           else
@@ -193,27 +286,25 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
 	    std::cout << "abs(end1Dir.Dot(start2Dir)) " << std::abs(end1Dir.Dot(start2Dir)) << ", start2-end1.Mag(): " << (start2-end1).Mag() << std::endl;
 	    std::cout << "abs(start1Dir.Dot(start2Dir)) " << std::abs(start1Dir.Dot(start2Dir)) << ", start1-start2.Mag(): " << (start1-start2).Mag() << std::endl;
 	    std::cout << "abs(end1Dir.Dot(end2Dir)) " << std::abs(end1Dir.Dot(end2Dir)) << ", end1-end2.Mag(): " << (end1-end2).Mag() << std::endl;
-	    std::cout << "sHT2 " << sHT2 << std::endl;
 	    */
       } // end c11||c12||c21||c22
 
       // We've been careful to pick the best jj match for this iith track head and tail.
       // Now we need to be sure that for the jjth track head/tail we don't have two ii trks.
       if (headvv.size()) {
-        int otrk = std::get<2>(headvv.back()); // jj'th track for this iith trk
+        int otrk = headvv.back().inner; // jj'th track for this iith trk
         // H or T of this jj'th trk we're matched to.
-        std::string sotrkht(std::get<0>(headvv.back()));
-        for (int kk = 0; kk < ii; ++kk) {
-          if (std::get<2>(fh.at(kk)) == otrk && !sotrkht.compare(std::get<0>(fh.at(kk)))) {
+        TrackEnd sotrkht(headvv.back().end);
+        // earlier outer tracks matched to it, in increasing order
+        for (int kk : headMatches[otrk]) {
+          if (fh.at(kk).inner == otrk && sotrkht == fh.at(kk).end) {
             // check matching sep and pick the best one. Either erase this
             // headvv (and it'll get null settings later below) or null out
             // the parameters in fh.
-            if (std::get<4>(headvv.back()) < std::get<4>(fh.at(kk)) &&
-                std::get<4>(headvv.back()) != 0.0) {
-              auto tupTmp2 = std::make_tuple(std::string("NA"), kk, -12, 0.0, 0.0);
-              fh.at(kk) = tupTmp2;
+            if (headvv.back().sep < fh.at(kk).sep && headvv.back().sep != 0.0) {
+              fh.at(kk) = {TrackEnd::kNone, kk, -12, 0.0, 0.0};
             }
-            else if (std::get<4>(headvv.back()) != 0.0) {
+            else if (headvv.back().sep != 0.0) {
               headvv.pop_back();
               break;
             }
@@ -221,19 +312,18 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
         }
       }
       if (tailvv.size()) {
-        int otrk = std::get<2>(tailvv.back()); // jj'th track for this iith trk
+        int otrk = tailvv.back().inner; // jj'th track for this iith trk
         // H or T of this jj'th trk we're matched to.
-        std::string sotrkht(std::get<0>(tailvv.back()));
-        for (int kk = 0; kk < ii; ++kk) {
-          if (std::get<2>(ft.at(kk)) == otrk && !sotrkht.compare(std::get<0>(ft.at(kk)))) {
+        TrackEnd sotrkht(tailvv.back().end);
+        // earlier outer tracks matched to it, in increasing order
+        for (int kk : tailMatches[otrk]) {
+          if (ft.at(kk).inner == otrk && sotrkht == ft.at(kk).end) {
             // check matching sep and pick the best one. erase either this
             // tailvv or null out the parameters in ft.
-            if (std::get<4>(tailvv.back()) < std::get<4>(ft.at(kk)) &&
-                std::get<4>(tailvv.back()) != 0.0) {
-              auto tupTmp2 = std::make_tuple(std::string("NA"), kk, -12, 0.0, 0.0);
-              ft.at(kk) = tupTmp2;
+            if (tailvv.back().sep < ft.at(kk).sep && tailvv.back().sep != 0.0) {
+              ft.at(kk) = {TrackEnd::kNone, kk, -12, 0.0, 0.0};
             }
-            else if (std::get<4>(tailvv.back()) != 0.0) {
+            else if (tailvv.back().sep != 0.0) {
               tailvv.pop_back();
               break;
             }
@@ -243,13 +333,14 @@ void trkf::StitchAlg::FindHeadsAndTails(const art::Event& EvtArg,
 
     } // jj
 
-    auto tupTmp2 = std::make_tuple(std::string("NA"), ii, -12, 0.0, 0.0);
+    const EndMatch noMatch{TrackEnd::kNone, ii, -12, 0.0, 0.0};
     // We always have our best 1-element tailvv and headvv for trk o at this point
-    if (!headvv.size()) headvv.push_back(tupTmp2);
-    if (!tailvv.size()) tailvv.push_back(tupTmp2);
-    //      std::cout << "StitchAlg::FindHeadsAndTails: headvv, tailvv .get<0> is " << std::get<0>(headvv.back()) << ", " << std::get<0>(tailvv.back()) << std::endl;
+    if (!headvv.size()) headvv.push_back(noMatch);
+    if (!tailvv.size()) tailvv.push_back(noMatch);
     fh.push_back(headvv.back());
     ft.push_back(tailvv.back());
+    if (fh.back().inner >= 0) headMatches[fh.back().inner].push_back(ii);
+    if (ft.back().inner >= 0) tailMatches[ft.back().inner].push_back(ii);
 
   } // ii
 
@@ -291,8 +382,8 @@ void trkf::StitchAlg::FirstStitch(const std::vector<art::PtrVector<recob::Track>
       auto itvfHT = fHT.begin() + size_t(itvArg - fTrackVec.begin());
       if ((*itvfHT).size() && (
                                 // was fHT.back()
-                                (cnt == 1 && !(*itvfHT).at(cnt - 1).compare(0, 1, "H")) ||
-                                (cnt > 1 && !(*itvfHT).at(cnt - 2).compare(1, 1, "T"))))
+                                (cnt == 1 && (*itvfHT).at(cnt - 1).first == TrackEnd::kHead) ||
+                                (cnt > 1 && (*itvfHT).at(cnt - 2).second == TrackEnd::kTail)))
         ptHere = (*it).get()->NumberTrajectoryPoints() - pt - 1;
 
       try {
@@ -335,13 +426,13 @@ void trkf::StitchAlg::WalkStitch()
 {
 
   art::PtrVector<recob::Track> compTrack;
-  std::vector<std::string> trackStatus(fh.size(), "NotDone"); // H or T
-  std::vector<std::string> HT2;                               // H or T
+  std::vector<bool> trackDone(fh.size(), false);
+  std::vector<std::pair<TrackEnd, TrackEnd>> HT2; // H or T
 
   for (unsigned int ii = 0; ii < fh.size(); ++ii) // same as t.size()
 
   {
-    if (!trackStatus.at(ii).compare("Done")) continue;
+    if (trackDone.at(ii)) continue;
 
     const art::Ptr<recob::Track> th(ftListHandle, ii);
     compTrack.push_back(th);
@@ -352,78 +443,80 @@ void trkf::StitchAlg::WalkStitch()
     // of vtxsJoined to "Done" for that track.
     bool chain(true);
     int walk(ii);
-    std::string sh(std::get<0>(fh.at(walk)));
-    std::string st("NA");
+    TrackEnd sh(fh.at(walk).end);
+    TrackEnd st(TrackEnd::kNone);
     while (chain) {
       int hInd = -12;
       int tInd = -12;
       if (walk != (int)ii) {
-        sh = std::get<0>(fh.at(walk));
-        st = std::get<0>(ft.at(walk));
+        sh = fh.at(walk).end;
+        st = ft.at(walk).end;
       }
 
-      //	    std::cout << "StichAlg::WalkStitch(): Inside head chain. walk(track), sh, st, " << walk << ", " << sh << ", "<<st <<", connected to tracks: " << std::get<2>(fh.at(walk))<<", "  << std::get<2>(ft.at(walk)) <<std::endl;
-      if (!sh.compare("H") || !sh.compare("T")) {
+      //	    std::cout << "StichAlg::WalkStitch(): Inside head chain. walk(track), sh, st, " << walk << ", " << sh << ", "<<st <<", connected to tracks: " << fh.at(walk).inner<<", "  << ft.at(walk).inner <<std::endl;
+      if (sh != TrackEnd::kNone) {
 
-        hInd = std::get<2>(fh.at(walk)); // index of track that walk is connected to.
+        hInd = fh.at(walk).inner; // index of track that walk is connected to.
         //		std::cout << "WalkStitch(): hInd is " << hInd << std::endl;
 
         const art::Ptr<recob::Track> th2(ftListHandle, hInd);
         compTrack.push_back(th2);
-        HT2.push_back("H" + sh);
+        HT2.push_back({TrackEnd::kHead, sh});
       }
 
-      if ((!st.compare("H") || !st.compare("T"))) {
-        tInd = std::get<2>(ft.at(walk));
+      if (st != TrackEnd::kNone) {
+        tInd = ft.at(walk).inner;
         //		std::cout << "WalkStitch(): tInd is " << tInd << std::endl;
         const art::Ptr<recob::Track> th2(ftListHandle, tInd);
         compTrack.push_back(th2);
-        HT2.push_back("T" + st); // since we will eventually read from 0th element forward
+        // since we will eventually read from 0th element forward
+        HT2.push_back({TrackEnd::kTail, st});
       }
       if (hInd != -12) walk = hInd;
       if (tInd != -12) walk = tInd;
-      if (!sh.compare("NA") && !st.compare("NA")) chain = false;
+      if (sh == TrackEnd::kNone && st == TrackEnd::kNone) chain = false;
 
-      trackStatus.at(walk) = "Done";
+      trackDone.at(walk) = true;
     } // while
 
     // It is possible that our first (ii'th) track had a head _and_ a tail match. Thus, we must
     // see if tail goes anywhere. walk with it. Insert, don't push_back, to compTrack.
     chain = true;
     walk = ii;
-    sh = "NA";
-    st = std::get<0>(ft.at(walk));
+    sh = TrackEnd::kNone;
+    st = ft.at(walk).end;
     while (chain) {
       int hInd = -12;
       int tInd = -12;
       if (walk != (int)ii) {
-        sh = std::get<0>(fh.at(walk));
-        st = std::get<0>(ft.at(walk));
+        sh = fh.at(walk).end;
+        st = ft.at(walk).end;
       }
 
-      //	    std::cout << "StichAlg::WalkStitch(): Inside tail chain. walk(track), sh, st, " << walk << ", " << sh << ", "<<st <<", connected to tracks: " << std::get<2>(fh.at(walk))<<", "  << std::get<2>(ft.at(walk)) <<std::endl;
-      if (!sh.compare("H") || !sh.compare("T")) {
+      //	    std::cout << "StichAlg::WalkStitch(): Inside tail chain. walk(track), sh, st, " << walk << ", " << sh << ", "<<st <<", connected to tracks: " << fh.at(walk).inner<<", "  << ft.at(walk).inner <<std::endl;
+      if (sh != TrackEnd::kNone) {
 
-        hInd = std::get<2>(fh.at(walk)); // index of track that walk is connected to.
+        hInd = fh.at(walk).inner; // index of track that walk is connected to.
         //		std::cout << "WalkStitch(): hInd is " << hInd << std::endl;
 
         const art::Ptr<recob::Track> th2(ftListHandle, hInd);
         compTrack.insert(compTrack.begin(), th2);
-        HT2.insert(HT2.begin(), sh + "H");
+        HT2.insert(HT2.begin(), {sh, TrackEnd::kHead});
       }
 
-      if ((!st.compare("H") || !st.compare("T"))) {
-        tInd = std::get<2>(ft.at(walk));
+      if (st != TrackEnd::kNone) {
+        tInd = ft.at(walk).inner;
         //		std::cout << "WalkStitch(): tInd is " << tInd << std::endl;
         const art::Ptr<recob::Track> th2(ftListHandle, tInd);
         compTrack.insert(compTrack.begin(), th2);
-        HT2.insert(HT2.begin(), st + "T"); // since we will eventually read from 0th element forward
+        // since we will eventually read from 0th element forward
+        HT2.insert(HT2.begin(), {st, TrackEnd::kTail});
       }
       if (hInd != -12) walk = hInd;
       if (tInd != -12) walk = tInd;
-      if (!sh.compare("NA") && !st.compare("NA")) chain = false;
+      if (sh == TrackEnd::kNone && st == TrackEnd::kNone) chain = false;
 
-      trackStatus.at(walk) = "Done";
+      trackDone.at(walk) = true;
     } // while
 
     // inside FirstStitch() push_back onto the vec<vec> of components and the vec of stitched composite.
@@ -476,31 +569,40 @@ bool trkf::StitchAlg::CommonComponentStitch()
   std::vector<art::PtrVector<recob::Track>>::iterator osiComposite, osjComposite;
   art::PtrVector<recob::Track>::iterator osiAgg, osjAgg;
 
+  // Composites each component track appears in, in increasing order. The first
+  // composite having a component in common with a later one, the first of those later
+  // ones and the first common component are looked up here instead of comparing all
+  // components of all pairs of composites.
+  std::map<art::Ptr<recob::Track>, std::vector<size_t>> compositesOf;
+  for (size_t ic = 0; ic < fTrackComposite.size(); ++ic) {
+    for (auto const& trk : fTrackComposite[ic]) {
+      auto& composites = compositesOf[trk];
+      if (composites.empty() || composites.back() != ic) composites.push_back(ic);
+    }
+  }
+
   bool match(false);
-  int ciit(0);
-  for (auto iit = fTrackComposite.begin(); iit != fTrackComposite.end() && !match; ++iit) {
-    ciit++;
-    int cjit(ciit);
-    for (auto jit = iit + 1; jit != fTrackComposite.end() && !match; ++jit) {
-      cjit++;
-      for (auto iiit = iit->begin(); iiit != iit->end() && !match; ++iiit) {
-        for (auto jjit = jit->begin(); jjit != jit->end() && !match; ++jjit) {
-          if (*iiit == *jjit) // 2 components from 2 different composites are the same
-          {
-            // head is attached to one trk and tail to another.
-            //		      std::cout << "StitchAlg::CommonComponentStitch: We have two aggregate tracks that have a common component and need to be further stitched. " << std::endl;
-
-            match = true;
-            osiComposite = iit;
-            osjComposite = jit;
-            osciit = ciit;
-            oscjit = cjit;
-            osiAgg = iiit;
-            osjAgg = jjit; // yes, unneeded, but we keep it for notational clarity
-          }
-        }
-      }
+  for (size_t ic = 0; ic < fTrackComposite.size() && !match; ++ic) {
+    size_t jc = fTrackComposite.size();
+    for (auto const& trk : fTrackComposite[ic]) {
+      auto const& composites = compositesOf[trk];
+      auto const next = std::upper_bound(composites.begin(), composites.end(), ic);
+      if (next != composites.end()) jc = std::min(jc, *next);
     }
+    if (jc == fTrackComposite.size()) continue;
+
+    // head is attached to one trk and tail to another.
+    match = true;
+    osiComposite = fTrackComposite.begin() + ic;
+    osjComposite = fTrackComposite.begin() + jc;
+    osciit = ic + 1;
+    oscjit = jc + 1;
+    osiAgg = std::find_if(
+      osiComposite->begin(), osiComposite->end(), [&](art::Ptr<recob::Track> const& trk) {
+        auto const& composites = compositesOf[trk];
+        return std::binary_search(composites.begin(), composites.end(), jc);
+      });
+    osjAgg = std::find(osjComposite->begin(), osjComposite->end(), *osiAgg);
   }
   if (!match) return match;
 
@@ -518,8 +620,8 @@ bool trkf::StitchAlg::CommonComponentStitch()
   // insert the non-redundant osciit tracks onto front (back) of osjit
   // insert the non-redundant osciit vtx links onto front (back) of fHT.begin()+oscjit-1
 
-  std::vector<std::vector<std::string>>::iterator siit(fHT.begin() + osciit - 1);
-  std::vector<std::vector<std::string>>::iterator sjit(fHT.begin() + oscjit - 1);
+  auto siit = fHT.begin() + osciit - 1;
+  auto sjit = fHT.begin() + oscjit - 1;
   size_t itdiff(osiComposite->end() - osiComposite->begin());
   if (osjAgg == osjComposite->begin()) {
 
@@ -22,7 +22,7 @@ namespace art {
 
 // C/C++ standard libraries
 #include <string>
-#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace trkf {
@@ -49,15 +49,28 @@ namespace trkf {
     art::Handle<std::vector<recob::Track>> ftListHandle;
 
   private:
-    std::vector<std::tuple<std::string, int, int, double, double>> fh;
-    std::vector<std::tuple<std::string, int, int, double, double>> ft;
+    // end of the inner track an outer track end is matched to
+    enum class TrackEnd : unsigned char { kNone, kHead, kTail };
+
+    // best match of one end of the outer track: the matched end and index of the
+    // inner track (-12 if none), and the cos and separation of the match
+    struct EndMatch {
+      TrackEnd end;
+      int outer;
+      int inner;
+      double cos;
+      double sep;
+    };
+
+    std::vector<EndMatch> fh;
+    std::vector<EndMatch> ft;
     int ftNo;
     double fCosAngTol;
     double fSepTol;
 
     std::vector<art::PtrVector<recob::Track>> fTrackComposite;
     std::vector<recob::Track> fTrackVec;
-    std::vector<std::vector<std::string>> fHT;
+    std::vector<std::vector<std::pair<TrackEnd, TrackEnd>>> fHT;
   };
 
 } // namespace
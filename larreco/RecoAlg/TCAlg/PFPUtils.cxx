@@ -15,6 +15,7 @@
 #include <limits.h>
 #include <limits>
 #include <stdlib.h>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -33,6 +34,21 @@
 #include "larreco/RecoAlg/TCAlg/TCVertex.h"
 #include "larreco/RecoAlg/TCAlg/Utils.h"
 
+namespace {
+
+  // Pack the Tj IDs of a 2- or 3-plane match into a single key for the match -> index lookup
+  // in the MatchNPlanes functions. Tj IDs are well below 2^21.
+  template <typename T, std::size_t N>
+  inline unsigned long long MatchKey(const std::array<T, N>& tIDs)
+  {
+    unsigned long long key = 0;
+    for (auto tid : tIDs)
+      key = (key << 21) | (unsigned long long)tid;
+    return key;
+  }
+
+} // namespace
+
 namespace tca {
 
   using namespace detail; // SortEntry, valsDecreasing(), valsIncreasing();
@@ -714,6 +730,8 @@ namespace tca {
     std::vector<std::array<int, 3>> mtIDs;
     // and a matching vector for the count
     std::vector<unsigned short> mCnt;
+    // index of each Tj combination in mtIDs
+    std::unordered_map<unsigned long long, unsigned int> mIndex;
     // ignore Tj matches after hitting a user-defined limit
     unsigned short maxCnt = USHRT_MAX;
     if (tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcc.match3DCuts[1];
@@ -736,10 +754,9 @@ namespace tca {
       } // iht
       if (cnt != 3) continue;
       // look for it in the list of tj combinations
-      unsigned short indx = 0;
-      for (indx = 0; indx < mtIDs.size(); ++indx)
-        if (tIDs == mtIDs[indx]) break;
-      if (indx == mtIDs.size()) {
+      auto [mit, isNew] = mIndex.try_emplace(MatchKey(tIDs), mtIDs.size());
+      unsigned int indx = mit->second;
+      if (isNew) {
         // not found so add it to mtIDs and add another element to mCnt
         mtIDs.push_back(tIDs);
         mCnt.push_back(0);
@@ -831,31 +848,34 @@ namespace tca {
     std::vector<std::array<unsigned short, 3>> mtIDs;
     // and a matching vector for the count
     std::vector<unsigned short> mCnt;
+    // index of each Tj combination in mtIDs
+    std::unordered_map<unsigned long long, unsigned int> mIndex;
     // ignore Tj matches after hitting a user-defined limit
     unsigned short maxCnt = USHRT_MAX;
     if (tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcc.match3DCuts[1];
-    // a list of those Tjs
-    std::vector<unsigned short> tMaxed;
+    // flags for those Tjs, indexed by Tj ID
+    std::vector<bool> tMaxed(slc.tjs.size() + 1, false);
 
     for (std::size_t ipt = 0; ipt < slc.mallTraj.size() - 1; ++ipt) {
       auto& iTjPt = slc.mallTraj[ipt];
       // see if we hit the maxCnt limit
-      if (std::find(tMaxed.begin(), tMaxed.end(), iTjPt.id) != tMaxed.end()) continue;
+      if (tMaxed[iTjPt.id]) continue;
       auto& itp = slc.tjs[iTjPt.id - 1].Pts[iTjPt.ipt];
       unsigned int iPlane = iTjPt.plane;
       unsigned int iWire = std::nearbyint(itp.Pos[0]);
       tIDs[iPlane] = iTjPt.id;
+      // mallTraj is sorted by increasing xlo so points beyond this x can neither overlap
+      // iTjPt (xlo > xhi) nor pass the xcut
+      float xmax = std::min(iTjPt.xhi, iTjPt.xhi + xcut);
       bool hitMaxCnt = false;
       for (std::size_t jpt = ipt + 1; jpt < slc.mallTraj.size() - 1; ++jpt) {
         auto& jTjPt = slc.mallTraj[jpt];
+        // check for x range overlap. We know that jTjPt.xlo is >= iTjPt.xlo because of the sort
+        if (jTjPt.xlo > xmax) break;
         // ensure that the planes are different
         if (jTjPt.plane == iTjPt.plane) continue;
-        // check for x range overlap. We know that jTjPt.xlo is >= iTjPt.xlo because of the sort
-        if (jTjPt.xlo > iTjPt.xhi) continue;
-        // break out if the x range difference becomes large
-        if (jTjPt.xlo > iTjPt.xhi + xcut) break;
         // see if we hit the maxCnt limit
-        if (std::find(tMaxed.begin(), tMaxed.end(), jTjPt.id) != tMaxed.end()) continue;
+        if (tMaxed[jTjPt.id]) continue;
         auto& jtp = slc.tjs[jTjPt.id - 1].Pts[jTjPt.ipt];
         unsigned short jPlane = jTjPt.plane;
         unsigned int jWire = jtp.Pos[0];
@@ -864,13 +884,11 @@ namespace tca {
         tIDs[jPlane] = jTjPt.id;
         for (std::size_t kpt = jpt + 1; kpt < slc.mallTraj.size(); ++kpt) {
           auto& kTjPt = slc.mallTraj[kpt];
+          if (kTjPt.xlo > xmax) break;
           // ensure that the planes are different
           if (kTjPt.plane == iTjPt.plane || kTjPt.plane == jTjPt.plane) continue;
-          if (kTjPt.xlo > iTjPt.xhi) continue;
-          // break out if the x range difference becomes large
-          if (kTjPt.xlo > iTjPt.xhi + xcut) break;
           // see if we hit the maxCnt limit
-          if (std::find(tMaxed.begin(), tMaxed.end(), kTjPt.id) != tMaxed.end()) continue;
+          if (tMaxed[kTjPt.id]) continue;
           auto& ktp = slc.tjs[kTjPt.id - 1].Pts[kTjPt.ipt];
           unsigned short kPlane = kTjPt.plane;
           unsigned int kWire = ktp.Pos[0];
@@ -881,20 +899,19 @@ namespace tca {
           // we have a match
           tIDs[kPlane] = kTjPt.id;
           // look for it in the list
-          unsigned int indx = 0;
-          for (indx = 0; indx < mtIDs.size(); ++indx)
-            if (tIDs == mtIDs[indx]) break;
-          if (indx == mtIDs.size()) {
+          auto [mit, isNew] = mIndex.try_emplace(MatchKey(tIDs), mtIDs.size());
+          unsigned int indx = mit->second;
+          if (isNew) {
             // not found so add it to mtIDs and add another element to mCnt
             mtIDs.push_back(tIDs);
             mCnt.push_back(0);
           }
           ++mCnt[indx];
           if (mCnt[indx] == maxCnt) {
-            // add the Tjs to the list
-            tMaxed.insert(tMaxed.end(), tIDs[0]);
-            tMaxed.insert(tMaxed.end(), tIDs[1]);
-            tMaxed.insert(tMaxed.end(), tIDs[2]);
+            // flag the Tjs
+            tMaxed[tIDs[0]] = true;
+            tMaxed[tIDs[1]] = true;
+            tMaxed[tIDs[2]] = true;
             hitMaxCnt = true;
             break;
           } // hit maxCnt
@@ -957,30 +974,32 @@ namespace tca {
     std::vector<std::array<unsigned short, 2>> mtIDs;
     // and a matching vector for the count
     std::vector<unsigned short> mCnt;
+    // index of each Tj combination in mtIDs
+    std::unordered_map<unsigned long long, unsigned int> mIndex;
     // ignore Tj matches after hitting a user-defined limit
     unsigned short maxCnt = USHRT_MAX;
     if (tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcc.match3DCuts[1];
-    // a list of those Tjs
-    std::vector<unsigned short> tMaxed;
+    // flags for those Tjs, indexed by Tj ID
+    std::vector<bool> tMaxed(slc.tjs.size() + 1, false);
 
     for (std::size_t ipt = 0; ipt < slc.mallTraj.size() - 1; ++ipt) {
       auto& iTjPt = slc.mallTraj[ipt];
       // see if we hit the maxCnt limit
-      if (std::find(tMaxed.begin(), tMaxed.end(), iTjPt.id) != tMaxed.end()) continue;
+      if (tMaxed[iTjPt.id]) continue;
       auto& itp = slc.tjs[iTjPt.id - 1].Pts[iTjPt.ipt];
       unsigned short iPlane = iTjPt.plane;
       unsigned int iWire = itp.Pos[0];
+      // see Match3Planes
+      float xmax = std::min(iTjPt.xhi, iTjPt.xhi + xcut);
       bool hitMaxCnt = false;
       for (std::size_t jpt = ipt + 1; jpt < slc.mallTraj.size() - 1; ++jpt) {
         auto& jTjPt = slc.mallTraj[jpt];
+        // check for x range overlap. We know that jTjPt.xlo is >= iTjPt.xlo because of the sort
+        if (jTjPt.xlo > xmax) break;
         // ensure that the planes are different
         if (jTjPt.plane == iTjPt.plane) continue;
-        // check for x range overlap. We know that jTjPt.xlo is >= iTjPt.xlo because of the sort
-        if (jTjPt.xlo > iTjPt.xhi) continue;
-        // break out if the x range difference becomes large
-        if (jTjPt.xlo > iTjPt.xhi + xcut) break;
         // see if we hit the maxCnt limit
-        if (std::find(tMaxed.begin(), tMaxed.end(), jTjPt.id) != tMaxed.end()) continue;
+        if (tMaxed[jTjPt.id]) continue;
         auto& jtp = slc.tjs[jTjPt.id - 1].Pts[jTjPt.ipt];
         unsigned short jPlane = jTjPt.plane;
         unsigned int jWire = jtp.Pos[0];
@@ -996,19 +1015,18 @@ namespace tca {
         // swap the order so that the == operator works correctly
         if (tIDs[0] > tIDs[1]) std::swap(tIDs[0], tIDs[1]);
         // look for it in the list
-        std::size_t indx = 0;
-        for (indx = 0; indx < mtIDs.size(); ++indx)
-          if (tIDs == mtIDs[indx]) break;
-        if (indx == mtIDs.size()) {
+        auto [mit, isNew] = mIndex.try_emplace(MatchKey(tIDs), mtIDs.size());
+        std::size_t indx = mit->second;
+        if (isNew) {
           // not found so add it to mtIDs and add another element to mCnt
           mtIDs.push_back(tIDs);
           mCnt.push_back(0);
         }
         ++mCnt[indx];
         if (mCnt[indx] == maxCnt) {
-          // add the Tjs to the list
-          tMaxed.insert(tMaxed.end(), tIDs[0]);
-          tMaxed.insert(tMaxed.end(), tIDs[1]);
+          // flag the Tjs
+          tMaxed[tIDs[0]] = true;
+          tMaxed[tIDs[1]] = true;
           hitMaxCnt = true;
           break;
         } // hit maxCnt
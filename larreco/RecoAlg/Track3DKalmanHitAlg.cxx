@@ -37,6 +37,7 @@
 #include "lardataobj/RecoBase/Hit.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -59,9 +60,12 @@ namespace {
   void filterHits(trkf::Hits& hits, trkf::Hits& used_hits)
   {
     if (used_hits.size() > 0) {
-      // Make sure both hit collections are sorted.
-      std::stable_sort(hits.begin(), hits.end());
-      std::stable_sort(used_hits.begin(), used_hits.end());
+      // Make sure both hit collections are sorted.  The available hit
+      // collection is usually already sorted from a previous call, so
+      // only pay for the sort when it is needed.
+      if (!std::is_sorted(hits.begin(), hits.end())) std::stable_sort(hits.begin(), hits.end());
+      if (!std::is_sorted(used_hits.begin(), used_hits.end()))
+        std::stable_sort(used_hits.begin(), used_hits.end());
 
       // Do set difference operation.
       trkf::Hits::iterator it = std::set_difference(
@@ -396,7 +400,7 @@ void trkf::Track3DKalmanHitAlg::chopHitsOffSeeds(Hits const& hpsit,
 bool trkf::Track3DKalmanHitAlg::smoothandextendTrack(detinfo::DetectorPropertiesData const& detProp,
                                                      Propagator const& propagator,
                                                      KGTrack& trg0,
-                                                     const Hits hits,
+                                                     const Hits& hits,
                                                      unsigned int prefplane,
                                                      std::deque<KGTrack>& kalman_tracks)
 {
@@ -436,7 +440,7 @@ bool trkf::Track3DKalmanHitAlg::smoothandextendTrack(detinfo::DetectorProperties
   if (fDoDedx) { fitnupdateMomentum(propagator, trg1, trg1); }
   // Save this track.
   ++fNumTrack;
-  kalman_tracks.push_back(trg1);
+  kalman_tracks.push_back(std::move(trg1));
   return true;
 }
 
@@ -484,7 +488,7 @@ bool trkf::Track3DKalmanHitAlg::extendandsmoothLoop(detinfo::DetectorPropertiesD
     if (ok) {
       // Skip momentum estimate for constant-momentum tracks.
       if (fDoDedx) { fitnupdateMomentum(propagator, trg1, trg2); }
-      trg1 = trg2;
+      trg1 = std::move(trg2);
     }
   }
   return ok;
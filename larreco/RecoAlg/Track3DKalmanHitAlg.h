@@ -95,7 +95,7 @@ namespace trkf {
     bool smoothandextendTrack(detinfo::DetectorPropertiesData const& detProp,
                               Propagator const& propagator,
                               KGTrack& trg0,
-                              const Hits hits,
+                              const Hits& hits,
                               unsigned int prefplane,
                               std::deque<KGTrack>& kalman_tracks);
     bool extendandsmoothLoop(detinfo::DetectorPropertiesData const& detProp,
@@ -17,16 +17,13 @@
 #include "Math/Functor.h"
 #include "Math/GenVector/PositionVector3D.h"
 #include "Minuit2/Minuit2Minimizer.h"
-#include "Rtypes.h"
-#include "TAxis.h"
-#include "TGraphErrors.h"
+#include "TGraph.h"
 #include "TMath.h"
 #include "TMatrixDSymEigen.h"
 #include "TMatrixDSymfwd.h"
 #include "TMatrixDfwd.h"
 #include "TMatrixT.h"
 #include "TMatrixTSym.h"
-#include "TPolyLine3D.h"
 #include "TSpline.h"
 #include "TVectorDfwd.h"
 #include "TVectorT.h"
@@ -247,12 +244,16 @@ namespace trkf {
                                                               const bool checkValidPoints,
                                                               const int maxMomentum_MeV,
                                                               const int MomentumStep_MeV,
-                                                              const int max_resolution)
+                                                              const int max_resolution) const
   {
     std::vector<float> recoX;
     std::vector<float> recoY;
     std::vector<float> recoZ;
 
+    recoX.reserve(trk->NumberTrajectoryPoints());
+    recoY.reserve(trk->NumberTrajectoryPoints());
+    recoZ.reserve(trk->NumberTrajectoryPoints());
+
     int n_points = trk->NumberTrajectoryPoints();
 
     for (int i = 0; i < n_points; i++) {
@@ -265,7 +266,7 @@ namespace trkf {
 
     if (recoX.size() < 2) return -1.0;
 
-    if (!plotRecoTracks_(recoX, recoY, recoZ)) return -1.0;
+    if (!checkRecoTracks_(recoX, recoY, recoZ)) return -1.0;
 
     double const seg_size{steps_size};
 
@@ -309,7 +310,8 @@ namespace trkf {
     return bf;
   }
 
-  TVector3 TrackMomentumCalculator::GetMultiScatterStartingPoint(const art::Ptr<recob::Track>& trk)
+  TVector3 TrackMomentumCalculator::GetMultiScatterStartingPoint(
+    const art::Ptr<recob::Track>& trk) const
   {
     double const LLHDp = GetMuMultiScatterLLHD3(trk, true);
     double const LLHDm = GetMuMultiScatterLLHD3(trk, false);
@@ -327,13 +329,16 @@ namespace trkf {
   }
 
   double TrackMomentumCalculator::GetMuMultiScatterLLHD3(art::Ptr<recob::Track> const& trk,
-                                                         bool const dir)
+                                                         bool const dir) const
   {
     std::vector<float> recoX;
     std::vector<float> recoY;
     std::vector<float> recoZ;
 
     int const n_points = trk->NumberTrajectoryPoints();
+    recoX.reserve(n_points);
+    recoY.reserve(n_points);
+    recoZ.reserve(n_points);
     for (int i = 0; i < n_points; ++i) {
       auto const index = dir ? i : n_points - 1 - i;
       auto const& pos = trk->LocationAtPoint(index);
@@ -344,7 +349,7 @@ namespace trkf {
 
     if (recoX.size() < 2) return -1.0;
 
-    if (!plotRecoTracks_(recoX, recoY, recoZ)) return -1.0;
+    if (!checkRecoTracks_(recoX, recoY, recoZ)) return -1.0;
 
     constexpr double seg_size{5.0};
     auto const segments = getSegTracks_(recoX, recoY, recoZ, seg_size);
@@ -473,12 +478,16 @@ namespace trkf {
 
   double TrackMomentumCalculator::GetMomentumMultiScatterChi2(const art::Ptr<recob::Track>& trk,
                                                               const bool checkValidPoints,
-                                                              const int maxMomentum_MeV)
+                                                              const int maxMomentum_MeV) const
   {
     std::vector<float> recoX;
     std::vector<float> recoY;
     std::vector<float> recoZ;
 
+    recoX.reserve(trk->NumberTrajectoryPoints());
+    recoY.reserve(trk->NumberTrajectoryPoints());
+    recoZ.reserve(trk->NumberTrajectoryPoints());
+
     int n_points = trk->NumberTrajectoryPoints();
 
     for (int i = 0; i < n_points; i++) {
@@ -491,7 +500,7 @@ namespace trkf {
 
     if (recoX.size() < 2) return -1.0;
 
-    if (!plotRecoTracks_(recoX, recoY, recoZ)) return -1.0;
+    if (!checkRecoTracks_(recoX, recoY, recoZ)) return -1.0;
 
     double const seg_size{steps_size};
     auto const segments = getSegTracks_(recoX, recoY, recoZ, seg_size);
@@ -503,9 +512,6 @@ namespace trkf {
     double const recoL = segments->L.at(seg_steps - 1);
     if (recoL < minLength || recoL > maxLength) return -1;
 
-    double ymax = -999.0;
-    double ymin = +999.0;
-
     std::vector<double> xmeas;
     std::vector<double> ymeas;
     std::vector<double> eymeas;
@@ -534,28 +540,12 @@ namespace trkf {
       eymeas.push_back(std::sqrt(cet::sum_of_squares(
         rmse, 0.05 * rms))); // <--- conservative syst. error to fix chi^{2} behaviour !!!
 
-      if (ymin > rms) ymin = rms;
-      if (ymax < rms) ymax = rms;
     }
 
     assert(xmeas.size() == ymeas.size());
     assert(xmeas.size() == eymeas.size());
     if (xmeas.empty()) { return -1.0; }
 
-    TGraphErrors gr_meas{n_steps, xmeas.data(), ymeas.data(), nullptr, eymeas.data()};
-
-    gr_meas.SetTitle("(#Delta#theta)_{rms} versus material thickness; Material "
-                     "thickness in cm; (#Delta#theta)_{rms} in mrad");
-
-    gr_meas.SetLineColor(kBlack);
-    gr_meas.SetMarkerColor(kBlack);
-    gr_meas.SetMarkerStyle(20);
-    gr_meas.SetMarkerSize(1.2);
-
-    gr_meas.GetXaxis()->SetLimits(steps.at(0) - steps.at(0), steps.at(n_steps - 1) + steps.at(0));
-    gr_meas.SetMinimum(0.0);
-    gr_meas.SetMaximum(1.80 * ymax);
-
     ROOT::Minuit2::Minuit2Minimizer mP{};
     FcnWrapper const wrapper{move(xmeas), move(ymeas), move(eymeas)};
     ROOT::Math::Functor FCA([&wrapper](double const* xs) { return wrapper.my_mcs_chi2(xs); }, 2);
@@ -583,9 +573,9 @@ namespace trkf {
     return mstatus ? p_mcs : -1.0;
   }
 
-  bool TrackMomentumCalculator::plotRecoTracks_(std::vector<float> const& xxx,
-                                                std::vector<float> const& yyy,
-                                                std::vector<float> const& zzz)
+  bool TrackMomentumCalculator::checkRecoTracks_(std::vector<float> const& xxx,
+                                                 std::vector<float> const& yyy,
+                                                 std::vector<float> const& zzz) const
   {
     auto const n = xxx.size();
     auto const y_size = yyy.size();
@@ -596,32 +586,18 @@ namespace trkf {
       return false;
     }
 
-    // Here, we perform a const-cast to float* because, sadly,
-    // TPolyLine3D requires a pointer to a non-const object.  We will
-    // trust that ROOT does not mess around with the underlying data.
-    auto xs = const_cast<float*>(xxx.data());
-    auto ys = const_cast<float*>(yyy.data());
-    auto zs = const_cast<float*>(zzz.data());
-
-    auto const narrowed_size = static_cast<int>(n); // ROOT requires a signed integral type
-    delete gr_reco_xyz;
-    gr_reco_xyz = new TPolyLine3D{narrowed_size, zs, xs, ys};
-    gr_reco_yz = TGraph{narrowed_size, zzz.data(), yyy.data()};
-    gr_reco_xz = TGraph{narrowed_size, zzz.data(), xxx.data()};
-    gr_reco_xy = TGraph{narrowed_size, xxx.data(), yyy.data()};
-
     return true;
   }
 
-  void TrackMomentumCalculator::compute_max_fluctuation_vector(const std::vector<float> segx,
-                                                               const std::vector<float> segy,
-                                                               const std::vector<float> segz,
+  void TrackMomentumCalculator::compute_max_fluctuation_vector(const std::vector<float>& segx,
+                                                               const std::vector<float>& segy,
+                                                               const std::vector<float>& segz,
                                                                std::vector<float>& segnx,
                                                                std::vector<float>& segny,
                                                                std::vector<float>& segnz,
                                                                std::vector<float>& vx,
                                                                std::vector<float>& vy,
-                                                               std::vector<float>& vz)
+                                                               std::vector<float>& vz) const
   {
     auto const na = vx.size();
 
@@ -639,24 +615,12 @@ namespace trkf {
     sumy /= na;
     sumz /= na;
 
-    std::vector<double> mx;
-    std::vector<double> my;
-    std::vector<double> mz;
-
     TMatrixDSym m(3);
 
     for (std::size_t i = 0; i < na; ++i) {
-      double const xxw1 = vx.at(i);
-      double const yyw1 = vy.at(i);
-      double const zzw1 = vz.at(i);
-
-      mx.push_back(xxw1 - sumx);
-      my.push_back(yyw1 - sumy);
-      mz.push_back(zzw1 - sumz);
-
-      double const xxw0 = mx.at(i);
-      double const yyw0 = my.at(i);
-      double const zzw0 = mz.at(i);
+      double const xxw0 = vx[i] - sumx;
+      double const yyw0 = vy[i] - sumy;
+      double const zzw0 = vz[i] - sumz;
 
       m(0, 0) += xxw0 * xxw0 / na;
       m(0, 1) += xxw0 * yyw0 / na;
@@ -693,6 +657,8 @@ namespace trkf {
     double ay = eigenvec(1, ind1);
     double az = eigenvec(2, ind1);
 
+    // one segment point is stored per completed segment
+    auto const n_seg = segx.size();
     if (n_seg > 1) {
       if (segx.at(n_seg - 1) - segx.at(n_seg - 2) > 0)
         ax = std::abs(ax);
@@ -722,7 +688,7 @@ namespace trkf {
     std::vector<float> const& xxx,
     std::vector<float> const& yyy,
     std::vector<float> const& zzz,
-    double const seg_size)
+    double const seg_size) const
   {
     double stag = 0.0;
 
@@ -744,7 +710,7 @@ namespace trkf {
 
     int ntot = 0;
 
-    n_seg = 0;
+    int n_seg = 0;
 
     double x0{};
     double y0{};
@@ -774,10 +740,6 @@ namespace trkf {
 
         segL.push_back(stag);
 
-        x_seg[n_seg] = x0;
-        y_seg[n_seg] = y0;
-        z_seg[n_seg] = z0;
-
         n_seg++;
 
         vx.push_back(x0);
@@ -847,9 +809,6 @@ namespace trkf {
 
         segL.push_back(1.0 * n_seg * 1.0 * seg_size + stag);
 
-        x_seg[n_seg] = xp;
-        y_seg[n_seg] = yp;
-        z_seg[n_seg] = zp;
         n_seg++;
 
         x0 = xp;
@@ -894,9 +853,6 @@ namespace trkf {
         segz.push_back(zp);
         segL.push_back(1.0 * n_seg * 1.0 * seg_size + stag);
 
-        x_seg[n_seg] = xp;
-        y_seg[n_seg] = yp;
-        z_seg[n_seg] = zp;
         n_seg++;
 
         x0 = xp;
@@ -923,12 +879,6 @@ namespace trkf {
       if (n_seg >= (stopper + 1.0) && seg_stop != -1) break;
     }
 
-    delete gr_seg_xyz;
-    gr_seg_xyz = new TPolyLine3D{n_seg, z_seg, x_seg, y_seg};
-    gr_seg_yz = TGraph{n_seg, z_seg, y_seg};
-    gr_seg_xz = TGraph{n_seg, z_seg, x_seg};
-    gr_seg_xy = TGraph{n_seg, x_seg, y_seg};
-
     return std::make_optional<Segments>(Segments{segx, segnx, segy, segny, segz, segnz, segL});
   }
 
@@ -7,15 +7,12 @@
 #include "canvas/Persistency/Common/Ptr.h"
 #include "lardataobj/RecoBase/Track.h"
 
-#include "TGraph.h"
 #include "TVector3.h"
 
 #include <optional>
 #include <tuple>
 #include <vector>
 
-class TPolyLine3D;
-
 namespace trkf {
 
   class TrackMomentumCalculator {
@@ -47,7 +44,7 @@ namespace trkf {
     */
     double GetMomentumMultiScatterChi2(art::Ptr<recob::Track> const& trk,
                                        const bool checkValidPoints = false,
-                                       const int maxMomentum_MeV = 7500);
+                                       const int maxMomentum_MeV = 7500) const;
     /**
     * @brief  Calculate muon momentum (GeV) using multiple coulomb scattering by log likelihood
     *
@@ -65,14 +62,14 @@ namespace trkf {
                                        const bool checkValidPoints = false,
                                        const int maxMomentum_MeV = 7500,
                                        const int MomentumStep_MeV = 10,
-                                       const int max_resolution = 0);
-    double GetMuMultiScatterLLHD3(art::Ptr<recob::Track> const& trk, bool dir);
-    TVector3 GetMultiScatterStartingPoint(art::Ptr<recob::Track> const& trk);
+                                       const int max_resolution = 0) const;
+    double GetMuMultiScatterLLHD3(art::Ptr<recob::Track> const& trk, bool dir) const;
+    TVector3 GetMultiScatterStartingPoint(art::Ptr<recob::Track> const& trk) const;
 
   private:
-    bool plotRecoTracks_(std::vector<float> const& xxx,
-                         std::vector<float> const& yyy,
-                         std::vector<float> const& zzz);
+    bool checkRecoTracks_(std::vector<float> const& xxx,
+                          std::vector<float> const& yyy,
+                          std::vector<float> const& zzz) const;
 
     /**
     * @brief Computes the vector with most scattering inside a segment with size steps_size
@@ -81,15 +78,15 @@ namespace trkf {
     * @param vector used to control points to be used at segments
     *
     */
-    void compute_max_fluctuation_vector(const std::vector<float> segx,
-                                        const std::vector<float> segy,
-                                        const std::vector<float> segz,
+    void compute_max_fluctuation_vector(const std::vector<float>& segx,
+                                        const std::vector<float>& segy,
+                                        const std::vector<float>& segz,
                                         std::vector<float>& segnx,
                                         std::vector<float>& segny,
                                         std::vector<float>& segnz,
                                         std::vector<float>& vx,
                                         std::vector<float>& vy,
-                                        std::vector<float>& vz);
+                                        std::vector<float>& vz) const;
     /**
     * \struct Segments
     * @brief Struct to store segments.
@@ -120,7 +117,7 @@ namespace trkf {
     std::optional<Segments> getSegTracks_(std::vector<float> const& xxx,
                                           std::vector<float> const& yyy,
                                           std::vector<float> const& zzz,
-                                          double seg_size);
+                                          double seg_size) const;
 
     /**
     * @brief Gets the scattered angle RMS for a all segments
@@ -186,11 +183,6 @@ namespace trkf {
                        double x1) const;
 
     float seg_stop{-1.};
-    int n_seg{};
-
-    float x_seg[50000];
-    float y_seg[50000];
-    float z_seg[50000];
 
     /**
     * @brief Gets angle between two vy and vz
@@ -209,26 +201,6 @@ namespace trkf {
     double maxLength;
     double steps_size;
     double rad_length{14.0};
-
-    // The following are objects that are created but not drawn or
-    // saved.  This class should consider accepting a "debug"
-    // parameter where if it is specified, then the graphs will be
-    // created; otherwise, their creation is unnecessary and impedes
-    // efficiency.
-    //
-    // N.B. TPolyLine3D objects are owned by ROOT, and we thus refer
-    // to them by pointer.  It is important that 'delete' is not
-    // called on the TPolyLine3D pointers during destruction of a
-    // TrackMomentumCalculator object.
-    TPolyLine3D* gr_reco_xyz{nullptr};
-    TGraph gr_reco_xy{};
-    TGraph gr_reco_yz{};
-    TGraph gr_reco_xz{};
-
-    TPolyLine3D* gr_seg_xyz{nullptr};
-    TGraph gr_seg_xy{};
-    TGraph gr_seg_yz{};
-    TGraph gr_seg_xz{};
   };
 
 } // namespace trkf
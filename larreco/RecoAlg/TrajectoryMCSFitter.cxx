@@ -161,12 +161,19 @@ const TrajectoryMCSFitter::ScanResult TrajectoryMCSFitter::doLikelihoodScan(
   float pstep,
   float detAngResol) const
 {
+  //
+  // the log and sqrt of the segment radiation lengths do not depend on the momentum,
+  // so evaluate them once for the whole scan rather than at every step
+  SegmentTerms terms;
+  fillSegmentTerms(dtheta, seg_nradlengths, terms);
+  //
   int best_idx = -1;
   float best_logL = std::numeric_limits<float>::max();
   float best_p = -1.0;
   std::vector<float> vlogL;
+  if (pstep > 0. && pmax >= pmin) vlogL.reserve(size_t((pmax - pmin) / pstep) + 2);
   for (float p_test = pmin; p_test <= pmax; p_test += pstep) {
-    float logL = mcsLikelihood(p_test, detAngResol, dtheta, seg_nradlengths, cumLen, fwdFit, pid);
+    float logL = mcsLikelihood(p_test, detAngResol, dtheta, terms, cumLen, fwdFit, pid);
     if (logL < best_logL) {
       best_p = p_test;
       best_logL = logL;
@@ -306,6 +313,22 @@ void TrajectoryMCSFitter::linearRegression(const recob::TrackTrajectory& traj,
   //
 }
 
+void TrajectoryMCSFitter::fillSegmentTerms(const std::vector<float>& dthetaij,
+                                           const std::vector<float>& seg_nradl,
+                                           SegmentTerms& terms) const
+{
+  //
+  // only segments with a valid scattering angle enter the likelihood
+  //
+  terms.logRadl.assign(dthetaij.size(), 0.);
+  terms.sqrtRadl.assign(dthetaij.size(), 0.);
+  for (size_t i = 0; i < dthetaij.size(); ++i) {
+    if (dthetaij[i] < 0) continue;
+    terms.logRadl[i] = std::log(seg_nradl[i]);
+    terms.sqrtRadl[i] = sqrt(seg_nradl[i]);
+  }
+}
+
 double TrajectoryMCSFitter::mcsLikelihood(double p,
                                           double theta0x,
                                           std::vector<float>& dthetaij,
@@ -313,6 +336,19 @@ double TrajectoryMCSFitter::mcsLikelihood(double p,
                                           std::vector<float>& cumLen,
                                           bool fwd,
                                           int pid) const
+{
+  SegmentTerms terms;
+  fillSegmentTerms(dthetaij, seg_nradl, terms);
+  return mcsLikelihood(p, theta0x, dthetaij, terms, cumLen, fwd, pid);
+}
+
+double TrajectoryMCSFitter::mcsLikelihood(double p,
+                                          double theta0x,
+                                          const std::vector<float>& dthetaij,
+                                          const SegmentTerms& terms,
+                                          const std::vector<float>& cumLen,
+                                          bool fwd,
+                                          int pid) const
 {
   //
   const int beg = (fwd ? 0 : (dthetaij.size() - 1));
@@ -327,6 +363,7 @@ double TrajectoryMCSFitter::mcsLikelihood(double p,
   double Eij2 = 0.;
   //
   double const fixedterm = 0.5 * std::log(2.0 * M_PI);
+  const double theta0x2 = theta0x * theta0x;
   double result = 0;
   for (int i = beg; i != end; i += incr) {
     if (dthetaij[i] < 0) {
@@ -345,8 +382,8 @@ double TrajectoryMCSFitter::mcsLikelihood(double p,
     const double beta = sqrt(1. - ((m2) / (pij * pij + m2)));
     constexpr double HighlandSecondTerm = 0.038;
     const double tH0 = (HighlandFirstTerm(pij) / (pij * beta)) *
-                       (1.0 + HighlandSecondTerm * std::log(seg_nradl[i])) * sqrt(seg_nradl[i]);
-    const double rms = sqrt(2.0 * (tH0 * tH0 + theta0x * theta0x));
+                       (1.0 + HighlandSecondTerm * terms.logRadl[i]) * terms.sqrtRadl[i];
+    const double rms = sqrt(2.0 * (tH0 * tH0 + theta0x2));
     if (rms == 0.0) {
       std::cout << " Error : RMS cannot be zero ! " << std::endl;
       return std::numeric_limits<double>::max();
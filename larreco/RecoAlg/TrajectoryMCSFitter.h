@@ -201,6 +201,22 @@ namespace trkf {
                          bool fwd,
                          int pid) const;
     //
+    /// Momentum-independent per-segment terms of the Highland formula, computed once per scan.
+    struct SegmentTerms {
+      std::vector<double> logRadl;  ///< log(seg_nradl[i])
+      std::vector<double> sqrtRadl; ///< sqrt(seg_nradl[i])
+    };
+    void fillSegmentTerms(const std::vector<float>& dthetaij,
+                          const std::vector<float>& seg_nradl,
+                          SegmentTerms& terms) const;
+    double mcsLikelihood(double p,
+                         double theta0x,
+                         const std::vector<float>& dthetaij,
+                         const SegmentTerms& terms,
+                         const std::vector<float>& cumLen,
+                         bool fwd,
+                         int pid) const;
+    //
     struct ScanResult {
     public:
       ScanResult(double ap, double apUnc, double alogL) : p(ap), pUnc(apUnc), logL(alogL) {}
@@ -247,6 +263,7 @@ namespace trkf {
     double GetE(const double initial_E, const double length_travelled, const double mass) const;
     //
     int minNSegs() const { return minNSegs_; }
+    bool applySCEcorr() const { return applySCEcorr_; }
     double segLen() const { return segLen_; }
     double segLenTolerance() const { return segLenTolerance_; }
     //
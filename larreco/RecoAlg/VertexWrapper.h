@@ -4,6 +4,7 @@
 #include "lardataobj/RecoBase/Track.h"
 #include "lardataobj/RecoBase/Vertex.h"
 #include <functional>
+#include <vector>
 
 namespace trkf {
   //
@@ -28,6 +29,15 @@ namespace trkf {
   class VertexWrapper {
 
   public:
+    // Information (inverse covariance) form of the measurement p of a track on a plane, with W
+    // the inverse of its covariance on the plane rotated to 3D: weight=W, weightedPos=W*p and
+    // posChi2=p^T*W*p. Kept by fitters that remove tracks from the vertex without refitting it.
+    struct TrackInformation {
+      recob::tracking::SMatrixSym33 weight;
+      recob::tracking::SVector3 weightedPos;
+      double posChi2 = 0.;
+    };
+    //
     VertexWrapper() { vtx_ = recob::Vertex(); }
     VertexWrapper(const recob::Vertex& vtx) : vtx_(vtx) {}
     VertexWrapper(const recob::tracking::Point_t& pos,
@@ -72,10 +82,27 @@ namespace trkf {
       tks.erase(tks.begin() + element);
       return tks;
     }
+    //
+    void addTrackInformation(const TrackInformation& info)
+    {
+      vtxinfos_.push_back(info);
+      vtxinfosum_.weight += info.weight;
+      vtxinfosum_.weightedPos += info.weightedPos;
+      vtxinfosum_.posChi2 += info.posChi2;
+    }
+    // true if there is one information entry per track, in the order of tracks()
+    bool hasTrackInformation() const
+    {
+      return !vtxtks_.empty() && vtxinfos_.size() == vtxtks_.size();
+    }
+    const std::vector<TrackInformation>& trackInformation() const { return vtxinfos_; }
+    const TrackInformation& totalInformation() const { return vtxinfosum_; }
 
   private:
     recob::Vertex vtx_;
     TrackRefVec vtxtks_;
+    std::vector<TrackInformation> vtxinfos_;
+    TrackInformation vtxinfosum_;
   };
 }
 
@@ -7,6 +7,7 @@
 #include "lardataobj/RecoBase/PFParticle.h"
 #include "lardataobj/RecoBase/Shower.h"
 #include "larsim/MCCheater/BackTrackerService.h"
+#include "larreco/MCComp/HitTruthTable.h"
 #include "larsim/MCCheater/ParticleInventoryService.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
 #include "nusimdata/SimulationBase/MCTruth.h"
@@ -49,15 +50,16 @@ namespace DUNE {
                     const art::Event& evt,
                     bool& isFiducial);
     void truthMatcher(detinfo::DetectorClocksData const& clockData,
-                      std::vector<art::Ptr<recob::Hit>> all_hits,
-                      std::vector<art::Ptr<recob::Hit>> shower_hits,
+                      btutil::HitTruthTable const& truthTable,
+                      std::vector<art::Ptr<recob::Hit>> const& shower_hits,
                       const simb::MCParticle*& MCparticle,
                       double& Efrac,
                       double& Ecomplet);
     template <size_t N>
     void checkCNNtrkshw(detinfo::DetectorClocksData const& clockData,
                         const art::Event& evt,
-                        std::vector<art::Ptr<recob::Hit>> all_hits);
+                        std::vector<art::Ptr<recob::Hit>> const& all_hits,
+                        btutil::HitTruthTable const& truthTable);
     bool insideFV(double vertex[4]);
     void doEfficiencies();
     void reset();
@@ -947,7 +949,12 @@ namespace DUNE {
 
     art::Handle<std::vector<recob::Hit>> hitHandle;
     std::vector<art::Ptr<recob::Hit>> all_hits;
-    if (event.getByLabel(fHitModuleLabel, hitHandle)) { art::fill_ptr_vector(all_hits, hitHandle); }
+    // Back-track all hits once, the truth matching of every shower looks them up
+    btutil::HitTruthTable truthTable;
+    if (event.getByLabel(fHitModuleLabel, hitHandle)) {
+      art::fill_ptr_vector(all_hits, hitHandle);
+      truthTable.Reset(clockData, hitHandle.id(), *hitHandle, true);
+    }
 
     n_recoShowers = showerlist.size();
     //if ( n_recoShowers == 0 || n_recoShowers> MAX_SHOWERS ) return;
@@ -1076,7 +1083,8 @@ namespace DUNE {
 
       int tmp_nHits = sh_hits.size();
 
-      truthMatcher(clockData, all_hits, sh_hits, particle, tmpEfrac_contamination, tmpEcomplet);
+      truthMatcher(
+        clockData, truthTable, sh_hits, particle, tmpEfrac_contamination, tmpEcomplet);
       if (!particle) continue;
 
       sh_Efrac_contamination[i] = tmpEfrac_contamination;
@@ -1352,13 +1360,13 @@ namespace DUNE {
       } //if(ParticlePDG_HighestShHits>0)
     }   //else if(!MC_isCC&&isFiducial)
 
-    checkCNNtrkshw<4>(clockData, event, all_hits);
+    checkCNNtrkshw<4>(clockData, event, all_hits, truthTable);
   }
 
   //========================================================================
   void NeutrinoShowerEff::truthMatcher(detinfo::DetectorClocksData const& clockData,
-                                       std::vector<art::Ptr<recob::Hit>> all_hits,
-                                       std::vector<art::Ptr<recob::Hit>> shower_hits,
+                                       btutil::HitTruthTable const& truthTable,
+                                       std::vector<art::Ptr<recob::Hit>> const& shower_hits,
                                        const simb::MCParticle*& MCparticle,
                                        double& Efrac,
                                        double& Ecomplet)
@@ -1373,7 +1381,9 @@ namespace DUNE {
     std::map<int, double> trkID_E;
     for (size_t j = 0; j < shower_hits.size(); ++j) {
       art::Ptr<recob::Hit> hit = shower_hits[j];
-      std::vector<sim::TrackIDE> TrackIDs = bt_serv->HitToEveTrackIDEs(clockData, hit);
+      std::vector<sim::TrackIDE> TrackIDs = truthTable.Covers(hit) ?
+                                              truthTable.TrackIDEs(hit.key()) :
+                                              bt_serv->HitToEveTrackIDEs(clockData, hit);
       for (size_t k = 0; k < TrackIDs.size(); k++) {
         if (trkID_E.find(std::abs(TrackIDs[k].trackID)) == trkID_E.end())
           trkID_E[std::abs(TrackIDs[k].trackID)] = 0;
@@ -1400,14 +1410,7 @@ namespace DUNE {
     Efrac = 1 - (partial_E / total_E);
 
     //completeness
-    double totenergy = 0;
-    for (size_t k = 0; k < all_hits.size(); ++k) {
-      art::Ptr<recob::Hit> hit = all_hits[k];
-      std::vector<sim::TrackIDE> TrackIDs = bt_serv->HitToEveTrackIDEs(clockData, hit);
-      for (size_t l = 0; l < TrackIDs.size(); ++l) {
-        if (std::abs(TrackIDs[l].trackID) == TrackID) { totenergy += TrackIDs[l].energy; }
-      }
-    }
+    double totenergy = truthTable.TotalEnergy(TrackID, true);
     Ecomplet = partial_E / totenergy;
   }
 
@@ -1481,7 +1484,8 @@ namespace DUNE {
   template <size_t N>
   void NeutrinoShowerEff::checkCNNtrkshw(detinfo::DetectorClocksData const& clockData,
                                          const art::Event& evt,
-                                         std::vector<art::Ptr<recob::Hit>> all_hits)
+                                         std::vector<art::Ptr<recob::Hit>> const& all_hits,
+                                         btutil::HitTruthTable const& truthTable)
   {
     if (fCNNEMModuleLabel.empty()) return;
 
@@ -1501,7 +1505,9 @@ namespace DUNE {
         //find out if the hit was generated by an EM particle
         bool isEMparticle = false;
         int pdg = INT_MAX;
-        std::vector<sim::TrackIDE> TrackIDs = bt_serv->HitToEveTrackIDEs(clockData, all_hits[i]);
+        std::vector<sim::TrackIDE> TrackIDs =
+          truthTable.Covers(all_hits[i]) ? truthTable.TrackIDEs(all_hits[i].key()) :
+                                           bt_serv->HitToEveTrackIDEs(clockData, all_hits[i]);
         if (!TrackIDs.size()) continue;
 
         int trkid = INT_MAX;
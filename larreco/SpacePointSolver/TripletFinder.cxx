@@ -7,6 +7,7 @@
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/GeometryCore.h"
 #include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
+#include "larreco/RecoAlg/GeometryCache.h"
 
 namespace reco3d {
   // -------------------------------------------------------------------------
@@ -39,10 +40,11 @@ namespace reco3d {
                                  const std::vector<art::Ptr<recob::Hit>>& hits,
                                  std::map<geo::TPCID, std::vector<HitOrChan>>& out)
   {
+    auto const& geometryCache = util::GeometryCache::Instance();
     for (const art::Ptr<recob::Hit>& hit : hits) {
       for (geo::TPCID tpc : geom->ROPtoTPCs(geom->ChannelToROP(hit->Channel()))) {
         double xpos = 0;
-        for (geo::WireID wire : geom->ChannelToWire(hit->Channel())) {
+        for (geo::WireID wire : geometryCache.ChannelToWire(hit->Channel())) {
           if (geo::TPCID(wire) == tpc) {
             xpos = detProp.ConvertTicksToX(hit->PeakTime(), wire);
             if (geom->SignalType(wire) == geo::kCollection) xpos += fXHitOffset;
@@ -71,7 +73,9 @@ namespace reco3d {
   class IntersectionCache {
   public:
     IntersectionCache(geo::TPCID tpc)
-      : geom(art::ServiceHandle<geo::Geometry const>()->provider()), fTPC(tpc)
+      : geom(art::ServiceHandle<geo::Geometry const>()->provider())
+      , geometryCache(util::GeometryCache::Instance())
+      , fTPC(tpc)
     {}
 
     bool operator()(raw::ChannelID_t a, raw::ChannelID_t b, geo::WireIDIntersection& pt)
@@ -93,11 +97,13 @@ namespace reco3d {
   protected:
     bool ISect(raw::ChannelID_t chanA, raw::ChannelID_t chanB, geo::WireIDIntersection& pt) const
     {
-      for (geo::WireID awire : geom->ChannelToWire(chanA)) {
+      for (geo::WireID awire : geometryCache.ChannelToWire(chanA)) {
         if (geo::TPCID(awire) != fTPC) continue;
-        for (geo::WireID bwire : geom->ChannelToWire(chanB)) {
+        for (geo::WireID bwire : geometryCache.ChannelToWire(chanB)) {
           if (geo::TPCID(bwire) != fTPC) continue;
 
+          // pt is only read when an intersection is found
+          if (!geometryCache.MayIntersect(awire, bwire)) continue;
           if (geom->WireIDsIntersect(awire, bwire, pt)) return true;
         }
       }
@@ -106,6 +112,7 @@ namespace reco3d {
     }
 
     const geo::GeometryCore* geom;
+    const util::GeometryCache& geometryCache;
 
     std::map<std::pair<raw::ChannelID_t, raw::ChannelID_t>, bool> fMap;
     std::map<std::pair<raw::ChannelID_t, raw::ChannelID_t>, geo::WireIDIntersection> fPtMap;
@@ -162,6 +162,10 @@ namespace trkf {
     };
     // vector of cluster parameters in each plane
     std::array<std::vector<ClsChainPar>, 3> clsChain;
+    // (X, chain index) of both chain ends in each plane, sorted by X, and the chains
+    // with an end X that cannot be sorted (NaN). Filled in PlnMatch
+    std::array<std::vector<std::pair<float, unsigned short>>, 3> chainEndX;
+    std::array<std::vector<unsigned short>, 3> chainNoX;
 
     // 3D Vertex info
     struct vtxPar {
@@ -252,6 +256,11 @@ namespace trkf {
     void VtxMatch(detinfo::DetectorPropertiesData const& detProp,
                   art::FindManyP<recob::Hit> const& fmCluHits,
                   geo::TPCID const& tpcid);
+    // sort the chain ends in each plane by X
+    void SortChainEnds(unsigned short nplanes);
+    // find chains in a plane with an end that may be within dx of x. The list is
+    // sorted and may contain chains that fail the cut
+    void ChainsNearX(unsigned short ipl, float x, float dx, std::vector<unsigned short>& icls) const;
     // match clusters in all planes
     void PlnMatch(detinfo::DetectorPropertiesData const& detProp,
                   art::FindManyP<recob::Hit> const& fmCluHits,
@@ -2099,6 +2108,9 @@ namespace trkf {
     // temp array for making a rough charge asymmetry cut
     std::array<float, 3> mchg;
     auto const nplanes = geom->Nplanes(tpcid);
+    // candidate chains in the j and k planes from the X cuts
+    SortChainEnds(nplanes);
+    std::vector<unsigned short> jcls, kcls;
     for (unsigned short ipl = 0; ipl < nplanes; ++ipl) {
       geo::PlaneID const iplane_id{tpcid, ipl};
       for (unsigned short icl = 0; icl < clsChain[ipl].size(); ++icl) {
@@ -2108,7 +2120,10 @@ namespace trkf {
         unsigned short jpl = (ipl + 1) % nplanes;
         unsigned short kpl = (jpl + 1) % nplanes;
         geo::PlaneID const jplane_id{tpcid, jpl};
-        for (unsigned short jcl = 0; jcl < clsChain[jpl].size(); ++jcl) {
+        jcls.clear();
+        for (unsigned short iend = 0; iend < 2; ++iend)
+          ChainsNearX(jpl, clsChain[ipl][icl].X[iend], dxcut, jcls);
+        for (unsigned short jcl : jcls) {
           if (clsChain[jpl][jcl].InTrack >= 0) continue;
           // skip short clusters
           if (clsChain[jpl][jcl].Length < fMatchMinLen[algIndex]) continue;
@@ -2170,7 +2185,14 @@ namespace trkf {
               if (ignoreSign) kAng = fabs(kAng);
               dxkcut = dxcut * AngleFactor(kSlp);
               bool gotkcl = false;
-              for (unsigned short kcl = 0; kcl < clsChain[kpl].size(); ++kcl) {
+              // the X cut is made up front unless all the candidates are printed
+              kcls.clear();
+              if (!prt && std::isfinite(dxkcut))
+                ChainsNearX(kpl, kX, dxkcut, kcls);
+              else
+                for (unsigned short kcl = 0; kcl < clsChain[kpl].size(); ++kcl)
+                  kcls.push_back(kcl);
+              for (unsigned short kcl : kcls) {
                 if (clsChain[kpl][kcl].InTrack >= 0) continue;
                 // make second charge asymmetry cut
                 mchg[0] = clsChain[ipl][icl].TotChg;
@@ -2253,6 +2275,56 @@ namespace trkf {
     }           // ipl
   }             // PlnMatch
 
+  ///////////////////////////////////////////////////////////////////////
+  void CCTrackMaker::SortChainEnds(unsigned short nplanes)
+  {
+    for (unsigned short ipl = 0; ipl < 3; ++ipl) {
+      chainEndX[ipl].clear();
+      chainNoX[ipl].clear();
+      if (ipl >= nplanes) continue;
+      for (unsigned short icl = 0; icl < clsChain[ipl].size(); ++icl) {
+        for (unsigned short end = 0; end < 2; ++end) {
+          float x = clsChain[ipl][icl].X[end];
+          if (std::isnan(x))
+            chainNoX[ipl].push_back(icl);
+          else
+            chainEndX[ipl].emplace_back(x, icl);
+        } // end
+      }   // icl
+      std::sort(chainEndX[ipl].begin(), chainEndX[ipl].end());
+    } // ipl
+  }   // SortChainEnds
+
+  ///////////////////////////////////////////////////////////////////////
+  void CCTrackMaker::ChainsNearX(unsigned short ipl,
+                                 float x,
+                                 float dx,
+                                 std::vector<unsigned short>& icls) const
+  {
+    // The cuts are made on |X - x| computed in float. The window is opened a bit to
+    // cover the rounding, and a NaN X passes any cut
+    if (std::isnan(x) || std::isnan(dx)) {
+      for (unsigned short icl = 0; icl < clsChain[ipl].size(); ++icl)
+        icls.push_back(icl);
+    }
+    else {
+      double window = 1.00001 * (double)dx;
+      auto lo = std::lower_bound(chainEndX[ipl].begin(),
+                                 chainEndX[ipl].end(),
+                                 (double)x - window,
+                                 [](std::pair<float, unsigned short> const& endX, double xlo) {
+                                   return (double)endX.first < xlo;
+                                 });
+      for (auto it = lo; it != chainEndX[ipl].end(); ++it) {
+        if ((double)it->first > (double)x + window) break;
+        icls.push_back(it->second);
+      }
+      icls.insert(icls.end(), chainNoX[ipl].begin(), chainNoX[ipl].end());
+    }
+    std::sort(icls.begin(), icls.end());
+    icls.erase(std::unique(icls.begin(), icls.end()), icls.end());
+  } // ChainsNearX
+
   ///////////////////////////////////////////////////////////////////////
   bool CCTrackMaker::DupMatch(MatchPars& match, unsigned short const nplanes)
   {
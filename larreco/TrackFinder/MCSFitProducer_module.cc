@@ -12,6 +12,8 @@
 
 #include "larreco/RecoAlg/TrajectoryMCSFitter.h"
 
+#include "tbb/parallel_for.h"
+
 #include <memory>
 
 namespace trkf {
@@ -87,10 +89,18 @@ void trkf::MCSFitProducer::produce(art::Event& e)
     throw cet::exception("MCSFitProducer")
       << "Cannot find input art::Handle with inputTag " << inputTag;
   const auto& inputVec = *(inputH.product());
-  for (const auto& element : inputVec) {
-    //fit
-    recob::MCSFitResult result = mcsfitter.fitMcs(element);
-    output->emplace_back(std::move(result));
+  //
+  // tracks are fit independently, so spread them over the available threads;
+  // results are written by index to keep the output in input order.
+  // The space charge service is only accessed serially.
+  output->resize(inputVec.size());
+  auto fitOne = [&](size_t i) { (*output)[i] = mcsfitter.fitMcs(inputVec[i]); };
+  if (mcsfitter.applySCEcorr()) {
+    for (size_t i = 0; i < inputVec.size(); ++i)
+      fitOne(i);
+  }
+  else {
+    tbb::parallel_for(size_t(0), inputVec.size(), fitOne);
   }
   e.put(std::move(output));
 }
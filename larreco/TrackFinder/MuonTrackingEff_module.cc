@@ -20,6 +20,7 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardataobj/RecoBase/Track.h"
+#include "larreco/MCComp/HitTruthTable.h"
 #include "larsim/MCCheater/BackTrackerService.h"
 #include "larsim/MCCheater/ParticleInventoryService.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -61,8 +62,8 @@ namespace DUNE {
     void processEff(const art::Event& evt, bool& isFiducial);
 
     void truthMatcher(detinfo::DetectorClocksData const& clockData,
-                      std::vector<recob::Hit> const& AllHits,
-                      std::vector<art::Ptr<recob::Hit>> track_hits,
+                      btutil::HitTruthTable const& truthTable,
+                      std::vector<art::Ptr<recob::Hit>> const& track_hits,
                       const simb::MCParticle*& MCparticle,
                       double& Purity,
                       double& Completeness,
@@ -1224,6 +1225,10 @@ namespace DUNE {
     auto const clockData =
       art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
 
+    // Back-track all hits once, the truth matching of every track looks them up
+    btutil::HitTruthTable truthTable;
+    truthTable.Reset(clockData, tmp_TrackHits[0].id(), AllHits);
+
     // Loop over reco tracks
     for (int i = 0; i < NRecoTracks; i++) {
       art::Ptr<recob::Track> track = TrackList[i];
@@ -1233,7 +1238,7 @@ namespace DUNE {
       const simb::MCParticle* particle;
 
       truthMatcher(
-        clockData, AllHits, TrackHits, particle, tmpPurity, tmpCompleteness, tmpTotalRecoEnergy);
+        clockData, truthTable, TrackHits, particle, tmpPurity, tmpCompleteness, tmpTotalRecoEnergy);
 
       if (!particle) {
         std::cout << "ERROR: Truth matcher didn't find a particle!" << std::endl;
@@ -1561,8 +1566,8 @@ namespace DUNE {
   }
   //========================================================================
   void MuonTrackingEff::truthMatcher(detinfo::DetectorClocksData const& clockData,
-                                     std::vector<recob::Hit> const& AllHits,
-                                     std::vector<art::Ptr<recob::Hit>> track_hits,
+                                     btutil::HitTruthTable const& truthTable,
+                                     std::vector<art::Ptr<recob::Hit>> const& track_hits,
                                      const simb::MCParticle*& MCparticle,
                                      double& Purity,
                                      double& Completeness,
@@ -1574,15 +1579,16 @@ namespace DUNE {
                                    // each hit <trackID, energy>
     for (size_t j = 0; j < track_hits.size(); ++j) {
       art::Ptr<recob::Hit> hit = track_hits[j];
-      std::vector<sim::TrackIDE> TrackIDs =
-        bt_serv->HitToTrackIDEs(clockData,
-                                hit); // TrackIDE contains TrackID, energy and energyFrac. A hit can
+      // TrackIDE contains TrackID, energy and energyFrac. A hit can
       // have several TrackIDs (so this hit is associated with multiple
       // MC truth track IDs (EM shower IDs are negative). If a hit ahs
       // multiple trackIDs, "energyFrac" contains the fraction of the
       // energy of for each ID compared to the total energy of the hit.
       // "energy" contains only the energy associated with the specific
       // ID in that case. This requires MC truth info!
+      std::vector<sim::TrackIDE> TrackIDs = truthTable.Covers(hit) ?
+                                              truthTable.TrackIDEs(hit.key()) :
+                                              bt_serv->HitToTrackIDEs(clockData, hit);
       for (size_t k = 0; k < TrackIDs.size(); k++) {
         trkID_E[TrackIDs[k].trackID] +=
           TrackIDs[k].energy; // sum up the energy for each TrackID and store
@@ -1629,15 +1635,8 @@ namespace DUNE {
     Purity = PartialEnergyTrackID / TotalEnergyTrack;
 
     // completeness
-    TotalRecoEnergy = 0;
-    for (recob::Hit const& hit : AllHits) {
-      std::vector<sim::TrackIDE> TrackIDs = bt_serv->HitToTrackIDEs(clockData, hit);
-      for (size_t l = 0; l < TrackIDs.size(); ++l) { // and over all track IDs of the hits
-        if (TrackIDs[l].trackID == TrackID)
-          TotalRecoEnergy += TrackIDs[l].energy; // and sum up the energy fraction of all hits
-                                                 // that correspond ot the saved trackID
-      }
-    }
+    TotalRecoEnergy = truthTable.TotalEnergy(
+      TrackID); // energy of all hits that correspond to the saved trackID
     Completeness = PartialEnergyTrackID / TotalRecoEnergy;
   }
 
@@ -18,6 +18,7 @@
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardataobj/RecoBase/Track.h"
+#include "larreco/MCComp/HitTruthTable.h"
 #include "larsim/MCCheater/BackTrackerService.h"
 #include "larsim/MCCheater/ParticleInventoryService.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -60,8 +61,8 @@ namespace DUNE {
 
     void processEff(const art::Event& evt);
     void truthMatcher(detinfo::DetectorClocksData const& clockData,
-                      std::vector<art::Ptr<recob::Hit>> all_hits,
-                      std::vector<art::Ptr<recob::Hit>> track_hits,
+                      btutil::HitTruthTable const& truthTable,
+                      std::vector<art::Ptr<recob::Hit>> const& track_hits,
                       const simb::MCParticle*& MCparticle,
                       double& Efrac,
                       double& Ecomplet);
@@ -694,12 +695,13 @@ namespace DUNE {
     const simb::MCParticle* MCkaon_reco = nullptr;
     const simb::MCParticle* MCmichel_reco = nullptr;
 
+    // Back-track all hits once, the truth matching of every track looks them up
     std::vector<art::Ptr<recob::Hit>> tmp_all_trackHits = track_hits.at(0);
-    std::vector<art::Ptr<recob::Hit>> all_hits;
+    btutil::HitTruthTable truthTable;
     art::Handle<std::vector<recob::Hit>> hithandle;
     auto const pd = event.getProductDescription(tmp_all_trackHits[0].id());
     if (pd && event.getByLabel(pd->inputTag(), hithandle)) {
-      art::fill_ptr_vector(all_hits, hithandle);
+      truthTable.Reset(clockData, hithandle.id(), *hithandle);
     }
 
     for (int i = 0; i < n_recoTrack; i++) {
@@ -708,7 +710,7 @@ namespace DUNE {
       double tmpEfrac = 0;
       double tmpEcomplet = 0;
       const simb::MCParticle* particle;
-      truthMatcher(clockData, all_hits, all_trackHits, particle, tmpEfrac, tmpEcomplet);
+      truthMatcher(clockData, truthTable, all_trackHits, particle, tmpEfrac, tmpEcomplet);
       if (!particle) continue;
       if ((particle->PdgCode() == fLeptonPDGcode) && (particle->TrackId() == MC_leptonID)) {
         // save the best track ... based on completeness if there is more than
@@ -870,8 +872,8 @@ namespace DUNE {
   }
   //========================================================================
   void NeutrinoTrackingEff::truthMatcher(detinfo::DetectorClocksData const& clockData,
-                                         std::vector<art::Ptr<recob::Hit>> all_hits,
-                                         std::vector<art::Ptr<recob::Hit>> track_hits,
+                                         btutil::HitTruthTable const& truthTable,
+                                         std::vector<art::Ptr<recob::Hit>> const& track_hits,
                                          const simb::MCParticle*& MCparticle,
                                          double& Efrac,
                                          double& Ecomplet)
@@ -881,7 +883,9 @@ namespace DUNE {
     std::map<int, double> trkID_E;
     for (size_t j = 0; j < track_hits.size(); ++j) {
       art::Ptr<recob::Hit> hit = track_hits[j];
-      std::vector<sim::TrackIDE> TrackIDs = bt_serv->HitToTrackIDEs(clockData, hit);
+      std::vector<sim::TrackIDE> TrackIDs = truthTable.Covers(hit) ?
+                                              truthTable.TrackIDEs(hit.key()) :
+                                              bt_serv->HitToTrackIDEs(clockData, hit);
       for (size_t k = 0; k < TrackIDs.size(); k++) {
         trkID_E[TrackIDs[k].trackID] += TrackIDs[k].energy;
       }
@@ -920,14 +924,7 @@ namespace DUNE {
     Efrac = (partial_E) / total_E;
 
     // Completeness
-    double totenergy = 0;
-    for (size_t k = 0; k < all_hits.size(); ++k) {
-      art::Ptr<recob::Hit> hit = all_hits[k];
-      std::vector<sim::TrackIDE> TrackIDs = bt_serv->HitToTrackIDEs(clockData, hit);
-      for (size_t l = 0; l < TrackIDs.size(); ++l) {
-        if (TrackIDs[l].trackID == TrackID) totenergy += TrackIDs[l].energy;
-      }
-    }
+    double totenergy = truthTable.TotalEnergy(TrackID);
     Ecomplet = partial_E / totenergy;
   }
   //========================================================================
@@ -41,6 +41,7 @@
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "lardataobj/RecoBase/Track.h"
 #include "lardataobj/Simulation/sim.h"
+#include "larreco/MCComp/HitTruthTable.h"
 #include "larsim/MCCheater/BackTrackerService.h"
 #include "larsim/MCCheater/ParticleInventoryService.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
@@ -1310,6 +1311,9 @@ namespace trkf {
     hitmap.clear();
     KEmap.clear();
 
+    // back-tracked once for the whole hit collection behind the space points
+    btutil::HitTruthTable truthTable;
+
     // Look at the components of the stitched tracks. Grab their sppts/hits from Assns.
     for (int o = 0; o < ntv; ++o) // o for outer
     {
@@ -1349,7 +1353,11 @@ namespace trkf {
               rhistsStitched.fHHitChg->Fill(hit->Integral());
               rhistsStitched.fHHitWidth->Fill(2. * hit->RMS());
               if (mc) {
-                std::vector<sim::TrackIDE> tids = bt_serv->HitToTrackIDEs(clockData, hit);
+                if (truthTable.NHits() == 0)
+                  truthTable.Reset(clockData, hit.id(), hit.parentAs<std::vector>());
+                std::vector<sim::TrackIDE> tids = truthTable.Covers(hit) ?
+                                                    truthTable.TrackIDEs(hit.key()) :
+                                                    bt_serv->HitToTrackIDEs(clockData, hit);
                 // more here.
                 // Loop over track ids.
                 bool justOne(true); // Only take first trk that contributed to this hit
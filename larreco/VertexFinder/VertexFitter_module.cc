@@ -16,6 +16,8 @@
 
 #include <memory>
 
+#include "tbb/parallel_for.h"
+
 namespace trkf {
 
   /**
@@ -107,6 +109,17 @@ void trkf::VertexFitter::produce(art::Event& e)
   // PtrMakers for Assns
   art::PtrMaker<recob::Vertex> vtxPtrMaker(e);
 
+  // Collect the tracks of each candidate PFParticle first; the vertices are independent,
+  // so they are then fitted in parallel and stored in the original PFParticle order.
+  struct PFPVertex {
+    size_t iPF;
+    vector<art::Ptr<recob::Track>> tracks;
+    TrackRefVec trackRefs;
+    VertexWrapper vtx;
+    vector<recob::VertexAssnMeta> meta;
+  };
+  vector<PFPVertex> pfpVertices;
+
   for (size_t iPF = 0; iPF < inputPFParticle->size(); ++iPF) {
 
     art::Ptr<recob::PFParticle> pfp(inputPFParticle, iPF);
@@ -128,21 +141,33 @@ void trkf::VertexFitter::produce(art::Event& e)
     }
     if (tracks.size() < 2) continue;
 
-    VertexWrapper vtx = fitter.fitTracks(detProp, tracks);
-    if (vtx.isValid() == false) continue;
-    vtx.setVertexId(outputVertices->size());
+    TrackRefVec trackRefs;
+    for (auto const& t : tracks)
+      trackRefs.push_back(*t);
+    pfpVertices.push_back({iPF, std::move(tracks), std::move(trackRefs), VertexWrapper(), {}});
+  }
+
+  tbb::parallel_for(size_t(0), pfpVertices.size(), [&](size_t ipv) {
+    auto& pv = pfpVertices[ipv];
+    // fitTracks sorts its input, while the meta data follow the association order
+    TrackRefVec fitRefs = pv.trackRefs;
+    pv.vtx = fitter.fitTracks(detProp, fitRefs);
+    if (pv.vtx.isValid()) pv.meta = fitter.computeMeta(detProp, pv.vtx, pv.trackRefs);
+  });
 
-    auto meta = fitter.computeMeta(detProp, vtx, tracks);
+  for (auto& pv : pfpVertices) {
+    if (pv.vtx.isValid() == false) continue;
+    pv.vtx.setVertexId(outputVertices->size());
 
     // Fill the output collections
 
-    outputVertices->emplace_back(vtx.vertex());
+    outputVertices->emplace_back(pv.vtx.vertex());
     const art::Ptr<recob::Vertex> aptr = vtxPtrMaker(outputVertices->size() - 1);
-    outputPFVxAssn->addSingle(art::Ptr<recob::PFParticle>(inputPFParticle, iPF), aptr);
+    outputPFVxAssn->addSingle(art::Ptr<recob::PFParticle>(inputPFParticle, pv.iPF), aptr);
 
     size_t itt = 0;
-    for (auto t : tracks) {
-      outputVxTkMtAssn->addSingle(aptr, t, meta[itt]);
+    for (auto t : pv.tracks) {
+      outputVxTkMtAssn->addSingle(aptr, t, pv.meta[itt]);
       itt++;
     }
   }
@@ -0,0 +1,224 @@
+/**
+ * @file   CalorimetryAlg_test.cc
+ * @brief  Test of the recombination tables and of the batch dE/dx of calo::CalorimetryAlg
+ * @see    larreco/Calorimetry/CalorimetryAlg.h
+ *
+ * Usage:
+ *
+ *     CalorimetryAlg_test  ConfigurationFile [TestParameterSet [GeometryParameterSet]]
+ *
+ * The Mod-Box beta and the Birks k tabulated in phi are compared, through ModBoxCorrection
+ * and BirksCorrection, with the direct evaluation of their TF1 on a dense phi grid, using
+ * functions which depend on phi. The batch dEdx_AMP and dEdx_AREA must return the same
+ * values as the per-hit ones, bit for bit.
+ */
+
+// LArSoft libraries
+#include "larcorealg/Geometry/ChannelMapStandardAlg.h"
+#include "larcorealg/TestUtils/geometry_unit_test_base.h"
+#include "lardataalg/DetectorInfo/DetectorClocksData.h"
+#include "lardataalg/DetectorInfo/DetectorClocksStandardTestHelpers.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
+#include "lardataalg/DetectorInfo/DetectorPropertiesStandardTestHelpers.h"
+#include "lardataalg/DetectorInfo/LArPropertiesStandardTestHelpers.h"
+#include "larreco/Calorimetry/CalorimetryAlg.h"
+
+// utility libraries
+#include "fhiclcpp/ParameterSet.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+//---  The test environment
+//---
+
+using StandardGeometryConfiguration =
+  testing::BasicGeometryEnvironmentConfiguration<geo::ChannelMapStandardAlg>;
+using StandardGeometryTestEnvironment =
+  testing::GeometryTesterEnvironment<StandardGeometryConfiguration>;
+
+namespace {
+
+  // phi dependent recombination parameters, in the form of the ellipsoid models
+  std::string const kModBoxBTF1 =
+    "[0]/sqrt(pow(sin(x*TMath::DegToRad()),2)+pow(cos(x*TMath::DegToRad())/[1],2))";
+  std::vector<double> const kModBoxBParam{0.212, 1.25};
+  std::string const kBirksKTF1 = "[0]*(1+[1]*cos(x*TMath::DegToRad()))";
+  std::vector<double> const kBirksKParam{0.0486, 0.3};
+
+  // a negative tolerance makes the algorithm evaluate the TF1s directly
+  calo::CalorimetryAlg makeAlg(bool useModBox, double tableTolerance)
+  {
+    fhicl::ParameterSet pset;
+    pset.put("CalAmpConstants", std::vector<double>{0.9033e-3, 1.0287e-3, 0.8800e-3});
+    pset.put("CalAreaConstants", std::vector<double>{5.0142e-3, 5.1605e-3, 5.4354e-3});
+    pset.put("CaloUseModBox", useModBox);
+    pset.put("CaloLifeTimeForm", 0);
+    pset.put("CaloDoLifeTimeCorrection", true);
+    pset.put("ModBoxBTF1", kModBoxBTF1);
+    pset.put("ModBoxBParam", kModBoxBParam);
+    pset.put("BirksKTF1", kBirksKTF1);
+    pset.put("BirksKParam", kBirksKParam);
+    pset.put("RecombTableTolerance", tableTolerance);
+    return calo::CalorimetryAlg(pset);
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned int testRecombinationTables(detinfo::DetectorPropertiesData const& detProp)
+  {
+    unsigned int nErrors = 0;
+
+    // the tables follow the TF1s within 1e-6, which moves dE/dx by a few times that at most
+    constexpr double tolerance = 1e-5;
+    double const rho = detProp.Density();
+    double const efield = detProp.Efield();
+
+    for (bool const useModBox : {true, false}) {
+      calo::CalorimetryAlg const tabulated = makeAlg(useModBox, 1e-6);
+      calo::CalorimetryAlg const direct = makeAlg(useModBox, -1.);
+      char const* model = useModBox ? "ModBoxCorrection" : "BirksCorrection";
+
+      // 0.001 degree steps, and a little beyond the range of the tables
+      for (int i = -1000; i <= 91000; ++i) {
+        double const phi = i * 1e-3;
+        for (double const dQdx : {2.e4, 6.e4, 2.e5}) {
+          double const expected = useModBox ? direct.ModBoxCorrection(dQdx, phi, rho, efield) :
+                                              direct.BirksCorrection(dQdx, phi, rho, efield);
+          double const value = useModBox ? tabulated.ModBoxCorrection(dQdx, phi, rho, efield) :
+                                           tabulated.BirksCorrection(dQdx, phi, rho, efield);
+          if (!(std::abs(value - expected) <= tolerance * std::abs(expected))) {
+            mf::LogError("CalorimetryAlg_test")
+              << model << "(" << dQdx << ", " << phi << "): " << value << " from the table, "
+              << expected << " from the TF1";
+            ++nErrors;
+          }
+        }
+      }
+    }
+
+    return nErrors;
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned int testBatch(detinfo::DetectorClocksData const& clockData,
+                         detinfo::DetectorPropertiesData const& detProp)
+  {
+    unsigned int nErrors = 0;
+
+    std::mt19937 rng(20201);
+    std::uniform_real_distribution<double> charge(5., 100.);
+    std::uniform_real_distribution<double> tick(0., detProp.NumberTimeSamples());
+    std::uniform_real_distribution<double> angle(-1., 91.);
+
+    constexpr std::size_t nHits = 1000;
+    std::vector<double> dQdx(nHits), time(nHits), phi(nHits);
+    for (std::size_t i = 0; i < nHits; ++i) {
+      dQdx[i] = charge(rng);
+      time[i] = tick(rng);
+      phi[i] = angle(rng);
+    }
+    double const T0 = 250.;
+    double const efield = 0.9 * detProp.Efield();
+
+    auto compare = [&nErrors](char const* what,
+                              std::vector<double> const& batch,
+                              std::size_t i,
+                              double single) {
+      if (batch[i] == single) return;
+      mf::LogError("CalorimetryAlg_test")
+        << what << " of hit " << i << ": " << batch[i] << " in batch, " << single << " alone";
+      ++nErrors;
+    };
+
+    for (bool const useModBox : {true, false}) {
+      for (double const tableTolerance : {1e-6, -1.}) {
+        calo::CalorimetryAlg const alg = makeAlg(useModBox, tableTolerance);
+        for (unsigned int plane = 0; plane < 3; ++plane) {
+          auto const amp = alg.dEdx_AMP(clockData, detProp, dQdx, time, plane, T0);
+          auto const area = alg.dEdx_AREA(clockData, detProp, dQdx, time, plane, T0);
+          auto const ampPhi =
+            alg.dEdx_AMP(clockData, detProp, dQdx, time, plane, T0, efield, phi);
+          auto const areaPhi =
+            alg.dEdx_AREA(clockData, detProp, dQdx, time, plane, T0, efield, phi);
+          for (std::size_t i = 0; i < nHits; ++i) {
+            compare("dEdx_AMP",
+                    amp,
+                    i,
+                    alg.dEdx_AMP(clockData, detProp, dQdx[i], time[i], plane, T0));
+            compare("dEdx_AREA",
+                    area,
+                    i,
+                    alg.dEdx_AREA(clockData, detProp, dQdx[i], time[i], plane, T0));
+            compare(
+              "dEdx_AMP with phi",
+              ampPhi,
+              i,
+              alg.dEdx_AMP(clockData, detProp, dQdx[i], time[i], plane, T0, efield, phi[i]));
+            compare(
+              "dEdx_AREA with phi",
+              areaPhi,
+              i,
+              alg.dEdx_AREA(clockData, detProp, dQdx[i], time[i], plane, T0, efield, phi[i]));
+          }
+        }
+      }
+    }
+
+    return nErrors;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+
+/** ****************************************************************************
+ * @brief Runs the test
+ * @param argc number of arguments in argv
+ * @param argv arguments to the function
+ * @return number of detected errors (0 on success)
+ * @throw cet::exception most of error situations throw
+ *
+ * The arguments in argv are:
+ * 0. name of the executable ("CalorimetryAlg_test")
+ * 1. path to the FHiCL configuration file
+ * 2. FHiCL path to the configuration of the test
+ *    (default: physics.analyzers.calorimetryalgtest)
+ * 3. FHiCL path to the configuration of the geometry
+ *    (default: services.Geometry)
+ *
+ */
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv)
+{
+  StandardGeometryConfiguration config("CalorimetryAlg_test");
+  config.SetMainTesterParameterSetName("calorimetryalgtest");
+
+  if (argc > 1) config.SetConfigurationPath(argv[1]);
+  if (argc > 2) config.SetMainTesterParameterSetPath(argv[2]);
+  if (argc > 3) config.SetGeometryParameterSetPath(argv[3]);
+
+  StandardGeometryTestEnvironment TestEnvironment(config);
+  TestEnvironment.SimpleProviderSetup<detinfo::LArPropertiesStandard>();
+  TestEnvironment.SimpleProviderSetup<detinfo::DetectorClocksStandard>();
+  TestEnvironment.SimpleProviderSetup<detinfo::DetectorPropertiesStandard>();
+
+  auto const clockData = TestEnvironment.Provider<detinfo::DetectorClocksStandard>()->DataForJob();
+  auto const detProp =
+    TestEnvironment.Provider<detinfo::DetectorPropertiesStandard>()->DataFor(clockData);
+
+  unsigned int nErrors = 0;
+  nErrors += testRecombinationTables(detProp);
+  nErrors += testBatch(clockData, detProp);
+
+  if (nErrors > 0) mf::LogError("CalorimetryAlg_test") << nErrors << " errors detected!";
+
+  return nErrors;
+} // main()
@@ -0,0 +1,193 @@
+/**
+ * @file   MultiExponentialFitter_test.cc
+ * @brief  Test of MultiExponentialFitter against the ROOT fit of DPRawHitFinder
+ * @see    MultiExponentialFitter.h
+ *
+ * Synthetic waveforms of one to three pulses with gaussian noise are fitted
+ * both with hit::MultiExponentialFitter and with the TF1/TH1F "QNRWM" fit
+ * that DPRawHitFinder uses, with the same formula, seeds and limits. The two
+ * must agree within the tolerances below.
+ */
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+// boost test libraries
+#define BOOST_TEST_MODULE (MultiExponentialFitter_test)
+#include "boost/test/unit_test.hpp"
+
+// ROOT libraries
+#include "TF1.h"
+#include "TH1F.h"
+
+// LArSoft libraries
+#include "larreco/HitFinder/MultiExponentialFitter.h"
+
+namespace {
+
+  // fitted parameters must agree within this fraction of the ROOT parameter error...
+  constexpr double kParTolerance = 0.1;
+  // ... and the chi2 within this relative tolerance
+  constexpr double kChi2Tolerance = 0.005;
+
+  // DPRawHitFinder defaults (hitfindermodules.fcl)
+  constexpr double kMinTau = 0.01;
+  constexpr double kMaxTau = 20.;
+  constexpr double kFitPeakMeanRange = 5.;
+  constexpr double kPeakMeanShift = 2.;
+
+  struct Pulse {
+    double t0;
+    double amplitude;
+    double tau1 = 2.0;
+    double tau2 = 1.2;
+  };
+
+  struct Waveform {
+    std::vector<float> signal;
+    int startTime;
+    int endTime;
+    std::vector<int> peakTicks; // as found by the peak finding pass
+  };
+
+  Waveform makeWaveform(std::vector<Pulse> const& pulses, unsigned int seed)
+  {
+    std::mt19937 engine(seed);
+    std::normal_distribution<double> noise(0., 1.);
+
+    // each pulse with its own shape, in the layout of the different shape fit
+    std::vector<double> params;
+    for (auto const& pulse : pulses)
+      params.insert(params.end(), {pulse.tau1, pulse.tau2, pulse.amplitude, pulse.t0});
+
+    Waveform wf;
+    wf.signal.assign(150, 0.f);
+    wf.startTime = int(pulses.front().t0) - 12;
+    wf.endTime = int(pulses.back().t0) + 30;
+    for (int i = wf.startTime; i <= wf.endTime; ++i)
+      wf.signal[i] =
+        hit::MultiExponentialFitter::Evaluate(i + 0.5, params.data(), pulses.size(), false) +
+        noise(engine);
+
+    // the peak finding pass of the hit finder gives the tick of the largest sample of a pulse
+    for (auto const& pulse : pulses) {
+      int const first = int(pulse.t0) - 2;
+      auto const peak = std::max_element(wf.signal.begin() + first, wf.signal.begin() + first + 6);
+      wf.peakTicks.push_back(peak - wf.signal.begin());
+    }
+    return wf;
+  }
+
+  // seeds and limits as computed by DPRawHitFinder::FitExponentials
+  struct ParameterSetup {
+    std::vector<double> seed, low, high;
+  };
+
+  ParameterSetup makeSetup(Waveform const& wf, bool sameShape)
+  {
+    int const nPeaks = wf.peakTicks.size();
+    int const nParams = sameShape ? 2 + 2 * nPeaks : 4 * nPeaks;
+    ParameterSetup setup{std::vector<double>(nParams),
+                         std::vector<double>(nParams),
+                         std::vector<double>(nParams)};
+    auto set = [&setup](int k, double seed, double low, double high) {
+      setup.seed[k] = seed;
+      setup.low[k] = low;
+      setup.high[k] = high;
+    };
+
+    for (int i = 0; i < nPeaks; ++i) {
+      int const iAmp = sameShape ? 2 * (i + 1) : 4 * i + 2;
+      if (!sameShape || i == 0) {
+        set(iAmp - 2, 0.5, kMinTau, kMaxTau);
+        set(iAmp - 1, 0.5, kMinTau, kMaxTau);
+      }
+
+      double const peakMean = wf.peakTicks[i];
+      double const peakMeanSeed = peakMean - kPeakMeanShift;
+      double t0low = std::max(wf.startTime - kPeakMeanShift, peakMeanSeed - kFitPeakMeanRange);
+      double t0high = std::min(double(wf.endTime), peakMeanSeed + kFitPeakMeanRange);
+      if (i + 1 < nPeaks)
+        t0high = std::min(t0high, peakMeanSeed + 0.5 * (wf.peakTicks[i + 1] - peakMean));
+      if (i > 0) t0low = std::max(t0low, peakMeanSeed - 0.5 * (peakMean - wf.peakTicks[i - 1]));
+
+      double const amplitude = wf.signal[wf.peakTicks[i]];
+      set(iAmp, 1.65 * amplitude, 0.3 * 1.65 * amplitude, 2 * 1.65 * amplitude);
+      set(iAmp + 1, peakMeanSeed, t0low, t0high);
+    }
+    return setup;
+  }
+
+  void compareFits(Waveform const& wf, bool sameShape)
+  {
+    int const nPeaks = wf.peakTicks.size();
+    ParameterSetup const setup = makeSetup(wf, sameShape);
+    int const nParams = setup.seed.size();
+
+    // ROOT fit, set up as in DPRawHitFinder::FitExponentials
+    int const size = wf.endTime - wf.startTime + 1;
+    TH1F hitSignal("hitSignal", "", size, wf.startTime, wf.endTime + 1);
+    hitSignal.Sumw2();
+    for (int i = wf.startTime; i <= wf.endTime; ++i)
+      hitSignal.Fill(i, wf.signal[i]);
+
+    std::string const eqn = hit::MultiExponentialFitter::Formula(nPeaks, sameShape);
+    TF1 exponentials("Exponentials", eqn.c_str(), wf.startTime, wf.endTime + 1);
+    for (int k = 0; k < nParams; ++k) {
+      exponentials.SetParameter(k, setup.seed[k]);
+      exponentials.SetParLimits(k, setup.low[k], setup.high[k]);
+    }
+    hitSignal.Fit(&exponentials, "QNRWM", "", wf.startTime, wf.endTime + 1);
+
+    // dedicated fitter
+    hit::MultiExponentialFitter fitter;
+    BOOST_TEST_REQUIRE(fitter.SetNPeaks(nPeaks, sameShape));
+    BOOST_TEST_REQUIRE(int(fitter.NParams()) == nParams);
+    for (int k = 0; k < nParams; ++k)
+      fitter.SetParameter(k, setup.seed[k], setup.low[k], setup.high[k]);
+    BOOST_TEST_REQUIRE(fitter.Fit(wf.signal, wf.startTime, wf.endTime));
+
+    BOOST_TEST(fitter.GetNDF() == exponentials.GetNDF());
+    BOOST_TEST(fitter.GetChisquare() == exponentials.GetChisquare(),
+               boost::test_tools::tolerance(kChi2Tolerance));
+    for (int k = 0; k < nParams; ++k) {
+      BOOST_TEST_INFO("parameter " << k);
+      BOOST_TEST(std::abs(fitter.GetParameter(k) - exponentials.GetParameter(k)) <=
+                 kParTolerance * exponentials.GetParError(k));
+    }
+  }
+
+} // local namespace
+
+//******************************************************************************
+BOOST_AUTO_TEST_CASE(SinglePulseTest)
+{
+  auto const wf = makeWaveform({{40., 80.}}, 17);
+  compareFits(wf, false);
+  compareFits(wf, true);
+}
+
+BOOST_AUTO_TEST_CASE(TwoPulsesTest)
+{
+  compareFits(makeWaveform({{35., 70.}, {47., 45.}}, 19), true);
+}
+
+BOOST_AUTO_TEST_CASE(ThreePulsesTest)
+{
+  compareFits(makeWaveform({{30., 60.}, {44., 40.}, {62., 90.}}, 20), true);
+}
+
+BOOST_AUTO_TEST_CASE(TwoPulsesDifferentShapeTest)
+{
+  compareFits(makeWaveform({{35., 70., 2.0, 1.2}, {50., 50., 3.0, 1.6}}, 23), false);
+}
+
+BOOST_AUTO_TEST_CASE(ThreePulsesDifferentShapeTest)
+{
+  compareFits(makeWaveform({{30., 60., 1.6, 1.0}, {44., 45., 2.4, 1.4}, {62., 90., 2.0, 1.2}}, 29),
+              false);
+}
@@ -0,0 +1,235 @@
+/**
+ * @file   GeometryCache_test.cc
+ * @brief  Test of util::GeometryCache against the geometry it is filled from
+ * @see    larreco/RecoAlg/GeometryCache.h
+ *
+ * Usage:
+ *
+ *     GeometryCache_test  ConfigurationFile [TestParameterSet [GeometryParameterSet]]
+ *
+ * The tables of the cache are compared with the geometry for every channel, wire and plane,
+ * and MayIntersect is checked exhaustively: it must not be false for any pair of wires of two
+ * planes of the same TPC for which GeometryCore::WireIDsIntersect is true, since the callers
+ * would then silently drop that pair. The time of the channel and intersection queries with
+ * and without the cache is reported, but not tested.
+ */
+
+// LArSoft libraries
+#include "larcorealg/Geometry/ChannelMapStandardAlg.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/TestUtils/geometry_unit_test_base.h"
+#include "larreco/RecoAlg/GeometryCache.h"
+
+// utility libraries
+#include "cetlib_except/exception.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+//------------------------------------------------------------------------------
+//---  The test environment
+//---
+
+using StandardGeometryConfiguration =
+  testing::BasicGeometryEnvironmentConfiguration<geo::ChannelMapStandardAlg>;
+using StandardGeometryTestEnvironment =
+  testing::GeometryTesterEnvironment<StandardGeometryConfiguration>;
+
+namespace {
+
+  double secondsSince(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  // calls f(a, b) for every ordered pair of wires of two different planes of the same TPC
+  template <typename F>
+  void forEachWirePair(geo::GeometryCore const& geom, F f)
+  {
+    for (auto const& tpcgeom : geom.Iterate<geo::TPCGeo>()) {
+      geo::TPCID const& tpcid = tpcgeom.ID();
+      for (auto const& planeidA : geom.Iterate<geo::PlaneID>(tpcid)) {
+        for (auto const& planeidB : geom.Iterate<geo::PlaneID>(tpcid)) {
+          if (planeidB == planeidA) continue;
+          unsigned int const nwiresA = geom.Nwires(planeidA);
+          unsigned int const nwiresB = geom.Nwires(planeidB);
+          for (unsigned int wireA = 0; wireA < nwiresA; ++wireA)
+            for (unsigned int wireB = 0; wireB < nwiresB; ++wireB)
+              f(geo::WireID(planeidA, wireA), geo::WireID(planeidB, wireB));
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned int testTables(geo::GeometryCore const& geom, util::GeometryCache const& cache)
+  {
+    unsigned int nErrors = 0;
+
+    for (raw::ChannelID_t channel = 0; channel < geom.Nchannels(); ++channel) {
+      std::vector<geo::WireID> const expected = geom.ChannelToWire(channel);
+      auto const wids = cache.ChannelToWire(channel);
+      if (std::vector<geo::WireID>(wids.begin(), wids.end()) != expected) {
+        mf::LogError("GeometryCache_test") << "wrong wires for channel " << channel;
+        ++nErrors;
+      }
+    }
+
+    try {
+      cache.ChannelToWire(geom.Nchannels());
+      mf::LogError("GeometryCache_test") << "no exception for a channel out of the channel map";
+      ++nErrors;
+    }
+    catch (cet::exception const&) {
+    }
+
+    for (auto const& tpcgeom : geom.Iterate<geo::TPCGeo>()) {
+      for (auto const& planeid : geom.Iterate<geo::PlaneID>(tpcgeom.ID())) {
+        if (cache.WirePitch(planeid) != geom.WirePitch(planeid)) {
+          mf::LogError("GeometryCache_test") << "wrong pitch for " << planeid;
+          ++nErrors;
+        }
+        for (unsigned int wire = 0; wire < geom.Nwires(planeid); ++wire) {
+          geo::WireID const wid(planeid, wire);
+          if (cache.PlaneWireToChannel(wid) != geom.PlaneWireToChannel(wid)) {
+            mf::LogError("GeometryCache_test") << "wrong channel for " << wid;
+            ++nErrors;
+          }
+        }
+      }
+    }
+
+    return nErrors;
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned int testMayIntersect(geo::GeometryCore const& geom, util::GeometryCache const& cache)
+  {
+    unsigned int nErrors = 0;
+    std::size_t nPairs = 0;
+    std::size_t nIntersecting = 0;
+    std::size_t nRejected = 0;
+
+    geo::WireIDIntersection widIntersect;
+    forEachWirePair(geom, [&](geo::WireID const& a, geo::WireID const& b) {
+      ++nPairs;
+      bool const intersect = geom.WireIDsIntersect(a, b, widIntersect);
+      bool const mayIntersect = cache.MayIntersect(a, b);
+      if (intersect) ++nIntersecting;
+      if (!mayIntersect) ++nRejected;
+      if (intersect && !mayIntersect) {
+        mf::LogError("GeometryCache_test")
+          << a << " and " << b << " intersect but are rejected by MayIntersect";
+        ++nErrors;
+      }
+    });
+
+    mf::LogInfo("GeometryCache_test")
+      << nPairs << " wire pairs, " << nIntersecting << " intersecting, " << nRejected
+      << " rejected by MayIntersect";
+
+    return nErrors;
+  }
+
+  //----------------------------------------------------------------------------
+  unsigned int reportQueryTimes(geo::GeometryCore const& geom, util::GeometryCache const& cache)
+  {
+    unsigned int nErrors = 0;
+
+    // channel to wires over the whole channel map
+    constexpr unsigned int nRepeat = 20;
+    std::size_t nGeomWires = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nRepeat; ++i)
+      for (raw::ChannelID_t channel = 0; channel < geom.Nchannels(); ++channel)
+        nGeomWires += geom.ChannelToWire(channel).size();
+    double const geomChannelTime = secondsSince(start);
+
+    std::size_t nCacheWires = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nRepeat; ++i)
+      for (raw::ChannelID_t channel = 0; channel < geom.Nchannels(); ++channel)
+        nCacheWires += cache.ChannelToWire(channel).size();
+    double const cacheChannelTime = secondsSince(start);
+
+    // intersections of all wire pairs, as StandardHit3DBuilder and TripletFinder ask for them
+    geo::WireIDIntersection widIntersect;
+    std::size_t nGeomIntersecting = 0;
+    start = std::chrono::steady_clock::now();
+    forEachWirePair(geom, [&](geo::WireID const& a, geo::WireID const& b) {
+      if (geom.WireIDsIntersect(a, b, widIntersect)) ++nGeomIntersecting;
+    });
+    double const geomIntersectTime = secondsSince(start);
+
+    std::size_t nCacheIntersecting = 0;
+    start = std::chrono::steady_clock::now();
+    forEachWirePair(geom, [&](geo::WireID const& a, geo::WireID const& b) {
+      if (cache.MayIntersect(a, b) && geom.WireIDsIntersect(a, b, widIntersect))
+        ++nCacheIntersecting;
+    });
+    double const cacheIntersectTime = secondsSince(start);
+
+    if (nCacheWires != nGeomWires || nCacheIntersecting != nGeomIntersecting) {
+      mf::LogError("GeometryCache_test") << "different query results with and without the cache";
+      ++nErrors;
+    }
+
+    mf::LogInfo("GeometryCache_test")
+      << "ChannelToWire over " << nRepeat << " x " << geom.Nchannels() << " channels: "
+      << geomChannelTime << " s from the geometry, " << cacheChannelTime << " s from the cache"
+      << "\nWireIDsIntersect over all wire pairs: " << geomIntersectTime << " s, "
+      << cacheIntersectTime << " s behind MayIntersect";
+
+    return nErrors;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------------
+//---  The tests
+//---
+
+/** ****************************************************************************
+ * @brief Runs the test
+ * @param argc number of arguments in argv
+ * @param argv arguments to the function
+ * @return number of detected errors (0 on success)
+ * @throw cet::exception most of error situations throw
+ *
+ * The arguments in argv are:
+ * 0. name of the executable ("GeometryCache_test")
+ * 1. path to the FHiCL configuration file
+ * 2. FHiCL path to the configuration of the test
+ *    (default: physics.analyzers.geometrycachetest)
+ * 3. FHiCL path to the configuration of the geometry
+ *    (default: services.Geometry)
+ *
+ */
+//------------------------------------------------------------------------------
+int main(int argc, char const** argv)
+{
+  StandardGeometryConfiguration config("GeometryCache_test");
+  config.SetMainTesterParameterSetName("geometrycachetest");
+
+  if (argc > 1) config.SetConfigurationPath(argv[1]);
+  if (argc > 2) config.SetMainTesterParameterSetPath(argv[2]);
+  if (argc > 3) config.SetGeometryParameterSetPath(argv[3]);
+
+  StandardGeometryTestEnvironment TestEnvironment(config);
+  geo::GeometryCore const& geom = *(TestEnvironment.Geometry());
+
+  util::GeometryCache const cache(geom);
+
+  unsigned int nErrors = 0;
+  nErrors += testTables(geom, cache);
+  nErrors += testMayIntersect(geom, cache);
+  nErrors += reportQueryTimes(geom, cache);
+
+  if (nErrors > 0) mf::LogError("GeometryCache_test") << nErrors << " errors detected!";
+
+  return nErrors;
+} // main()